@@ -8,6 +8,8 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Threads
+** 10/18/2026	me				Stream lock for shared loaders
 ** 09/16/2023	me				Upgrade
 ** 08/07/2023	me              Init
 ** ===========================================================================
@@ -71,6 +73,13 @@ void *       GreyBit_Realloc(GB_Memory mem, void *p, GB_INT32 newsize);
 void         GreyBit_Free(GB_Memory mem, void *p);
 void         GreyBit_Memory_Done(GB_Memory mem);  
 
+// Locking
+typedef void *GB_Mutex;
+
+// Threads
+typedef void *GB_Thread;
+typedef void  (*GB_THREAD_PROC)(void *p);
+
 // Stream IO
 typedef void *GB_IOHandler;
 
@@ -91,6 +100,7 @@ struct _GB_StreamRec {
 	GB_INT32     size;
 	GB_INT32     offset;
 	GB_INT32     refcnt;
+	GB_Mutex     lock;
 #ifdef ENABLE_ENCODER
 	char        *pfilename;
 #endif
@@ -120,6 +130,9 @@ extern GB_INT32     GreyBit_Stream_Write(GB_Stream stream, GB_BYTE * p,
 extern GB_INT32     GreyBit_Stream_Seek(GB_Stream stream, GB_INT32 pos);
 extern GB_INT32     GreyBit_Stream_Offset(GB_Stream stream, GB_INT32 offset,
 										  GB_INT32 size);
+extern GB_INT32     GreyBit_Stream_Share(GB_Stream stream);
+extern void         GreyBit_Stream_Lock(GB_Stream stream);
+extern void         GreyBit_Stream_Unlock(GB_Stream stream);
 extern void         GreyBit_Stream_Done(GB_Stream stream);
 
 extern int			GreyBit_Memcmp_Sys(const void * b1, const void * b2,
@@ -139,6 +152,10 @@ extern char *		GreyBit_Strrchr_Sys(const char * s, char c);
 extern char *		GreyBit_Strstr_Sys(const char * s1, const char * s2);
 extern GB_INT32		GreyBit_Atol_Sys(const char * s);
 extern GB_INT32		GreyBit_Labs_Sys(GB_INT32 i);
+#ifdef ENABLE_MULTITHREAD
+extern GB_Thread	GreyBit_Thread_New_Sys(GB_THREAD_PROC proc, void * p);
+extern void			GreyBit_Thread_Join_Sys(GB_Thread t);
+#endif //ENABLE_MULTITHREAD
 
 #ifdef __cplusplus
 }
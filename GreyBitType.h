@@ -8,6 +8,28 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Flatten sets delta
+** 10/19/2026	me				New params follow the old ones
+** 10/18/2026	me				Dense raster size param
+** 10/18/2026	me				Span callback API, GB_Span and GB_BBox public
+** 10/18/2026	me				LCD subpixel layout
+** 10/18/2026	me				Outline emboldening
+** 10/18/2026	me				Bake fonts into bitmap strikes
+** 10/18/2026	me				Pre-flattened polyline records
+** 10/18/2026	me				Encode-time outline simplification
+** 10/18/2026	me				Ink columns, GVF bounding box param
+** 10/18/2026	me				GVF delta param
+** 10/18/2026	me				Packed outline format
+** 10/18/2026	me				Outline matrix transform
+** 10/18/2026	me				Scaled outline cache param
+** 10/18/2026	me				Loader contexts
+** 10/18/2026	me				Blit character from spans
+** 10/18/2026	me				GBF length table param
+** 10/18/2026	me				Ink rows of decoded data, GBF crop param
+** 10/18/2026	me				Load character into caller bitmap
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
+** 10/18/2026	me				Lazy section tables
 ** 11/19/2010	jiaoyuhai		8to1, param changes
 ** 11/04/2010	jiaoyuhai		Horioff and width
 ** 05/31/2010	jiaoyuhai       Init
@@ -40,6 +62,8 @@ extern "C"{
 #define ENABLE_GREYVECTORFILE
 #define ENABLE_ITALIC
 #define ENABLE_BOLD
+#define ENABLE_LAZYTABLE		// load width/offset tables per unicode section
+//#define ENABLE_MULTITHREAD	// lock shared streams, needs GreyBit_Mutex_*_Sys
 
 #define GB_CURVE_TAG( flag )  ( flag & 3 )
 
@@ -54,6 +78,9 @@ extern "C"{
 #define GB_WIDTH_DEFAULT           0
 #define GB_HORIOFF_DEFAULT         0
 
+#define GB_LCD_BITCOUNT            24    // Layout_New bit count of RGB subpixel glyphs
+#define GB_ACCUM_MAX               32    // GB_PARAM_ACCUMMAX of a new loader
+
 #define BITMAP8TO1_SWITCH_VALUE    0x10  // 小于此值的灰度将变为透明
 
 /*
@@ -78,6 +105,7 @@ typedef enum {
 	GB_FORMAT_BITMAP,
 	GB_FORMAT_OUTLINE,
 	GB_FORMAT_STREAM,
+	GB_FORMAT_PACKED,       // GVF record points, scaled while rendered
 	GB_FROMAT_MAX
 }GB_DataFormat;
 
@@ -87,8 +115,16 @@ typedef enum {
 #ifdef ENABLE_ENCODER
 	GB_PARAM_HEIGHT,        // font height
 	GB_PARAM_BITCOUNT,      // GBF bit count
-	GB_PARAM_COMPRESS,      // Whether of not compress
+	GB_PARAM_COMPRESS,      // Whether of not compress, 2 for 1 bit GBF too
+	GB_PARAM_CROP,          // GBF crop glyphs to their inked rows
+	GB_PARAM_LENGTHTABLE,   // GBF store glyph lengths in a table
+	GB_PARAM_DELTA,         // GVF store points as 1/16 pixel varint deltas
+	GB_PARAM_BBOX,          // GVF store glyph bounding boxes
+	GB_PARAM_SIMPLIFY,      // GVF simplify tolerance, 1/64 pixel at font height
+	GB_PARAM_FLATTEN,       // GVF store arcs as lines within 1/64 pixel units, sets GB_PARAM_DELTA
 #endif
+	GB_PARAM_SCALECACHE,    // GVF bytes of scaled outlines kept, 0 for none
+	GB_PARAM_ACCUMMAX,      // Largest layout size rendered dense, 0 for none
 	GB_PARAM_MAX
 }GB_Param;
 
@@ -97,6 +133,10 @@ typedef struct  _GB_DataRec
     GB_DataFormat   format;
     GB_INT16        width;
 	GB_INT16		horioff;
+	GB_INT16		inktop;
+	GB_INT16		inkheight;
+	GB_INT16		inkleft;
+	GB_INT16		inkwidth;
     void           *data;
 } GB_DataRec, *GB_Data;
 
@@ -125,6 +165,28 @@ typedef struct  _GB_OutlineRec
     GB_INT16       *contours;        /* the contour end points             */
 } GB_OutlineRec, *GB_Outline;
 
+typedef struct  GB_BBox_
+{
+    GB_Pos          xMin, yMin;      /* box in whole pixels, max excluded  */
+    GB_Pos          xMax, yMax;
+} GB_BBox;
+
+typedef struct  GB_Span_
+{
+    short           x;               /* first pixel of the run             */
+    unsigned short  len;             /* pixels in the run                  */
+    unsigned char   coverage;        /* 0 to 0xff, same for the whole run  */
+} GB_Span;
+
+typedef void(*GB_SpanFunc)(int y, int count, const GB_Span*spans,void* user);
+
+typedef struct  _GB_MatrixRec
+{
+    GB_INT32        xx, xy;          /* 16.16 x' = xx * x + xy * y + dx    */
+    GB_INT32        yx, yy;          /* 16.16 y' = yx * x + yy * y + dy    */
+    GB_INT32        dx, dy;          /* translation in outline units       */
+} GB_MatrixRec, *GB_Matrix;
+
 /*
 **----------------------------------------------------------------------------
 **  Variable Declarations
@@ -168,6 +230,11 @@ extern int          GreyBitType_Outline_Transform(GB_Outline outline,
                                                   GB_Outline source,
                                                   GB_INT16 tosize,
                                                   GB_INT16 fromsize);
+extern int          GreyBitType_Outline_TransformEx(GB_Outline outline,
+                                                    GB_Outline source,
+                                                    GB_Matrix matrix);
+extern int          GreyBitType_Outline_Embolden(GB_Outline outline,
+                                                 GB_Pos nStrength);
 extern void         GreyBitType_Outline_Done(GBHANDLE library,
                                              GB_Outline outline);
 
@@ -184,6 +251,12 @@ extern int          GreyBitType_Creator_SaveChar(GBHANDLE creator,
                                                  GB_UINT32 nCode,
                                                  GB_Data pData);
 extern int          GreyBitType_Creator_Flush(GBHANDLE creator);
+extern int          GreyBitType_Creator_Bake(GBHANDLE creator,
+                                             GBHANDLE loader,
+                                             const GB_INT16 * pSizes,
+                                             const GB_INT16 * pBitCounts,
+                                             GB_INT32 nCount,
+                                             GB_BOOL bFallback);
 extern void         GreyBitType_Creator_Done(GBHANDLE creator);
 #endif
 
@@ -196,6 +269,7 @@ extern GBHANDLE     GreyBitType_Loader_New_Stream(GBHANDLE library,
 extern GBHANDLE     GreyBitType_Loader_New_Memory(GBHANDLE library,
                                                   void * pBuf,
                                                   GB_INT32 nBufSize);
+extern GBHANDLE     GreyBitType_Loader_NewContext(GBHANDLE loader);
 extern GB_INT32     GreyBitType_Loader_GetCount(GBHANDLE loader);
 extern GB_INT32     GreyBitType_Loader_GetHeight(GBHANDLE loader);
 extern int          GreyBitType_Loader_SetParam(GBHANDLE loader,
@@ -203,6 +277,14 @@ extern int          GreyBitType_Loader_SetParam(GBHANDLE loader,
                                                 GB_UINT32 dwParam);
 extern GB_BOOL      GreyBitType_Loader_IsExist(GBHANDLE loader,
                                                GB_UINT32 nCode);
+extern GB_INT32     GreyBitType_Loader_DecodeBatch(GBHANDLE loader,
+                                                   const GB_UINT32* pCodes,
+                                                   GB_INT32 nCount,
+                                                   GB_Data pData,
+                                                   GB_INT16 nSize);
+extern int          GreyBitType_Loader_Preload(GBHANDLE loader,
+                                               const GB_UINT32* pCodes,
+                                               GB_INT32 nCount);
 extern void         GreyBitType_Loader_Done(GBHANDLE loader);
 
 // Layout
@@ -216,6 +298,23 @@ extern GB_INT32     GreyBitType_Layout_GetWidth(GBHANDLE layout,
 extern int          GreyBitType_Layout_LoadChar(GBHANDLE layout,
                                                 GB_UINT32 nCode,
                                                    GB_Bitmap * pBmp);
+extern int          GreyBitType_Layout_LoadCharTo(GBHANDLE layout,
+                                                  GB_UINT32 nCode,
+                                                  GB_Bitmap pDst,
+                                                  GB_INT16 x, GB_INT16 y);
+extern int          GreyBitType_Layout_BlitChar(GBHANDLE layout,
+                                                GB_UINT32 nCode,
+                                                GB_Bitmap pDst,
+                                                GB_INT16 x, GB_INT16 y);
+extern int          GreyBitType_Layout_RenderSpans(GBHANDLE layout,
+                                                   GB_UINT32 nCode,
+                                                   GB_INT16 x, GB_INT16 y,
+                                                   const GB_BBox * pClip,
+                                                   GB_SpanFunc func,
+                                                   void * user);
+extern int          GreyBitType_Layout_SetLcdFilter(GBHANDLE layout,
+                                                    const GB_BYTE * pWeights,
+                                                    GB_BOOL bBGR);
 extern void         GreyBitType_Layout_Done(GBHANDLE layout);
 
 #ifdef __cplusplus
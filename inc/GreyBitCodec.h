@@ -8,6 +8,12 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Encoder bake
+** 10/18/2026	me				Decode packed
+** 10/18/2026	me				Decoder contexts
+** 10/18/2026	me				Span output
+** 10/18/2026	me				Decode into caller bitmap
+** 10/18/2026	me				Preload, batch decode
 ** 09/16/2024	me				Upgrade
 ** 08/07/2023	me              Init
 ** ===========================================================================
@@ -63,7 +69,24 @@ GB_INT16	GreyBit_Decoder_GetAdvance(GB_Decoder decoder, GB_UINT32 nCode,
 									  GB_INT16 nSize);
 GB_INT32	GreyBit_Decoder_Decode(GB_Decoder decoder, GB_UINT32 nCode,
 								   GB_Data pData, GB_INT16 nSize);
+GB_INT32	GreyBit_Decoder_DecodeTo(GB_Decoder decoder, GB_UINT32 nCode,
+									 GB_Data pData, GB_Bitmap pDst,
+									 GB_INT16 x, GB_INT16 y, GB_INT16 nSize);
+GB_INT32	GreyBit_Decoder_DecodeSpans(GB_Decoder decoder, GB_UINT32 nCode,
+										GB_Data pData, GB_SpanFunc func,
+										void* user, GB_INT16 nSize);
+GB_INT32	GreyBit_Decoder_DecodePacked(GB_Decoder decoder, GB_UINT32 nCode,
+										 GB_Data pData, GB_INT16 nSize);
+GB_INT32	GreyBit_Decoder_DecodeBatch(GB_Decoder decoder,
+										const GB_UINT32* pCodes,
+										GB_INT32 nCount, GB_Data pData,
+										GB_INT16 nSize);
+GB_INT32	GreyBit_Decoder_Preload(GB_Decoder decoder, const GB_UINT32* pCodes,
+									GB_INT32 nCount);
+GB_Decoder	GreyBit_Decoder_NewContext(GB_Decoder decoder, GB_Loader loader,
+									   GB_Stream stream);
 void		GreyBit_Decoder_Done(GB_Decoder decoder);
+void		GreyBit_Preload_Sort(PRELOADITEM* pItems, GB_INT32 nCount);
 
 #ifdef ENABLE_ENCODER
 GB_INT32	GreyBit_Encoder_SetParam(GB_Encoder encoder, GB_Param nParam,
@@ -73,6 +96,10 @@ GB_INT32	GreyBit_Encoder_Delete(GB_Encoder encoder, GB_UINT32 nCode);
 GB_INT32	GreyBit_Encoder_Encode(GB_Encoder encoder, GB_UINT32 nCode,
 								   GB_Data pData);
 GB_INT32	GreyBit_Encoder_Flush(GB_Encoder encoder);
+GB_INT32	GreyBit_Encoder_Bake(GB_Encoder encoder, GB_Loader loader,
+								 const GB_INT16* pSizes,
+								 const GB_INT16* pBitCounts, GB_INT32 nCount,
+								 GB_BOOL bFallback);
 void		GreyBit_Encoder_Done(GB_Encoder encoder);
 #endif //ENABLE_ENCODER
 
@@ -8,6 +8,16 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Size of the flushed font
+** 10/18/2026	me				Decoder contexts
+** 10/18/2026	me				1 bit compression
+** 10/18/2026	me				Span output
+** 10/18/2026	me				Length table
+** 10/18/2026	me				Cropped glyph storage
+** 10/18/2026	me				Decode into caller bitmap
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
+** 10/18/2026	me				Lazy section tables
 ** 09/16/2023	me				Upgrade
 ** 08/10/2023	me              Init
 ** ===========================================================================
@@ -46,6 +56,15 @@ extern "C" {
 #define IS_INRAM(d)					((d)&RAM_MASK)
 #define SET_RAM(d)					((d)|RAM_MASK)
 #define GET_INDEX(d)				((d)&(~RAM_MASK))
+#define GBF_FLAG_CROP				0x0001
+#define GBF_FLAG_LENGTHTAB			0x0002
+#define GBF_CROP_SIZE				2
+#define GBF_MAX_SPANS				32
+#define GBF_COMPRESS_NONE			0
+#define GBF_COMPRESS_RLE			1	/* 8 bit: runs of 7 bit values       */
+#define GBF_COMPRESS_BITS			2	/* 1 bit: row XOR, then byte runs    */
+									/* opt-in, GB_PARAM_COMPRESS == 2    */
+#define GBF_FONT(d)					((d)->gbFont ? (d)->gbFont : (d))
 
 /*
 **----------------------------------------------------------------------------
@@ -78,9 +97,19 @@ typedef struct tagGREYBITINFOHEADER
 } GREYBITINFOHEADER;
 #pragma pack()
 
+#pragma pack(1)
+typedef struct tagGREYBITINFOHEADEREX
+{
+	GB_UINT32		gbiFlags;
+	GB_UINT32		gbiLengthTabOff;
+} GREYBITINFOHEADEREX;
+#pragma pack()
+
 typedef struct GBF_DecoderRec
 {
 	GB_DecoderRec		gbDecoder;
+	struct GBF_DecoderRec*	gbFont;		/* font of a context, 0 for the font */
+	GB_BOOL				bShared;	/* font has contexts                 */
 	GB_Library			gbLibrary;
 	GB_Memory			gbMem;
 	GB_Stream			gbStream;
@@ -92,12 +121,17 @@ typedef struct GBF_DecoderRec
 	GB_UINT32			gbOffDataBits;
 	GREYBITFILEHEADER	gbFileHeader;
 	GREYBITINFOHEADER	gbInfoHeader;
+	GREYBITINFOHEADEREX	gbInfoHeaderEx;
 	GB_BYTE*			gbWidthTable;
 	GB_INT8*			gbHoriOffTable;
 	GB_UINT32*			gbOffsetTable;
+	GB_UINT16*			gbLengthTable;
 	GB_BYTE**			gpGreyBits;
 	GB_INT32			nGreyBitsCount;
 	GB_INT16*			pnGreySize;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE		gbSectionTable[UNICODE_SECTION_NUM];
+#endif //ENABLE_LAZYTABLE
 } GBF_DecoderRec, *GBF_Decoder;
 
 #ifdef ENABLE_ENCODER
@@ -110,12 +144,16 @@ typedef struct GBF_EncoderRec
 	GB_UINT16			nHeight;
 	GB_INT16			nBitCount;
 	GB_BOOL				bCompress;
+	GB_BOOL				bCrop;
+	GB_BOOL				bLengthTab;
 	GB_BOOL				gbInited;
 	GB_INT32			nCacheItem;
 	GB_INT32			nItemCount;
 	GB_UINT32			gbOffDataBits;
+	GB_UINT32			nFileSize;	/* bytes written by the last flush */
 	GREYBITFILEHEADER	gbFileHeader;
 	GREYBITINFOHEADER	gbInfoHeader;
+	GREYBITINFOHEADEREX	gbInfoHeaderEx;
 	GB_BYTE*			gbWidthTable;
 	GB_INT8*			gbHoriOffTable;
 	GB_UINT32*			gbOffsetTable;
@@ -150,6 +188,22 @@ GB_INT16	GreyBitFile_Decoder_GetAdvance(GB_Decoder decoder,
 										   GB_UINT32 nCode, GB_INT16 nSize);
 GB_INT32	GreyBitFile_Decoder_Decode(GB_Decoder decoder, GB_UINT32 nCode,
 									   GB_Data pData, GB_INT16 nSize);
+GB_INT32	GreyBitFile_Decoder_DecodeTo(GB_Decoder decoder, GB_UINT32 nCode,
+										 GB_Data pData, GB_Bitmap pDst,
+										 GB_INT16 x, GB_INT16 y,
+										 GB_INT16 nSize);
+GB_INT32	GreyBitFile_Decoder_DecodeSpans(GB_Decoder decoder, GB_UINT32 nCode,
+											GB_Data pData, GB_SpanFunc func,
+											void* user, GB_INT16 nSize);
+GB_INT32	GreyBitFile_Decoder_DecodeBatch(GB_Decoder decoder,
+											const GB_UINT32* pCodes,
+											GB_INT32 nCount, GB_Data pData,
+											GB_INT16 nSize);
+GB_INT32	GreyBitFile_Decoder_Preload(GB_Decoder decoder,
+										const GB_UINT32* pCodes,
+										GB_INT32 nCount);
+GB_Decoder	GreyBitFile_Decoder_NewContext(GB_Decoder decoder,
+										   GB_Loader loader, GB_Stream stream);
 void		GreyBitFile_Decoder_Done(GB_Decoder decoder);
 
 #ifdef ENABLE_ENCODER
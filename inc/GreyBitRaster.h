@@ -8,6 +8,12 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Render spans to a callback, GB_BBox moved to GreyBitType.h
+** 10/18/2026	me				Growable pool, raster stats
+** 10/18/2026	me				Raster engines
+** 10/18/2026	me				Render with a known box
+** 10/18/2026	me				Render packed outlines
+** 10/18/2026	me				GB_Span moved to GreyBitType_Def.h
 ** 09/16/2023	me				Return retypes
 ** 08/10/2023	me				Compile only if vector font is supported
 ** 08/09/2023	me              Init
@@ -37,6 +43,9 @@ extern "C" {
 */
 
 #define DEFAULT_POOL_SIZE			16384
+#define MAX_POOL_SIZE				262144	// pool grows up to this
+#define GB_RASTER_CELLS				0	// cell lists per row
+#define GB_RASTER_ACCUM				1	// dense accumulation, prefix sums
 #define GB_Raster_Span_Func			GB_SpanFunc
 
 /*
@@ -45,12 +54,6 @@ extern "C" {
 **----------------------------------------------------------------------------
 */
 
-typedef struct GB_BBox_
-{
-	GB_Pos  xMin, yMin;
-	GB_Pos  xMax, yMax;
-} GB_BBox;
-
 typedef struct _RST_Vector
 {
 	int x;
@@ -59,6 +62,15 @@ typedef struct _RST_Vector
 
 #define GB_Vector GB_PointRec
 
+typedef struct GB_RasterStatsRec_
+{
+	GB_INT32	nRenders;		// glyphs rendered
+	GB_INT32	nBands;			// bands swept
+	GB_INT32	nSplits;		// bands halved as the pool overflowed
+	GB_INT32	nGrows;			// times the pool grew
+	GB_INT32	nPoolSize;		// pool bytes now
+} GB_RasterStatsRec, *GB_RasterStats;
+
 typedef int(*GB_Outline_MoveToFunc)(const GB_Vector* to, void* user);
 #define GB_Outline_MoveTo_Func GB_Outline_MoveToFunc
 
@@ -85,15 +97,6 @@ typedef struct  GB_Outline_Funcs_
 	GB_Pos                  delta;
 } GB_Outline_Funcs;
 
-typedef struct GB_Span_
-{
-	short           x;
-	unsigned short  len;
-	unsigned char   coverage;
-} GB_Span;
-
-typedef void(*GB_SpanFunc)(int y, int count, const GB_Span*spans,void* user);
-
 /*
 **---------------------------------------------------------------------------
 **  Variable Declarations
@@ -108,7 +111,19 @@ typedef void(*GB_SpanFunc)(int y, int count, const GB_Span*spans,void* user);
 
 void*		GreyBit_Raster_New(GB_Library library, int nPoolSize);
 int			GreyBit_Raster_Render(void * raster, GB_Bitmap tobitmap,
-								  GB_Outline fromoutline);
+								  GB_Outline fromoutline, GB_BBox* cbox);
+int			GreyBit_Raster_RenderPacked(void * raster, GB_Bitmap tobitmap,
+										GB_PackedOutline fromoutline,
+										GB_BBox* cbox);
+int			GreyBit_Raster_RenderSpans(void * raster, GB_Outline outline,
+									   GB_SpanFunc func, void * user,
+									   GB_BBox* clip);
+int			GreyBit_Raster_RenderPackedSpans(void * raster,
+											 GB_PackedOutline outline,
+											 GB_SpanFunc func, void * user,
+											 GB_BBox* clip);
+int			GreyBit_Raster_SetEngine(void * raster, int nEngine);
+int			GreyBit_Raster_GetStats(void * raster, GB_RasterStats pStats);
 void		GreyBit_Raster_Done(void * raster);
 #endif //ENABLE_GREYVECTORFILE
 
@@ -8,6 +8,21 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Dense raster size of loader
+** 10/18/2026	me				GB_MULFIX exact past 16 bit operands
+** 10/18/2026	me				GB_Span moved to GreyBitType.h
+** 10/18/2026	me				LCD filter of layout
+** 10/18/2026	me				Layout outline for bold and italic
+** 10/18/2026	me				Encoder bake
+** 10/18/2026	me				Packed outlines, decode packed
+** 10/18/2026	me				Decoder contexts
+** 10/18/2026	me				Span output, GB_Span moved here
+** 10/18/2026	me				Section slice of GBF length table
+** 10/18/2026	me				Layout ink rows
+** 10/18/2026	me				Decode into caller bitmap
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
+** 10/18/2026	me				Lazy section tables
 ** 09/16/2023	me				Upgrade
 ** 08/08/2023	me				Init
 ** ===========================================================================
@@ -33,6 +48,20 @@ extern "C" {
 **----------------------------------------------------------------------------
 */
 
+#define GB_PRELOAD_WINDOW	0x1000	/* bytes read per preload I/O           */
+
+/* a * b for a 16.16 b, rounded; the fraction of b is taken a byte at a */
+/* time, so with 32 bit GB_INT32 it is exact while |a| < 0x800000        */
+#define GB_MULFIX(a,b)		((GB_INT32)(a) * ((b) >> 16) \
+							 + (((GB_INT32)(a) * (GB_INT32)(((b) >> 8) & 0xFF) \
+							 + (((GB_INT32)(a) * (GB_INT32)((b) & 0xFF)) >> 8) \
+							 + 0x80) >> 8))
+
+/* tag and scaled 26.6 coordinate of a packed outline point byte */
+#define GB_PACKED_TAG(o,i)	(((o)->points[(i) * 2] & 1) \
+							 | (((o)->points[(i) * 2 + 1] & 1) << 1))
+#define GB_PACKED_POS(o,v)	GB_MULFIX(((v) >> 1) << 6, (o)->scale)
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
@@ -55,6 +84,7 @@ typedef struct _GB_LoaderRec
 	GB_Memory	gbMem;
 	GB_Stream	gbStream;
 	GB_Decoder	gbDecoder;
+	GB_INT32	nAccumMax;	/* largest layout size rendered dense        */
 } GB_LoaderRec, *GB_Loader;
 
 typedef struct _GB_LayoutRec
@@ -67,6 +97,9 @@ typedef struct _GB_LayoutRec
 	GB_Bitmap	gbBitmap8;
 #ifdef ENABLE_GREYVECTORFILE
 	void*		gbRaster;
+	GB_Outline	gbOutline;		/* bold/italic copy of the decoded outline */
+	GB_INT16	nOutlineContours;
+	GB_INT16	nOutlinePoints;
 #endif //ENABLE_GREYVECTORFILE
 	GB_UINT32	dwCode;
 	GB_BYTE*	gbSwitchBuf;
@@ -75,8 +108,12 @@ typedef struct _GB_LayoutRec
 	GB_INT16	nHeight;
 	GB_INT16	nSize;
 	GB_INT16	nBitCount;
+	GB_INT16	nInkTop;
+	GB_INT16	nInkHeight;
 	GB_INT16	bItalic;
 	GB_INT16	bBold;
+	GB_BYTE		gbLcdWeights[5];	/* subpixel filter taps, sum 0x100 */
+	GB_BOOL		bLcdBGR;
 } GB_LayoutRec, *GB_Layout;
 
 typedef struct _GB_CreatorRec
@@ -92,6 +129,31 @@ typedef struct tagSECTIONOINFO
 	GB_UINT16	gbSectionOff[146];
 } SECTIONOINFO;
 
+#ifdef ENABLE_LAZYTABLE
+typedef struct tagSECTIONTABLE
+{
+	GB_UINT32*	gbOffset;		/* section slice of the offset table       */
+	GB_BYTE*	gbWidth;		/* section slice of the width table        */
+	GB_INT8*	gbHoriOff;		/* section slice of the horioff table      */
+	GB_UINT16*	gbLength;		/* section slice of the length table, or 0 */
+} SECTIONTABLE;
+#endif //ENABLE_LAZYTABLE
+
+typedef struct tagPRELOADITEM
+{
+	GB_UINT32	nCode;
+	GB_UINT32	nOffset;
+} PRELOADITEM;
+
+typedef struct _GB_PackedOutlineRec
+{
+	GB_INT16	n_contours;
+	GB_INT16	n_points;
+	GB_BYTE*	contours;	/* contour end points                           */
+	GB_BYTE*	points;		/* x/y bytes as stored in GVF, tag in bit 0     */
+	GB_INT32	scale;		/* 16.16 from font height to character size     */
+} GB_PackedOutlineRec, *GB_PackedOutline;
+
 typedef GB_Decoder(*GB_DECODER_NEW)(GB_Loader loader, GB_Stream stream);
 #ifdef ENABLE_ENCODER
 typedef GB_Encoder(*GB_ENCODER_NEW)(GB_Creator loader, GB_Stream stream);
@@ -122,6 +184,26 @@ typedef GB_INT16(*GB_DECODER_GETADVANCE)(GB_Decoder decoder,
 										 GB_UINT32 nCode, GB_INT16 nSize);
 typedef GB_INT32(*GB_DECODER_DECODE)(GB_Decoder decoder, GB_UINT32 nCode,
 									 GB_Data pData, GB_INT16 nSize);
+typedef GB_INT32(*GB_DECODER_DECODETO)(GB_Decoder decoder, GB_UINT32 nCode,
+									   GB_Data pData, GB_Bitmap pDst,
+									   GB_INT16 x, GB_INT16 y,
+									   GB_INT16 nSize);
+typedef GB_INT32(*GB_DECODER_DECODESPANS)(GB_Decoder decoder, GB_UINT32 nCode,
+										  GB_Data pData, GB_SpanFunc func,
+										  void* user, GB_INT16 nSize);
+typedef GB_INT32(*GB_DECODER_DECODEPACKED)(GB_Decoder decoder,
+										   GB_UINT32 nCode, GB_Data pData,
+										   GB_INT16 nSize);
+typedef GB_INT32(*GB_DECODER_DECODEBATCH)(GB_Decoder decoder,
+										  const GB_UINT32* pCodes,
+										  GB_INT32 nCount, GB_Data pData,
+										  GB_INT16 nSize);
+typedef GB_INT32(*GB_DECODER_PRELOAD)(GB_Decoder decoder,
+									  const GB_UINT32* pCodes,
+									  GB_INT32 nCount);
+typedef GB_Decoder(*GB_DECODER_NEWCONTEXT)(GB_Decoder decoder,
+										   GB_Loader loader,
+										   GB_Stream stream);
 typedef void(*GB_DECODER_DONE)(GB_Decoder decoder);
 
 struct _GB_DecoderRec
@@ -132,6 +214,12 @@ struct _GB_DecoderRec
 	GB_DECODER_GETWIDTH		getwidth;
 	GB_DECODER_GETADVANCE	getadvance;
 	GB_DECODER_DECODE		decode;
+	GB_DECODER_DECODETO		decodeto;
+	GB_DECODER_DECODESPANS	decodespans;
+	GB_DECODER_DECODEPACKED	decodepacked;
+	GB_DECODER_DECODEBATCH	decodebatch;
+	GB_DECODER_PRELOAD		preload;
+	GB_DECODER_NEWCONTEXT	newcontext;
 	GB_DECODER_DONE			done;
 };
 
@@ -143,6 +231,10 @@ typedef GB_INT32(*GB_ENCODER_DELETE)(GB_Encoder encoder, GB_UINT32 nCode);
 typedef GB_INT32(*GB_ENCODER_ENCODE)(GB_Encoder encoder, GB_UINT32 nCode,
 									 GB_Data pData);
 typedef GB_INT32(*GB_ENCODER_FLUSH)(GB_Encoder encoder);
+typedef GB_INT32(*GB_ENCODER_BAKE)(GB_Encoder encoder, GB_Loader loader,
+								   const GB_INT16* pSizes,
+								   const GB_INT16* pBitCounts,
+								   GB_INT32 nCount, GB_BOOL bFallback);
 typedef void(*GB_ENCODER_DONE)(GB_Encoder encoder);
 
 struct _GB_EncoderRec
@@ -152,6 +244,7 @@ struct _GB_EncoderRec
 	GB_ENCODER_DELETE	remove;
 	GB_ENCODER_ENCODE	encode;
 	GB_ENCODER_FLUSH	flush;
+	GB_ENCODER_BAKE		bake;
 	GB_ENCODER_DONE		done;
 };
 #endif //ENABLE_ENCODER
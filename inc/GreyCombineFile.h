@@ -8,6 +8,13 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Bitmap strikes
+** 10/18/2026	me				Decode packed
+** 10/18/2026	me				Decoder contexts
+** 10/18/2026	me				Span output
+** 10/18/2026	me				Decode into caller bitmap
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
 ** 09/16/2023	me				Upgrade
 ** 08/11/2023	me              Init
 ** ===========================================================================
@@ -49,7 +56,7 @@ extern "C" {
 #pragma pack(1)
 typedef struct tagGREYCOMBINEITEMINFO
 {
-	GB_UINT32	gbiHeight;
+	GB_UINT32	gbiHeight;		/* strike size, 0 for any size           */
 	GB_UINT32	gbiDataOff;
 	GB_UINT32	gbiDataSize;
 } GREYCOMBINEITEMINFO;
@@ -82,6 +89,7 @@ typedef struct _GCF_EncoderRec
 	GB_Stream				gbStream;
 	GREYCOMBINEFILEHEADER	gbFileHeader;
 	GB_Stream				gbCreator[GCF_ITEM_MAX];
+	GB_UINT32				nHeight;	/* size of the next item         */
 } GCF_EncoderRec, *GCF_Encoder;
 #endif //ENABLE_ENCODER
 
@@ -117,6 +125,33 @@ extern GB_INT32		GreyCombineFile_Decoder_Decode(GB_Decoder decoder,
 												   GB_UINT32 nCode,
 												   GB_Data pData,
 												   GB_INT16 nSize);
+extern GB_INT32		GreyCombineFile_Decoder_DecodeTo(GB_Decoder decoder,
+												  GB_UINT32 nCode,
+												  GB_Data pData,
+												  GB_Bitmap pDst,
+												  GB_INT16 x, GB_INT16 y,
+												  GB_INT16 nSize);
+extern GB_INT32		GreyCombineFile_Decoder_DecodeSpans(GB_Decoder decoder,
+													GB_UINT32 nCode,
+													GB_Data pData,
+													GB_SpanFunc func,
+													void* user,
+													GB_INT16 nSize);
+extern GB_INT32		GreyCombineFile_Decoder_DecodePacked(GB_Decoder decoder,
+													 GB_UINT32 nCode,
+													 GB_Data pData,
+													 GB_INT16 nSize);
+extern GB_INT32		GreyCombineFile_Decoder_DecodeBatch(GB_Decoder decoder,
+													const GB_UINT32* pCodes,
+													GB_INT32 nCount,
+													GB_Data pData,
+													GB_INT16 nSize);
+extern GB_INT32		GreyCombineFile_Decoder_Preload(GB_Decoder decoder,
+												const GB_UINT32* pCodes,
+												GB_INT32 nCount);
+extern GB_Decoder	GreyCombineFile_Decoder_NewContext(GB_Decoder decoder,
+													   GB_Loader loader,
+													   GB_Stream stream);
 extern void			GreyCombineFile_Decoder_Done(GB_Decoder decoder);
 	
 #ifdef ENABLE_ENCODER
@@ -129,6 +164,12 @@ extern GB_INT32		GreyCombineFile_Encoder_GetCount(GB_Encoder encoder);
 extern GB_INT32		GreyCombineFile_Encoder_Encode(GB_Encoder encoder,
 												   GB_UINT32 nCode,
 												   GB_Data pData);
+extern GB_INT32		GreyCombineFile_Encoder_Bake(GB_Encoder encoder,
+												 GB_Loader loader,
+												 const GB_INT16* pSizes,
+												 const GB_INT16* pBitCounts,
+												 GB_INT32 nCount,
+												 GB_BOOL bFallback);
 extern void			GreyCombineFile_Encoder_Done(GB_Encoder encoder);
 #endif //ENABLE_ENCODER
 #endif //ENABLE_GREYCOMBINEFILE
@@ -8,6 +8,18 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Flag for tables behind the records
+** 10/18/2026	me				Streaming encoder writes
+** 10/18/2026	me				Pre-flattened polyline records
+** 10/18/2026	me				Encode-time outline simplification
+** 10/18/2026	me				Glyph bounding boxes
+** 10/18/2026	me				Delta coded records
+** 10/18/2026	me				Decode packed records
+** 10/18/2026	me				Scaled outline cache
+** 10/18/2026	me				Decoder contexts
+** 10/18/2026	me				Lazy section tables
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
 ** 09/16/2023	me				Upgrade
 ** 08/07/2023	me              Init
 ** ===========================================================================
@@ -23,8 +35,10 @@
 */
 
 #include "../GreyBitType.h"
+#include "../inc/UnicodeSection.h"
 #include "../inc/GreyBitType_Def.h"
 #include "../inc/GreyBitCodec.h"
+#include "../inc/GreyBitRaster.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -48,6 +62,28 @@ extern "C" {
 #define IS_INRAM(d)				((d)&RAM_MASK)
 #define SET_RAM(d)				((d)|RAM_MASK)
 #define GET_INDEX(d)			((d)&(~RAM_MASK))
+#define GVF_FONT(d)				((d)->gbFont ? (d)->gbFont : (d))
+#define GVF_SCALE_HASH			64
+#define GVF_SCALE_INDEX(c,s)	(((c) * 31 + (s)) & (GVF_SCALE_HASH - 1))
+#define GVF_FLAG_DELTA			0x0001
+#define GVF_FLAG_BBOX			0x0002
+#define GVF_FLAG_FLAT			0x0004		/* on points only, no tag bits   */
+#define GVF_FLAG_TAIL			0x0008		/* tables behind the records     */
+#define GVF_BBOX_MAXSIZE		8		/* 4 varints of at most 2 bytes  */
+#define GVF_RECORD_MAXSIZE		(0xFFFF + 2)	/* record and its length     */
+#define GVF_IS_DELTA(d)			((d)->gbInfoHeaderEx.gbiFlags & GVF_FLAG_DELTA)
+#define GVF_DELTA_SHIFT			2		/* 26.6 to 1/16 pixel units      */
+#define GVF_DELTA_MAXSIZE(c,p)	(4 + 3 * (GB_INT32)(c) + ((GB_INT32)(p) + 3) / 4 \
+								 + 6 * (GB_INT32)(p))
+#define GVF_ZIGZAG(v)			((v) < 0 ? ((GB_UINT32)-(v) << 1) - 1 \
+										 : (GB_UINT32)(v) << 1)
+#define GVF_UNZIGZAG(u)			((GB_INT32)((u) >> 1) ^ -(GB_INT32)((u) & 1))
+#define GVF_SIMPLIFY_STEPS		8		/* samples per arc when merging  */
+#define GVF_SIMPLIFY_FAR		0x7FFFFFFF
+#define GVF_SIMPLIFY_OUT(v)		((v) < -0x3FFF || (v) > 0x3FFF)
+#define GVF_ABS(v)				((v) < 0 ? -(v) : (v))
+#define GVF_FLATTEN_MAXCONIC	64		/* steps, keeps sums in 32 bits  */
+#define GVF_FLATTEN_MAXCUBIC	16
 
 /*
 **----------------------------------------------------------------------------
@@ -69,6 +105,18 @@ typedef struct  _GVF_OutlineRec
 	GB_BYTE       *contours;        /* the contour end points             */
 } GVF_OutlineRec, *GVF_Outline;
 
+typedef struct  _GVF_ScaledRec
+{
+	struct _GVF_ScaledRec*	pNext;		/* next in the hash bucket           */
+	struct _GVF_ScaledRec*	pNewer;		/* used after this one               */
+	struct _GVF_ScaledRec*	pOlder;		/* used before this one              */
+	GB_UINT32				nCode;
+	GB_INT16				nSize;
+	GB_INT32				nBytes;		/* memory held, counted in budget    */
+	GB_Outline				outline;	/* outline at nSize                  */
+	GB_BBox					bbox;		/* box at font height                */
+} GVF_ScaledRec, *GVF_Scaled;
+
 #pragma pack(1)
 typedef struct tagGREYVECTORFILEHEADER
 {
@@ -94,9 +142,18 @@ typedef struct tagGREYVECTORINFOHEADER
 } GREYVECTORINFOHEADER;
 #pragma pack()
 
+#pragma pack(1)
+typedef struct tagGREYVECTORINFOHEADEREX
+{
+	GB_UINT32		gbiFlags;
+} GREYVECTORINFOHEADEREX;
+#pragma pack()
+
 typedef struct _GVF_DecoderRec
 {
 	GB_DecoderRec			gbDecoder;
+	struct _GVF_DecoderRec*	gbFont;		/* font of a context, 0 for the font */
+	GB_BOOL					bShared;	/* font has contexts                 */
 	GB_Library				gbLibrary;
 	GB_Memory				gbMem;
 	GB_Stream				gbStream;
@@ -108,11 +165,22 @@ typedef struct _GVF_DecoderRec
 	GB_UINT32				gbOffDataBits;
 	GREYVECTORFILEHEADER	gbFileHeader;
 	GREYVECTORINFOHEADER	gbInfoHeader;
+	GREYVECTORINFOHEADEREX	gbInfoHeaderEx;
 	GB_BYTE*				gbWidthTable;
 	GB_INT8*				gbHoriOffTable;
 	GB_UINT32*				gbOffsetTable;
 	GB_Outline*				gpGreyBits;
 	GB_INT32				nGreyBitsCount;
+	GB_PackedOutlineRec		gbPacked;	/* record view for packed decode     */
+	GB_BBox					gbBBox;		/* box of last outline, font height  */
+	GVF_Scaled				gbScaleHash[GVF_SCALE_HASH];
+	GVF_Scaled				gbScaleNewest;
+	GVF_Scaled				gbScaleOldest;
+	GB_INT32				nScaleBudget;
+	GB_INT32				nScaleBytes;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE			gbSectionTable[UNICODE_SECTION_NUM];
+#endif //ENABLE_LAZYTABLE
 } GVF_DecoderRec, *GVF_Decoder;
 
 #ifdef ENABLE_ENCODER
@@ -123,16 +191,21 @@ typedef struct _GVF_EncoderRec
 	GB_Memory				gbMem;
 	GB_Stream				gbStream;
 	GB_UINT16				nHeight;
+	GB_BOOL					bDelta;
+	GB_BOOL					bBBox;
+	GB_INT32				nTolerance;
+	GB_INT32				nFlatten;
 	GB_BOOL					gbInited;
-	GB_INT32				nCacheItem;
 	GB_INT32				nItemCount;
 	GB_UINT32				gbOffDataBits;
+	GB_UINT32				nGreyBitSize;	/* record bytes written so far   */
+	GB_BYTE*				pRecord;		/* one record, reused per glyph  */
 	GREYVECTORFILEHEADER	gbFileHeader;
 	GREYVECTORINFOHEADER	gbInfoHeader;
+	GREYVECTORINFOHEADEREX	gbInfoHeaderEx;
 	GB_BYTE*				gbWidthTable;
 	GB_INT8*				gbHoriOffTable;
 	GB_UINT32*				gbOffsetTable;
-	GB_Outline*				gpGreyBits;
 	GB_UINT16*				pnGreySize;
 } GVF_EncoderRec, *GVF_Encoder;
 #endif
@@ -165,10 +238,37 @@ extern void			GreyVector_Outline_Done(GB_Library library,
 											GVF_Outline outline);
 extern GVF_Outline	GreyVector_Outline_NewByGB(GB_Library library,
 											   GB_Outline source);
+extern GB_INT32		GreyVector_Outline_PackGB(GB_Outline source,
+											  GB_BYTE* pData);
 extern GB_Outline	GreyBitType_Outline_NewByGVF(GB_Library library,
 												 GVF_Outline source);
 extern GB_Outline	GreyBitType_Outline_UpdateByGVF(GB_Outline outline,
 													GVF_Outline source);
+extern GB_INT32		GreyVector_Outline_PackDelta(GB_Outline source,
+												 GB_BYTE* pData,
+												 GB_UINT32 nFlags);
+extern GB_INT32		GreyVector_Outline_PackBBox(GB_Outline source,
+												GB_BYTE* pData);
+extern GB_INT32		GreyVector_Outline_UnpackBBox(GB_BBox* bbox,
+												  GB_BYTE* pData,
+												  GB_INT32 nLength);
+extern void			GreyVector_Outline_GetBBox(GVF_Outline outline,
+											   GB_BBox* bbox);
+extern void			GreyBitType_Outline_GetBBox(GB_Outline outline,
+												GB_BBox* bbox);
+extern GB_Outline	GreyBitType_Outline_UpdateByDelta(GB_Outline outline,
+													  GB_BYTE* pData,
+													  GB_INT32 nLength,
+													  GB_INT16 nMaxContours,
+													  GB_INT16 nMaxPoints,
+													  GB_UINT32 nFlags);
+#ifdef ENABLE_ENCODER
+extern GB_INT32		GreyVector_Outline_Simplify(GB_Outline outline,
+												GB_INT32 nTolerance);
+extern GB_Outline	GreyVector_Outline_Flatten(GB_Library library,
+											   GB_Outline source,
+											   GB_INT32 nTolerance);
+#endif //ENABLE_ENCODER
 
 extern GB_Decoder	GreyVectorFile_Decoder_New(GB_Loader loader,
 											   GB_Stream stream);
@@ -187,6 +287,21 @@ extern GB_INT32		GreyVectorFile_Decoder_Decode(GB_Decoder decoder,
 												  GB_UINT32 nCode,
 												  GB_Data pData,
 												  GB_INT16 nSize);
+extern GB_INT32		GreyVectorFile_Decoder_DecodePacked(GB_Decoder decoder,
+													GB_UINT32 nCode,
+													GB_Data pData,
+													GB_INT16 nSize);
+extern GB_INT32		GreyVectorFile_Decoder_DecodeBatch(GB_Decoder decoder,
+												   const GB_UINT32* pCodes,
+												   GB_INT32 nCount,
+												   GB_Data pData,
+												   GB_INT16 nSize);
+extern GB_INT32		GreyVectorFile_Decoder_Preload(GB_Decoder decoder,
+											   const GB_UINT32* pCodes,
+											   GB_INT32 nCount);
+extern GB_Decoder	GreyVectorFile_Decoder_NewContext(GB_Decoder decoder,
+													  GB_Loader loader,
+													  GB_Stream stream);
 extern void			GreyVectorFile_Decoder_Done(GB_Decoder decoder);
 
 #ifdef ENABLE_ENCODER
@@ -8,6 +8,13 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Encoder bake
+** 10/18/2026	me				Decode packed
+** 10/18/2026	me				Decoder contexts
+** 10/18/2026	me				Span output
+** 10/18/2026	me				Decode into caller bitmap
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
 ** 09/16/2024	me				Upgrade
 ** 08/07/2023	me              Init
 ** ===========================================================================
@@ -155,6 +162,141 @@ GB_INT32	GreyBit_Decoder_Decode(GB_Decoder decoder, GB_UINT32 nCode,
 	return decoder->decode(decoder, nCode, pData, nSize);
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Decoder_DecodeTo
+** Description: Decode a character straight into a caller bitmap
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer, may be 0
+**		  pDst - destination bitmap
+**		  x - left of the character in pDst
+**		  y - top of the character in pDst
+**		  nSize - character size
+** Output: Decoded character in pDst
+** Return value: decoder->decodeto, or fail if not supported
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBit_Decoder_DecodeTo(GB_Decoder decoder, GB_UINT32 nCode,
+									 GB_Data pData, GB_Bitmap pDst,
+									 GB_INT16 x, GB_INT16 y, GB_INT16 nSize)
+{
+	if (!decoder->decodeto)
+		return GB_FAILED;
+	return decoder->decodeto(decoder, nCode, pData, pDst, x, y, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Decoder_DecodeSpans
+** Description: Decode a character as coverage spans, without a bitmap
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer, may be 0
+**		  func - span callback, y is the character row
+**		  user - callback data
+**		  nSize - character size
+** Output: Spans passed to func
+** Return value: decoder->decodespans, or fail if not supported
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBit_Decoder_DecodeSpans(GB_Decoder decoder, GB_UINT32 nCode,
+										GB_Data pData, GB_SpanFunc func,
+										void* user, GB_INT16 nSize)
+{
+	if (!decoder->decodespans)
+		return GB_FAILED;
+	return decoder->decodespans(decoder, nCode, pData, func, user, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Decoder_DecodePacked
+** Description: Decode a character, as a packed outline where the decoder
+**              has one, so that it is scaled while rendered
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer
+**		  nSize - character size
+** Output: Decoded character, any format including GB_FORMAT_PACKED
+** Return value: decoder->decodepacked, or decoder->decode if not supported
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBit_Decoder_DecodePacked(GB_Decoder decoder, GB_UINT32 nCode,
+										 GB_Data pData, GB_INT16 nSize)
+{
+	if (!decoder->decodepacked)
+		return GreyBit_Decoder_Decode(decoder, nCode, pData, nSize);
+	return decoder->decodepacked(decoder, nCode, pData, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Decoder_DecodeBatch
+** Description: Decode a run of characters into caller storage
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+**	      pData - data array, pData[i].data is the caller's bitmap/outline
+**		  nSize - character size
+** Output: Decoded characters
+** Return value: decoder->decodebatch, or 0 if not supported
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBit_Decoder_DecodeBatch(GB_Decoder decoder,
+										const GB_UINT32* pCodes,
+										GB_INT32 nCount, GB_Data pData,
+										GB_INT16 nSize)
+{
+	if (!decoder->decodebatch)
+		return 0;
+	return decoder->decodebatch(decoder, pCodes, nCount, pData, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Decoder_Preload
+** Description: Load a set of characters into the decoder cache
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+** Output: Cached characters
+** Return value: decoder->preload, or fail if not supported
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBit_Decoder_Preload(GB_Decoder decoder, const GB_UINT32* pCodes,
+									GB_INT32 nCount)
+{
+	if (!decoder->preload)
+		return GB_FAILED;
+	return decoder->preload(decoder, pCodes, nCount);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Decoder_NewContext
+** Description: Make a decode context sharing the font data of a decoder
+** Input: decoder - decoder
+**		  loader - loader of the context
+**		  stream - stream of the context
+** Output: New decoder context
+** Return value: decoder->newcontext, or 0 if not supported
+** ---------------------------------------------------------------------------
+*/
+
+GB_Decoder	GreyBit_Decoder_NewContext(GB_Decoder decoder, GB_Loader loader,
+									   GB_Stream stream)
+{
+	if (!decoder->newcontext)
+		return 0;
+	return decoder->newcontext(decoder, loader, stream);
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBit_Decoder_Done
@@ -170,6 +312,36 @@ void		GreyBit_Decoder_Done(GB_Decoder decoder)
 	decoder->done(decoder);
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Preload_Sort
+** Description: Sort preload items by file offset (shell sort, no recursion)
+** Input: pItems - preload items
+**		  nCount - item count
+** Output: Sorted items
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyBit_Preload_Sort(PRELOADITEM* pItems, GB_INT32 nCount)
+{
+	GB_INT32	nGap;
+	GB_INT32	i;
+	GB_INT32	j;
+	PRELOADITEM	item;
+
+	for (nGap = nCount >> 1; nGap > 0; nGap >>= 1)
+	{
+		for (i = nGap; i < nCount; i++)
+		{
+			item = pItems[i];
+			for (j = i; j >= nGap && pItems[j - nGap].nOffset > item.nOffset; j -= nGap)
+				pItems[j] = pItems[j - nGap];
+			pItems[j] = item;
+		}
+	}
+}
+
 #ifdef ENABLE_ENCODER
 /*
 ** ---------------------------------------------------------------------------
@@ -253,6 +425,32 @@ GB_INT32	GreyBit_Encoder_Flush(GB_Encoder encoder)
 	return encoder->flush(encoder);
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Encoder_Bake
+** Description: Render the characters of a loader into bitmap strikes
+** Input: encoder - encoder
+**        loader - loader of the source font
+**        pSizes - strike sizes
+**        pBitCounts - strike bit counts
+**        nCount - strike count
+**        bFallback - keep the source font for other sizes
+** Output: Added strikes
+** Return value: encoder->bake/fail if the format can't hold strikes
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBit_Encoder_Bake(GB_Encoder encoder, GB_Loader loader,
+								 const GB_INT16* pSizes,
+								 const GB_INT16* pBitCounts, GB_INT32 nCount,
+								 GB_BOOL bFallback)
+{
+	if (!encoder->bake)
+		return GB_FAILED;
+	return encoder->bake(encoder, loader, pSizes, pBitCounts, nCount,
+						 bFallback);
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBit_Encoder_Done
@@ -8,6 +8,7 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Bake
 ** 09/16/2023	me				Upgrade
 ** 08/10/2023	me				Add feature as to compile encoder stuff only 
 **								if encoder is supported
@@ -116,7 +117,7 @@ GBHANDLE	GreyBitType_Creator_New(GBHANDLE library,
 	GB_Creator	creator;
 
 	me = (GB_Library)library;
-	creator = (GB_Creator)GreyBit_Malloc(me->gbMem, sizeof(GB_Creator));
+	creator = (GB_Creator)GreyBit_Malloc(me->gbMem, sizeof(GB_CreatorRec));
 	if (!creator)
 		return creator;
 	creator->gbLibrary = me;
@@ -149,7 +150,7 @@ GBHANDLE	GreyBitType_Creator_New_Memory(GBHANDLE library, void *pBuf,
 	GB_Creator	creator;
 
 	me = (GB_Library)library;
-	creator = (GB_Creator)GreyBit_Malloc(me->gbMem, sizeof(GB_Creator));
+	creator = (GB_Creator)GreyBit_Malloc(me->gbMem, sizeof(GB_CreatorRec));
 	if (!creator)
 		return creator;
 	creator->gbLibrary = me;
@@ -239,6 +240,36 @@ int			GreyBitType_Creator_Flush(GBHANDLE creator)
 	return GreyBit_Encoder_Flush(me->gbEncoder);
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Creator_Bake
+** Description: Bake a font into bitmap strikes, e.g. a vector font into a
+**              combined font holding the sizes a device draws most. Every
+**              character of loader is rendered once per strike; with
+**              bFallback the source font is stored as well, for the sizes
+**              without a strike.
+** Input: creator - creator
+**        loader - loader of the source font
+**        pSizes - strike sizes
+**        pBitCounts - strike bit counts
+**        nCount - strike count
+**        bFallback - keep the source font?
+** Output: Added strikes
+** Return value: GreyBit_Encoder_Bake
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Creator_Bake(GBHANDLE creator, GBHANDLE loader,
+									 const GB_INT16* pSizes,
+									 const GB_INT16* pBitCounts,
+									 GB_INT32 nCount, GB_BOOL bFallback)
+{
+	GB_Creator	me = (GB_Creator)creator;
+
+	return GreyBit_Encoder_Bake(me->gbEncoder, (GB_Loader)loader, pSizes,
+								pBitCounts, nCount, bFallback);
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Creator_Done
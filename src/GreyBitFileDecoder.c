@@ -8,6 +8,19 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				RLE background decodes to 0, as its spans
+** 10/18/2026	me				Offsets looked up under the stream lock
+** 10/18/2026	me				Ink columns
+** 10/18/2026	me				No packed decode
+** 10/18/2026	me				Decode contexts
+** 10/18/2026	me				1 bit compression
+** 10/18/2026	me				Span output
+** 10/18/2026	me				Length table
+** 10/18/2026	me				Cropped glyph storage
+** 10/18/2026	me				Decode into caller bitmap
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
+** 10/18/2026	me				Lazy section tables
 ** 09/16/2023	me				Upgrade
 ** 08/09/2023	me              Init
 ** ===========================================================================
@@ -22,6 +35,7 @@
 #include "../inc/UnicodeSection.h"
 #include "../GreyBitSystem.h"
 #include "../inc/GreyBitFile.h"
+#include "../inc/GreyBitCodec.h"
 
 #ifdef ENABLE_GREYBITFILE
 /*
@@ -74,11 +88,94 @@ GB_INT32	GreyBitFile_Decoder_InfoInit(GBF_Decoder decoder,
 	decoder->gbBitmap = GreyBitType_Bitmap_New(decoder->gbLibrary, nMaxWidth, 
 											  nHeight, nBitCount, 0);
 	decoder->nBuffSize = decoder->gbBitmap->pitch * decoder->gbBitmap->height;
+	if (decoder->gbInfoHeader.gbiCompression == GBF_COMPRESS_BITS)
+		decoder->nBuffSize += decoder->nBuffSize / LEN_MASK + 1;
+	if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_CROP)
+		decoder->nBuffSize += GBF_CROP_SIZE;
 	decoder->pBuff = (GB_BYTE *)GreyBit_Malloc(decoder->gbMem,
 											   decoder->nBuffSize);
 	return GB_SUCCESS;
 }
 
+#ifdef ENABLE_LAZYTABLE
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_LoadSection
+** Description: Load the table slices of a section on first access. The
+**              caller holds the stream lock or the font is not shared; a
+**              shared font had every section loaded before its first
+**              context, so it only ever takes the first test here. The
+**              slices are read in full before gbOffset is set, as a set
+**              gbOffset is what marks the section loaded.
+** Input: decoder - decoder
+**        UniIndex - unicode section index
+** Output: Loaded section tables
+** Return value: section tables/0 if section is not in font
+** ---------------------------------------------------------------------------
+*/
+
+SECTIONTABLE*	GreyBitFile_Decoder_LoadSection(GBF_Decoder decoder,
+												GB_INT32 UniIndex)
+{
+	GB_UINT16		WidthIdx;
+	GB_UINT16		SectionIndex;
+	GB_INT32		nSectionLen;
+	GB_INT32		nEntrySize;
+	GB_BYTE*		pData;
+	GB_UINT32*		pOffset;
+	GB_UINT16*		pLength;
+	SECTIONTABLE*	section;
+
+	section = &decoder->gbSectionTable[UniIndex];
+	if (section->gbOffset)
+		return section;
+	WidthIdx = decoder->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
+	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
+	if (!WidthIdx || !SectionIndex)
+		return 0;
+	nSectionLen = UnicodeSection_GetSectionNum(UniIndex);
+	nEntrySize = sizeof(GB_UINT32) + 2;
+	if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_LENGTHTAB)
+		nEntrySize += sizeof(GB_UINT16);
+	pData = (GB_BYTE *)GreyBit_Malloc(decoder->gbMem,
+									  nSectionLen * nEntrySize);
+	if (!pData)
+		return 0;
+	pOffset = (GB_UINT32 *)pData;
+	pData += sizeof(GB_UINT32) * nSectionLen;
+	pLength = 0;
+	if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_LENGTHTAB)
+	{
+		pLength = (GB_UINT16 *)pData;
+		pData += sizeof(GB_UINT16) * nSectionLen;
+		GreyBit_Stream_Seek(decoder->gbStream,
+							decoder->gbInfoHeaderEx.gbiLengthTabOff
+						  + decoder->gbOffDataBits + sizeof(GB_UINT16)
+						  * (SectionIndex - 1));
+		GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE *)pLength,
+							sizeof(GB_UINT16) * nSectionLen);
+	}
+	GreyBit_Stream_Seek(decoder->gbStream,
+						decoder->gbInfoHeader.gbiOffsetTabOff
+					  + decoder->gbOffDataBits + sizeof(GB_UINT32)
+					  * (SectionIndex - 1));
+	GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE *)pOffset,
+						sizeof(GB_UINT32) * nSectionLen);
+	GreyBit_Stream_Seek(decoder->gbStream, decoder->gbInfoHeader.gbiWidthTabOff
+					  + decoder->gbOffDataBits + WidthIdx - 1);
+	GreyBit_Stream_Read(decoder->gbStream, pData, nSectionLen);
+	GreyBit_Stream_Seek(decoder->gbStream,
+						decoder->gbInfoHeader.gbiHoriOffTabOff
+					  + decoder->gbOffDataBits + WidthIdx - 1);
+	GreyBit_Stream_Read(decoder->gbStream, pData + nSectionLen, nSectionLen);
+	section->gbLength = pLength;
+	section->gbWidth = pData;
+	section->gbHoriOff = (GB_INT8 *)(pData + nSectionLen);
+	section->gbOffset = pOffset;
+	return section;
+}
+#endif //ENABLE_LAZYTABLE
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitFile_Decoder_CaheItem
@@ -95,26 +192,41 @@ GB_INT32	GreyBitFile_Decoder_InfoInit(GBF_Decoder decoder,
 GB_INT32	GreyBitFile_Decoder_CaheItem(GBF_Decoder decoder, GB_UINT32 nCode,
 										 GB_BYTE *pData, GB_INT32 nDataSize)
 {
-	GB_UINT16	nMinCode;
-	GB_UINT16	SectionIndex;
-	GB_INT32	UniIndex;
+	GB_UINT16		nMinCode;
+	GB_UINT16		SectionIndex;
+	GB_INT32		UniIndex;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
-	if (decoder->nGreyBitsCount>=decoder->nCacheItem||!decoder->gbOffsetTable)
+	if (decoder->nGreyBitsCount >= decoder->nCacheItem)
 		return GB_FAILED;
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
-	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
 	if (UniIndex >= UNICODE_SECTION_NUM)
 		return GB_FAILED;
+	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
 	if (!SectionIndex)
 		return GB_FAILED;
+#ifdef ENABLE_LAZYTABLE
+	section = GreyBitFile_Decoder_LoadSection(decoder, UniIndex);
+	if (!section)
+		return GB_FAILED;
+#else
+	if (!decoder->gbOffsetTable)
+		return GB_FAILED;
+#endif //ENABLE_LAZYTABLE
 	decoder->gpGreyBits[decoder->nGreyBitsCount] =(GB_BYTE *)GreyBit_Malloc
 												  (decoder->gbMem, nDataSize);
 	decoder->pnGreySize[decoder->nGreyBitsCount] = (GB_INT16)nDataSize;
 	GB_MEMCPY(decoder->gpGreyBits[decoder->nGreyBitsCount], pData, nDataSize);
 	UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+#ifdef ENABLE_LAZYTABLE
+	section->gbOffset[nCode - nMinCode]=SET_RAM(decoder->nGreyBitsCount++);
+#else
 	SectionIndex--;
 	SectionIndex += (GB_UINT16)nCode - nMinCode;
 	decoder->gbOffsetTable[SectionIndex] = SET_RAM(decoder->nGreyBitsCount++);
+#endif //ENABLE_LAZYTABLE
 	return GB_SUCCESS;
 }
 
@@ -142,6 +254,15 @@ void		GreyBitFile_Decoder_ClearCache(GBF_Decoder decoder)
 		GreyBit_Free(decoder->gbMem, decoder->gbHoriOffTable);
 	if (decoder->gbOffsetTable)
 		GreyBit_Free(decoder->gbMem, decoder->gbOffsetTable);
+	if (decoder->gbLengthTable)
+		GreyBit_Free(decoder->gbMem, decoder->gbLengthTable);
+#ifdef ENABLE_LAZYTABLE
+	for (i = 0; i < UNICODE_SECTION_NUM; ++i)
+	{
+		if (decoder->gbSectionTable[i].gbOffset)
+			GreyBit_Free(decoder->gbMem, decoder->gbSectionTable[i].gbOffset);
+	}
+#endif //ENABLE_LAZYTABLE
 	if (decoder->pnGreySize)
 		GreyBit_Free(decoder->gbMem, decoder->pnGreySize);
 	if (decoder->gpGreyBits)
@@ -157,10 +278,14 @@ void		GreyBitFile_Decoder_ClearCache(GBF_Decoder decoder)
 
 /*
 ** ---------------------------------------------------------------------------
-** Function: GreyBitFile_Decoder_Decompress
-** Description: Decompress character data
-** Input: pOutData - output data
-**        pnInOutLen - output data length
+** Function: GreyBitFile_Decoder_DecompressTo
+** Description: Decompress character data into rows of a larger bitmap.
+**              Grey levels come back with their dropped low bit set, but
+**              background stays 0, as in the spans of DecodeSpans.
+** Input: pOutData - first output row
+**        nOutPitch - output pitch
+**        nRowLen - bytes per character row
+**        nRows - character rows
 **        pInData - input data
 **        nInDataLen - input data length
 ** Output: Decompressed data
@@ -168,69 +293,336 @@ void		GreyBitFile_Decoder_ClearCache(GBF_Decoder decoder)
 ** ---------------------------------------------------------------------------
 */
 
-GB_INT32	 GreyBitFile_Decoder_Decompress(GB_BYTE* pOutData,
-	GB_INT32* pnInOutLen,
-	GB_BYTE* pInData,
-	GB_INT32 nInDataLen)
+GB_INT32	GreyBitFile_Decoder_DecompressTo(GB_BYTE* pOutData,
+											 GB_INT32 nOutPitch,
+											 GB_INT32 nRowLen,
+											 GB_INT32 nRows,
+											 GB_BYTE* pInData,
+											 GB_INT32 nInDataLen)
 {
-	GB_INT32	nDecompressLen;
-	GB_INT32	j;
-	GB_INT32	ja;
+	GB_INT32	nCol;
+	GB_INT32	nRun;
 	GB_INT32	i;
-	GB_INT32	ia;
 	GB_BYTE		nData;
-	GB_BYTE		nDataa;
 	GB_BYTE		nLen;
 
 	nLen = 0;
-	nDecompressLen = 0;
-	if (pOutData)
+	nCol = 0;
+	for (i = 0; i < nInDataLen && nRows > 0; ++i)
 	{
-		for (i = 0; i < nInDataLen; ++i)
+		nData = pInData[i];
+		if (!nLen && IS_LEN(nData))
 		{
-			nData = pInData[i];
-			if (nLen)
+			nLen = GET_LEN(nData);
+			continue;
+		}
+		nRun = nLen ? nLen : 1;
+		nLen = 0;
+		for (; nRun > 0 && nRows > 0; --nRun)
+		{
+			pOutData[nCol] = nData ? (GB_BYTE)((nData << 1) | 1) : 0;
+			if (++nCol == nRowLen)
 			{
-				for (j = 0; j < nLen; ++j)
-					pOutData[nDecompressLen+j] = (nData << 1) | 1;
-				nDecompressLen += nLen;
-				nLen = 0;
+				nCol = 0;
+				pOutData += nOutPitch;
+				nRows--;
 			}
-			else if (IS_LEN(nData))
+		}
+	}
+	if (nLen)
+		return GB_FAILED;
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_DecompressBits
+** Description: Decompress 1 bit character data into rows of a larger bitmap.
+**              Runs are filled and literals copied, XORed with the row above
+**              from the second row on.
+** Input: pOutData - first output row
+**        nOutPitch - output pitch
+**        nRowLen - bytes per character row
+**        nRows - character rows
+**        pInData - input data
+**        nInDataLen - input data length
+** Output: Decompressed data
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_DecompressBits(GB_BYTE* pOutData,
+											   GB_INT32 nOutPitch,
+											   GB_INT32 nRowLen,
+											   GB_INT32 nRows,
+											   GB_BYTE* pInData,
+											   GB_INT32 nInDataLen)
+{
+	GB_INT32	nCol;
+	GB_INT32	nRun;
+	GB_INT32	nPart;
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_BYTE		nCtrl;
+	GB_BYTE *	pPrev;
+	GB_BYTE *	pIn;
+
+	nCol = 0;
+	pPrev = 0;
+	i = 0;
+	while (i < nInDataLen && nRows > 0)
+	{
+		nCtrl = pInData[i++];
+		nRun = GET_LEN(nCtrl);
+		pIn = pInData + i;
+		i += IS_LEN(nCtrl) ? 1 : nRun;
+		if (i > nInDataLen)
+			return GB_FAILED;
+		while (nRun > 0 && nRows > 0)
+		{
+			nPart = nRowLen - nCol;
+			if (nPart > nRun)
+				nPart = nRun;
+			if (IS_LEN(nCtrl) && pPrev)
 			{
-				nLen = GET_LEN(nData);
+				for (j = 0; j < nPart; ++j)
+					pOutData[nCol + j] = *pIn ^ pPrev[nCol + j];
+			}
+			else if (IS_LEN(nCtrl))
+			{
+				GB_MEMSET(pOutData + nCol, *pIn, nPart);
+			}
+			else if (pPrev)
+			{
+				for (j = 0; j < nPart; ++j)
+					pOutData[nCol + j] = pIn[j] ^ pPrev[nCol + j];
+				pIn += nPart;
 			}
 			else
 			{
-				pOutData[nDecompressLen] = (nData << 1) | 1;
-				nDecompressLen++;
+				GB_MEMCPY(pOutData + nCol, pIn, nPart);
+				pIn += nPart;
+			}
+			nCol += nPart;
+			nRun -= nPart;
+			if (nCol == nRowLen)
+			{
+				nCol = 0;
+				pPrev = pOutData;
+				pOutData += nOutPitch;
+				nRows--;
 			}
 		}
 	}
-	else
+	if (nRows > 0)
+		return GB_FAILED;
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_Unpack
+** Description: Unpack stored character data into bitmap rows. Rows outside
+**              the ink of a cropped character are cleared, not unpacked.
+** Input: decoder - decoder
+**        pOutData - first output row
+**        nOutPitch - output pitch
+**        nWidth - character width
+**        bKeep - keep output bits right of the character in its last byte
+**        pInData - stored data
+**        nInDataLen - stored data length
+** Output: pnInkTop - first inked row
+**         pnInkHeight - inked row count
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_Unpack(GBF_Decoder decoder, GB_BYTE* pOutData,
+									   GB_INT32 nOutPitch, GB_INT16 nWidth,
+									   GB_BOOL bKeep, GB_BYTE* pInData,
+									   GB_INT32 nInDataLen, GB_INT16* pnInkTop,
+									   GB_INT16* pnInkHeight)
+{
+	GB_BYTE		nMask;
+	GB_INT16	nTop;
+	GB_INT16	nInk;
+	GB_INT16	nHeight;
+	GB_INT32	nPitch;
+	GB_INT32	nRowLen;
+	GB_INT32	nBits;
+	GB_INT32	i;
+	GB_BYTE *	pOut;
+
+	nHeight = decoder->gbInfoHeader.gbiHeight;
+	nBits = nWidth * decoder->gbInfoHeader.gbiBitCount;
+	nPitch = (nBits * 8 + 63) >> 6;
+	nTop = 0;
+	nInk = nHeight;
+	if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_CROP)
 	{
-		for (ia = 0; ia < nInDataLen; ++ia)
+		if (nInDataLen < GBF_CROP_SIZE)
+			return GB_FAILED;
+		nTop = pInData[0];
+		nInk = pInData[1];
+		pInData += GBF_CROP_SIZE;
+		nInDataLen -= GBF_CROP_SIZE;
+		if (nTop + nInk > nHeight)
+			return GB_FAILED;
+	}
+	nRowLen = bKeep ? (nBits >> 3) : nPitch;
+	nMask = (GB_BYTE)(0xff >> (nBits & 7));
+	for (i = 0; i < nHeight; ++i)
+	{
+		if (i == nTop)
+			i += nInk;
+		if (i >= nHeight)
+			break;
+		pOut = pOutData + i * nOutPitch;
+		GB_MEMSET(pOut, 0, nRowLen);
+		if (bKeep && (nBits & 7))
+			pOut[nRowLen] &= nMask;
+	}
+	*pnInkTop = nTop;
+	*pnInkHeight = nInk;
+	pOut = pOutData + nTop * nOutPitch;
+	if (decoder->gbInfoHeader.gbiCompression == GBF_COMPRESS_BITS)
+		return GreyBitFile_Decoder_DecompressBits(pOut, nOutPitch, nPitch,
+												  nInk, pInData, nInDataLen);
+	if (decoder->gbInfoHeader.gbiCompression)
+		return GreyBitFile_Decoder_DecompressTo(pOut, nOutPitch, nPitch, nInk,
+												pInData, nInDataLen);
+	if (nInDataLen < nPitch * nInk)
+		return GB_FAILED;
+	for (i = 0; i < nInk; ++i)
+	{
+		GB_MEMCPY(pOut, pInData, nRowLen);
+		if (bKeep && (nBits & 7))
+			pOut[nRowLen] = (pOut[nRowLen] & nMask)
+						  | (pInData[nRowLen] & ~nMask);
+		pOut += nOutPitch;
+		pInData += nPitch;
+	}
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_Spans
+** Description: Walk stored 8 bit character data and pass its rows on as
+**              spans. Runs are taken as they are stored, so a blank or solid
+**              run costs one span whatever its length; zero is transparent
+**              and gives no span at all.
+** Input: decoder - decoder
+**        nWidth - character width
+**        pInData - stored data
+**        nInDataLen - stored data length
+**        func - span callback, y is the character row
+**        user - callback data
+** Output: pnInkTop - first inked row
+**         pnInkHeight - inked row count
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_Spans(GBF_Decoder decoder, GB_INT16 nWidth,
+									  GB_BYTE* pInData, GB_INT32 nInDataLen,
+									  GB_SpanFunc func, void* user,
+									  GB_INT16* pnInkTop,
+									  GB_INT16* pnInkHeight)
+{
+	GB_Span		spans[GBF_MAX_SPANS];
+	GB_Span*	span;
+	GB_BOOL		bCompress;
+	GB_INT16	nTop;
+	GB_INT16	nInk;
+	GB_INT32	nCount;
+	GB_INT32	nCol;
+	GB_INT32	nRow;
+	GB_INT32	nRun;
+	GB_INT32	nPart;
+	GB_INT32	i;
+	GB_BYTE		nData;
+	GB_BYTE		nLen;
+	GB_BYTE		nCoverage;
+
+	nTop = 0;
+	nInk = decoder->gbInfoHeader.gbiHeight;
+	if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_CROP)
+	{
+		if (nInDataLen < GBF_CROP_SIZE)
+			return GB_FAILED;
+		nTop = pInData[0];
+		nInk = pInData[1];
+		pInData += GBF_CROP_SIZE;
+		nInDataLen -= GBF_CROP_SIZE;
+		if (nTop + nInk > decoder->gbInfoHeader.gbiHeight)
+			return GB_FAILED;
+	}
+	bCompress = (GB_BOOL)(decoder->gbInfoHeader.gbiCompression != 0);
+	if (!bCompress && nInDataLen < nWidth * nInk)
+		return GB_FAILED;
+	*pnInkTop = nTop;
+	*pnInkHeight = nInk;
+	nCount = 0;
+	nCol = 0;
+	nRow = 0;
+	nLen = 0;
+	for (i = 0; i < nInDataLen && nRow < nInk; ++i)
+	{
+		nData = pInData[i];
+		if (bCompress)
 		{
-			nDataa = pInData[ia];
-			if (nLen)
+			if (!nLen && IS_LEN(nData))
 			{
-				for (ja = 0; ja < nLen; ++ja)
-					++nDecompressLen;
-				nLen = 0;
+				nLen = GET_LEN(nData);
+				continue;
 			}
-			else if (IS_LEN(nDataa))
+			nRun = nLen ? nLen : 1;
+			nLen = 0;
+			nCoverage = nData ? (GB_BYTE)((nData << 1) | 1) : 0;
+		}
+		else
+		{
+			nRun = 1;
+			nCoverage = nData;
+		}
+		while (nRun > 0 && nRow < nInk)
+		{
+			nPart = nWidth - nCol;
+			if (nPart > nRun)
+				nPart = nRun;
+			span = nCount ? &spans[nCount - 1] : 0;
+			if (span && span->coverage == nCoverage
+			 && span->x + span->len == nCol)
 			{
-				nLen = GET_LEN(nDataa);
+				span->len += (unsigned short)nPart;
 			}
-			else
+			else if (nCoverage)
+			{
+				if (nCount == GBF_MAX_SPANS)
+				{
+					func(nTop + nRow, nCount, spans, user);
+					nCount = 0;
+				}
+				spans[nCount].x = (short)nCol;
+				spans[nCount].len = (unsigned short)nPart;
+				spans[nCount].coverage = nCoverage;
+				nCount++;
+			}
+			nCol += nPart;
+			nRun -= nPart;
+			if (nCol == nWidth)
 			{
-				++nDecompressLen;
+				if (nCount)
+					func(nTop + nRow, nCount, spans, user);
+				nCount = 0;
+				nCol = 0;
+				nRow++;
 			}
 		}
 	}
 	if (nLen)
 		return GB_FAILED;
-	*pnInOutLen = nDecompressLen;
 	return GB_SUCCESS;
 }
 
@@ -246,6 +638,8 @@ GB_INT32	 GreyBitFile_Decoder_Decompress(GB_BYTE* pOutData,
 
 GB_INT32	GreyBitFile_Decoder_ReadHeader(GBF_Decoder decoder)
 {
+	GB_UINT32	nExSize;
+
 	GreyBit_Stream_Seek(decoder->gbStream, 0);
 	if (GreyBit_Stream_Read(decoder->gbStream,
 							(GB_BYTE*)&decoder->gbFileHeader,
@@ -254,6 +648,17 @@ GB_INT32	GreyBitFile_Decoder_ReadHeader(GBF_Decoder decoder)
 		return GB_FAILED;
 	GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE*)&decoder->gbInfoHeader,
 						sizeof(GREYBITINFOHEADER));
+	GB_MEMSET(&decoder->gbInfoHeaderEx, 0, sizeof(GREYBITINFOHEADEREX));
+	if (decoder->gbInfoHeader.gbiSize > sizeof(GREYBITINFOHEADER))
+	{
+		nExSize = decoder->gbInfoHeader.gbiSize - sizeof(GREYBITINFOHEADER);
+		if (nExSize > sizeof(GREYBITINFOHEADEREX))
+			nExSize = sizeof(GREYBITINFOHEADEREX);
+		GreyBit_Stream_Read(decoder->gbStream,
+							(GB_BYTE*)&decoder->gbInfoHeaderEx, nExSize);
+		decoder->gbOffDataBits = sizeof(GREYBITFILEHEADER)
+							   + decoder->gbInfoHeader.gbiSize;
+	}
 	decoder->nItemCount = decoder->gbInfoHeader.gbiCount;
 	GreyBitFile_Decoder_InfoInit(decoder, decoder->gbInfoHeader.gbiWidth,
 								 decoder->gbInfoHeader.gbiHeight,
@@ -275,10 +680,13 @@ GB_INT32	GreyBitFile_Decoder_ReadHeader(GBF_Decoder decoder)
 GB_UINT32	GreyBitFile_Decoder_GetDataOffset(GBF_Decoder decoder,
 											  GB_UINT32 nCode)
 {
-	GB_UINT32	nOffset;
-	GB_UINT16	nMinCode;
-	GB_UINT16	SectionIndex;
-	GB_INT32	UniIndex;
+	GB_UINT32		nOffset;
+	GB_UINT16		nMinCode;
+	GB_UINT16		SectionIndex;
+	GB_INT32		UniIndex;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
 	if (UniIndex >= UNICODE_SECTION_NUM)
@@ -292,6 +700,13 @@ GB_UINT32	GreyBitFile_Decoder_GetDataOffset(GBF_Decoder decoder,
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
 		return decoder->gbOffsetTable[nCode - nMinCode + SectionIndex];
 	}
+#ifdef ENABLE_LAZYTABLE
+	else if ((section = GreyBitFile_Decoder_LoadSection(decoder, UniIndex))!=0)
+	{
+		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+		return section->gbOffset[nCode - nMinCode];
+	}
+#endif //ENABLE_LAZYTABLE
 	else
 	{
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
@@ -305,6 +720,54 @@ GB_UINT32	GreyBitFile_Decoder_GetDataOffset(GBF_Decoder decoder,
 	}
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_GetDataLength
+** Description: Get code data length from the length table
+** Input: decoder - decoder
+**        nCode - code
+** Output: data length
+** Return value: nLength/0 if font has no length table
+** ---------------------------------------------------------------------------
+*/
+
+GB_UINT16	GreyBitFile_Decoder_GetDataLength(GBF_Decoder decoder,
+											  GB_UINT32 nCode)
+{
+	GB_UINT16		nLength;
+	GB_UINT16		nMinCode;
+	GB_UINT16		SectionIndex;
+	GB_INT32		UniIndex;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
+
+	if (!(decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_LENGTHTAB))
+		return 0;
+	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
+	if (UniIndex >= UNICODE_SECTION_NUM)
+		return 0;
+	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
+	if (!SectionIndex)
+		return 0;
+	SectionIndex--;
+	UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+	if (decoder->gbLengthTable)
+		return decoder->gbLengthTable[nCode - nMinCode + SectionIndex];
+#ifdef ENABLE_LAZYTABLE
+	if ((section = GreyBitFile_Decoder_LoadSection(decoder, UniIndex)) != 0)
+		return section->gbLength[nCode - nMinCode];
+#endif //ENABLE_LAZYTABLE
+	SectionIndex += (GB_UINT16)nCode - nMinCode;
+	GreyBit_Stream_Seek(decoder->gbStream,
+						decoder->gbInfoHeaderEx.gbiLengthTabOff
+					  + decoder->gbOffDataBits + sizeof(GB_UINT16)
+					  * SectionIndex);
+	GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE *)&nLength,
+						sizeof(GB_UINT16));
+	return nLength;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitFile_Decoder_Init
@@ -317,14 +780,25 @@ GB_UINT32	GreyBitFile_Decoder_GetDataOffset(GBF_Decoder decoder,
 
 GB_INT32	GreyBitFile_Decoder_Init(GBF_Decoder decoder)
 {
+#ifndef ENABLE_LAZYTABLE
 	GB_INT32	nDataSize;
 	GB_INT32	nDataSizea;
 	GB_INT32	nDataSizeb;
+	GB_INT32	nDataSizec;
+#endif //ENABLE_LAZYTABLE
 	GB_INT32	nRet;
 
+	decoder->gbWidthTable = 0;
+	decoder->gbHoriOffTable = 0;
+	decoder->gbOffsetTable = 0;
+	decoder->gbLengthTable = 0;
+#ifdef ENABLE_LAZYTABLE
+	GB_MEMSET(decoder->gbSectionTable, 0, sizeof(decoder->gbSectionTable));
+#endif //ENABLE_LAZYTABLE
 	nRet = GreyBitFile_Decoder_ReadHeader(decoder);
 	if (nRet < 0)
 		return nRet;
+#ifndef ENABLE_LAZYTABLE
 	nDataSize = decoder->gbInfoHeader.gbiHoriOffTabOff
 			  - decoder->gbInfoHeader.gbiWidthTabOff;
 	decoder->gbWidthTable=(GB_BYTE *)GreyBit_Malloc(decoder->gbMem,nDataSize);
@@ -341,6 +815,20 @@ GB_INT32	GreyBitFile_Decoder_Init(GBF_Decoder decoder)
 	GreyBit_Stream_Read(decoder->gbStream,decoder->gbHoriOffTable,nDataSizea);
 	nDataSizeb = decoder->gbInfoHeader.gbiOffGreyBits
 			   - decoder->gbInfoHeader.gbiOffsetTabOff;
+	if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_LENGTHTAB)
+	{
+		nDataSizeb = decoder->gbInfoHeaderEx.gbiLengthTabOff
+				   - decoder->gbInfoHeader.gbiOffsetTabOff;
+		nDataSizec = decoder->gbInfoHeader.gbiOffGreyBits
+				   - decoder->gbInfoHeaderEx.gbiLengthTabOff;
+		decoder->gbLengthTable = (GB_UINT16 *)GreyBit_Malloc(decoder->gbMem,
+															 nDataSizec);
+		GreyBit_Stream_Seek(decoder->gbStream,
+							decoder->gbInfoHeaderEx.gbiLengthTabOff
+						  + decoder->gbOffDataBits);
+		GreyBit_Stream_Read(decoder->gbStream,
+							(GB_BYTE *)decoder->gbLengthTable, nDataSizec);
+	}
 	decoder->gbOffsetTable = (GB_UINT32 *)GreyBit_Malloc(decoder->gbMem,
 														 nDataSizeb);
 	GreyBit_Stream_Seek(decoder->gbStream,
@@ -348,6 +836,41 @@ GB_INT32	GreyBitFile_Decoder_Init(GBF_Decoder decoder)
 					  + decoder->gbOffDataBits);
 	GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE *)decoder->gbOffsetTable,
 						nDataSizeb);
+#endif //ENABLE_LAZYTABLE
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_LoadTables
+** Description: Load every table the font will need, so that the tables are
+**              not written any more once contexts read them
+** Input: decoder - decoder
+** Output: Loaded tables
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_LoadTables(GBF_Decoder decoder)
+{
+#ifdef ENABLE_LAZYTABLE
+	GB_INT32	UniIndex;
+
+	for (UniIndex = 0; UniIndex < UNICODE_SECTION_NUM; ++UniIndex)
+	{
+		if (decoder->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex]
+		 && decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex]
+		 && !GreyBitFile_Decoder_LoadSection(decoder, UniIndex))
+			return GB_FAILED;
+	}
+#else
+	if (!decoder->gbWidthTable || !decoder->gbHoriOffTable
+	 || !decoder->gbOffsetTable)
+		return GB_FAILED;
+	if ((decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_LENGTHTAB)
+	 && !decoder->gbLengthTable)
+		return GB_FAILED;
+#endif //ENABLE_LAZYTABLE
 	return GB_SUCCESS;
 }
 
@@ -372,7 +895,8 @@ GB_Decoder	GreyBitFile_Decoder_New(GB_Loader loader, GB_Stream stream)
 {
 	GBF_Decoder	decoder;
 
-	decoder = (GBF_Decoder)GreyBit_Malloc(loader->gbMem,sizeof(GBF_Decoder));
+	decoder = (GBF_Decoder)GreyBit_Malloc(loader->gbMem,
+										  sizeof(GBF_DecoderRec));
 	if (decoder)
 	{
 		decoder->gbDecoder.setparam = GreyBitFile_Decoder_SetParam;
@@ -381,12 +905,22 @@ GB_Decoder	GreyBitFile_Decoder_New(GB_Loader loader, GB_Stream stream)
 		decoder->gbDecoder.getheight = GreyBitFile_Decoder_GetHeight;
 		decoder->gbDecoder.getadvance = GreyBitFile_Decoder_GetAdvance;
 		decoder->gbDecoder.decode = GreyBitFile_Decoder_Decode;
+		decoder->gbDecoder.decodeto = GreyBitFile_Decoder_DecodeTo;
+		decoder->gbDecoder.decodespans = GreyBitFile_Decoder_DecodeSpans;
+		decoder->gbDecoder.decodepacked = 0;
+		decoder->gbDecoder.decodebatch = GreyBitFile_Decoder_DecodeBatch;
+		decoder->gbDecoder.preload = GreyBitFile_Decoder_Preload;
+		decoder->gbDecoder.newcontext = GreyBitFile_Decoder_NewContext;
 		decoder->gbDecoder.done = GreyBitFile_Decoder_Done;
+		decoder->gbFont = 0;
+		decoder->bShared = GB_FALSE;
 		decoder->gbLibrary = loader->gbLibrary;
 		decoder->gbMem = loader->gbMem;
 		decoder->gbStream = stream;
 		decoder->nCacheItem = 0;
 		decoder->nItemCount = 0;
+		decoder->gpGreyBits = 0;
+		decoder->pnGreySize = 0;
 		decoder->gbOffDataBits = sizeof(GREYBITFILEHEADER)
 			+ sizeof(GREYBITINFOHEADER);
 		GreyBitFile_Decoder_Init(decoder);
@@ -409,23 +943,37 @@ GB_Decoder	GreyBitFile_Decoder_New(GB_Loader loader, GB_Stream stream)
 GB_INT32	GreyBitFile_Decoder_SetParam(GB_Decoder decoder, GB_Param nParam,
 										 GB_UINT32 dwParam)
 {
-	GBF_Decoder	me = (GBF_Decoder)decoder;
+	GB_INT32	nRet;
+	GBF_Decoder	me = GBF_FONT((GBF_Decoder)decoder);
 
+	nRet = GB_SUCCESS;
+	GreyBit_Stream_Lock(me->gbStream);
 	if (dwParam)
 	{
 		if (nParam == GB_PARAM_CACHEITEM)
 		{
 			if (me->gpGreyBits)
-				return GB_FAILED;
-			me->nCacheItem = dwParam;
-			me->gpGreyBits = (GB_BYTE**)GreyBit_Malloc(me->gbMem,
-				4 * me->nCacheItem);
-			me->pnGreySize = (GB_UINT16*)GreyBit_Malloc(me->gbMem,
-				2 * me->nCacheItem);
-			me->nGreyBitsCount = 0;
+			{
+				nRet = GB_FAILED;
+			}
+			else
+			{
+				me->nCacheItem = dwParam;
+				me->gpGreyBits = (GB_BYTE**)GreyBit_Malloc(me->gbMem,
+					sizeof(GB_BYTE*) * me->nCacheItem);
+				me->pnGreySize = (GB_UINT16*)GreyBit_Malloc(me->gbMem,
+					sizeof(GB_UINT16) * me->nCacheItem);
+				if (me->gpGreyBits)
+					GB_MEMSET(me->gpGreyBits, 0,
+							  sizeof(GB_BYTE*) * me->nCacheItem);
+				if (!me->gpGreyBits || !me->pnGreySize)
+					nRet = GB_FAILED;
+				me->nGreyBitsCount = 0;
+			}
 		}
 	}
-	return GB_SUCCESS;
+	GreyBit_Stream_Unlock(me->gbStream);
+	return nRet;
 }
 
 /*
@@ -479,17 +1027,20 @@ GB_INT32	GreyBitFile_Decoder_GetHeight(GB_Decoder decoder)
 GB_INT32	GreyBitFile_Decoder_GetWidth(GB_Decoder decoder, GB_UINT32 nCode,
 										 GB_INT16 nSize)
 {
-	GB_BYTE		nWidth;
-	GB_UINT16	nMinCode;
-	GB_INT32	UniIndex;
-	GB_INT32	WidthIdx;
-	GBF_Decoder	me;
+	GB_BYTE			nWidth;
+	GB_UINT16		nMinCode;
+	GB_INT32		UniIndex;
+	GB_INT32		WidthIdx;
+	GBF_Decoder		me;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
 	me = (GBF_Decoder)decoder;
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
-	WidthIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (UniIndex >= UNICODE_SECTION_NUM)
 		return 0;
+	WidthIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (!WidthIdx)
 		return 0;
 	WidthIdx--;
@@ -498,6 +1049,13 @@ GB_INT32	GreyBitFile_Decoder_GetWidth(GB_Decoder decoder, GB_UINT32 nCode,
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
 		nWidth = me->gbWidthTable[nCode - nMinCode + WidthIdx];
 	}
+#ifdef ENABLE_LAZYTABLE
+	else if ((section = GreyBitFile_Decoder_LoadSection(me, UniIndex)) != 0)
+	{
+		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+		nWidth = section->gbWidth[nCode - nMinCode];
+	}
+#endif //ENABLE_LAZYTABLE
 	else
 	{
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
@@ -512,17 +1070,20 @@ GB_INT16	GreyBitFile_Decoder_GetHoriOff(GB_Decoder decoder,
 										   GB_UINT32 nCode,
 										   GB_INT16 nSize)
 {
-	GB_INT8		nHoriOff;
-	GB_UINT16	nMinCode;
-	GB_INT32	UniIndex;
-	GB_INT32	HoriOffIdx;
-	GBF_Decoder	me;
+	GB_INT8			nHoriOff;
+	GB_UINT16		nMinCode;
+	GB_INT32		UniIndex;
+	GB_INT32		HoriOffIdx;
+	GBF_Decoder		me;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
 	me = (GBF_Decoder)decoder;
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
-	HoriOffIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (UniIndex >= UNICODE_SECTION_NUM)
 		return 0;
+	HoriOffIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (!HoriOffIdx)
 		return 0;
 	HoriOffIdx--;
@@ -531,6 +1092,13 @@ GB_INT16	GreyBitFile_Decoder_GetHoriOff(GB_Decoder decoder,
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
 		nHoriOff = me->gbHoriOffTable[nCode - nMinCode + HoriOffIdx];
 	}
+#ifdef ENABLE_LAZYTABLE
+	else if ((section = GreyBitFile_Decoder_LoadSection(me, UniIndex)) != 0)
+	{
+		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+		nHoriOff = section->gbHoriOff[nCode - nMinCode];
+	}
+#endif //ENABLE_LAZYTABLE
 	else
 	{
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
@@ -568,6 +1136,167 @@ GB_INT16	GreyBitFile_Decoder_GetAdvance(GB_Decoder decoder, GB_UINT32 nCode,
 		return nAdvance;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_GetEntry
+** Description: Get table entries of a code whose section is already known
+** Input: decoder - decoder
+**        UniIndex - unicode section index
+**        nMinCode - first code of the section
+**        nCode - code
+** Output: pnWidth - width at font height
+**         pnHoriOff - horioff at font height
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_GetEntry(GBF_Decoder decoder, GB_INT32 UniIndex,
+										 GB_UINT16 nMinCode, GB_UINT32 nCode,
+										 GB_BYTE* pnWidth, GB_INT8* pnHoriOff)
+{
+	GB_INT32		WidthIdx;
+	GB_INT32		SectionIndex;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
+
+	WidthIdx = decoder->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
+	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
+	if (!WidthIdx || !SectionIndex)
+		return GB_FAILED;
+	if (decoder->gbWidthTable && decoder->gbHoriOffTable)
+	{
+		*pnWidth = decoder->gbWidthTable[nCode - nMinCode + WidthIdx - 1];
+		*pnHoriOff = decoder->gbHoriOffTable[nCode - nMinCode + WidthIdx - 1];
+		return GB_SUCCESS;
+	}
+#ifdef ENABLE_LAZYTABLE
+	section = GreyBitFile_Decoder_LoadSection(decoder, UniIndex);
+	if (section)
+	{
+		*pnWidth = section->gbWidth[nCode - nMinCode];
+		*pnHoriOff = section->gbHoriOff[nCode - nMinCode];
+		return GB_SUCCESS;
+	}
+#endif //ENABLE_LAZYTABLE
+	*pnWidth = (GB_BYTE)GreyBitFile_Decoder_GetWidth((GB_Decoder)decoder,
+						nCode, decoder->gbInfoHeader.gbiHeight);
+	*pnHoriOff = (GB_INT8)GreyBitFile_Decoder_GetHoriOff((GB_Decoder)decoder,
+						nCode, decoder->gbInfoHeader.gbiHeight);
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_ReadRecord
+** Description: Get the stored data of a character from cache or stream. The
+**              seek is skipped when the stream already stands at the record,
+**              and with a length table the record is a single read. The
+**              cache is the one of the font, the buffer the decoder's own.
+** Input: decoder - decoder
+**        nCode - code
+**        Offset - data offset
+**        nDataLen - unpacked data length at full height
+**        pnInDataLen - stored data length from the length table, if any
+**        pnStreamPos - data offset the stream stands at (RAM_MASK if not
+**                      known), moved past the record that was read
+** Output: pnInDataLen - stored data length
+** Return value: stored data/0 if unreadable
+** ---------------------------------------------------------------------------
+*/
+
+GB_BYTE*	GreyBitFile_Decoder_ReadRecord(GBF_Decoder decoder,
+										   GB_UINT32 nCode, GB_UINT32 Offset,
+										   GB_INT32 nDataLen,
+										   GB_INT32* pnInDataLen,
+										   GB_UINT32* pnStreamPos)
+{
+	GB_UINT16	Lenght;
+	GB_INT32	nHead;
+	GBF_Decoder	font = GBF_FONT(decoder);
+
+	if (IS_INRAM(Offset))
+	{
+		Offset = GET_INDEX(Offset);
+		*pnInDataLen = font->pnGreySize[Offset];
+		return font->gpGreyBits[Offset];
+	}
+	if (Offset != *pnStreamPos)
+		GreyBit_Stream_Seek(decoder->gbStream,
+							decoder->gbInfoHeader.gbiOffGreyBits
+						  + decoder->gbOffDataBits + Offset);
+	if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_LENGTHTAB)
+	{
+		nHead = 0;
+	}
+	else if (decoder->gbInfoHeader.gbiCompression)
+	{
+		GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE*)&Lenght,
+							sizeof(GB_UINT16));
+		Offset += sizeof(GB_UINT16);
+		*pnInDataLen = Lenght;
+		nHead = 0;
+	}
+	else if (decoder->gbInfoHeaderEx.gbiFlags & GBF_FLAG_CROP)
+	{
+		nHead = GBF_CROP_SIZE;
+		GreyBit_Stream_Read(decoder->gbStream, decoder->pBuff, nHead);
+		*pnInDataLen = nHead + nDataLen / decoder->gbInfoHeader.gbiHeight
+					 * decoder->pBuff[1];
+	}
+	else
+	{
+		*pnInDataLen = nDataLen;
+		nHead = 0;
+	}
+	if (*pnInDataLen > decoder->nBuffSize)
+	{
+		*pnStreamPos = RAM_MASK;
+		return 0;
+	}
+	GreyBit_Stream_Read(decoder->gbStream, decoder->pBuff + nHead,
+						*pnInDataLen - nHead);
+	*pnStreamPos = Offset + *pnInDataLen;
+	GreyBitFile_Decoder_CaheItem(font, nCode, decoder->pBuff, *pnInDataLen);
+	return decoder->pBuff;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_ReadData
+** Description: Read a record under the stream lock. The offset and length
+**              are looked up under the lock too, since another thread may
+**              cache the character meanwhile, and a shared font always
+**              seeks as another thread may have moved the stream.
+** Input: decoder - decoder
+**        nCode - code
+**        nDataLen - unpacked data length at full height
+**        pnStreamPos - data offset the stream stands at (RAM_MASK if not
+**                      known), moved past the record that was read
+** Output: pnInDataLen - stored data length
+** Return value: stored data/0 if unreadable
+** ---------------------------------------------------------------------------
+*/
+
+GB_BYTE*	GreyBitFile_Decoder_ReadData(GBF_Decoder decoder, GB_UINT32 nCode,
+										 GB_INT32 nDataLen,
+										 GB_INT32* pnInDataLen,
+										 GB_UINT32* pnStreamPos)
+{
+	GB_UINT32	Offset;
+	GB_BYTE*	pData;
+
+	GreyBit_Stream_Lock(decoder->gbStream);
+	if (GBF_FONT(decoder)->bShared)
+		*pnStreamPos = RAM_MASK;
+	Offset = GreyBitFile_Decoder_GetDataOffset(decoder, nCode);
+	*pnInDataLen = GreyBitFile_Decoder_GetDataLength(decoder, nCode);
+	pData = GreyBitFile_Decoder_ReadRecord(decoder, nCode, Offset, nDataLen,
+										   pnInDataLen, pnStreamPos);
+	GreyBit_Stream_Unlock(decoder->gbStream);
+	return pData;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitFile_Decoder_Decode
@@ -584,16 +1313,16 @@ GB_INT16	GreyBitFile_Decoder_GetAdvance(GB_Decoder decoder, GB_UINT32 nCode,
 GB_INT32	GreyBitFile_Decoder_Decode(GB_Decoder decoder, GB_UINT32 nCode,
 									   GB_Data pData, GB_INT16 nSize)
 {
-	GB_UINT16	Lenght;
 	GB_INT16	nHoriOff;
 	GB_INT16	nWidth; 
+	GB_INT16	nInkTop;
+	GB_INT16	nInkHeight;
 	GB_INT32	nInDataLen; 
 	GB_INT32	nDataLen;
 	GB_BYTE *	pByteData; 
-	GB_UINT32	Offset;
+	GB_UINT32	nStreamPos;
 	GBF_Decoder	me = (GBF_Decoder)decoder;
 
-	Offset = GreyBitFile_Decoder_GetDataOffset(me, nCode);
 	nWidth=(GB_INT16)GreyBitFile_Decoder_GetWidth(decoder, nCode,
 												  me->gbInfoHeader.gbiHeight);
 	nHoriOff = GreyBitFile_Decoder_GetHoriOff(decoder, nCode, nSize);
@@ -604,48 +1333,468 @@ GB_INT32	GreyBitFile_Decoder_Decode(GB_Decoder decoder, GB_UINT32 nCode,
 						+ 63) >> 6;
 	me->gbBitmap->horioff = nHoriOff;
 	nDataLen = me->gbBitmap->pitch * me->gbBitmap->height;
-	if (!IS_INRAM(Offset))
+	nStreamPos = RAM_MASK;
+	pByteData = GreyBitFile_Decoder_ReadData(me, nCode, nDataLen, &nInDataLen,
+											 &nStreamPos);
+	if (!pByteData)
+		return GB_SUCCESS;
+	GreyBitFile_Decoder_Unpack(me, me->gbBitmap->buffer, me->gbBitmap->pitch,
+							   nWidth, 0, pByteData, nInDataLen, &nInkTop,
+							   &nInkHeight);
+	if (pData)
 	{
-		GreyBit_Stream_Seek(me->gbStream, me->gbInfoHeader.gbiOffGreyBits
-						 + me->gbOffDataBits + Offset);
-		if (me->gbInfoHeader.gbiCompression
-		 && me->gbInfoHeader.gbiBitCount == 8)
-		{
-			GreyBit_Stream_Read(me->gbStream, (GB_BYTE*)&Lenght,
-								sizeof(GB_UINT16));
-			nInDataLen = Lenght;
-		}
-		else
-		{
-			nInDataLen = nDataLen;
-		}
-		GreyBit_Stream_Read(me->gbStream, me->pBuff, nInDataLen);
-		pByteData = me->pBuff;
-		GreyBitFile_Decoder_CaheItem(me, nCode, pByteData, nInDataLen);
+		pData->format = GB_FORMAT_BITMAP;
+		pData->data = me->gbBitmap;
+		pData->width = (GB_INT16)nWidth;
+		pData->horioff = nHoriOff;
+		pData->inktop = nInkTop;
+		pData->inkheight = nInkHeight;
+		pData->inkleft = 0;
+		pData->inkwidth = pData->width;
 	}
-	else
+	return GB_SUCCESS;
+}
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_DecodeTo
+** Description: Decode a character straight into a caller bitmap. Only done
+**              at the font height and bit count, with the character fully
+**              inside pDst and starting on a byte; fails otherwise so the
+**              caller can take the scaling path.
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer, may be 0
+**		  pDst - destination bitmap
+**		  x - left of the character in pDst
+**		  y - top of the character in pDst
+**		  nSize - character size
+** Output: Decoded character in pDst
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_DecodeTo(GB_Decoder decoder, GB_UINT32 nCode,
+										 GB_Data pData, GB_Bitmap pDst,
+										 GB_INT16 x, GB_INT16 y,
+										 GB_INT16 nSize)
+{
+	GB_INT16	nHoriOff;
+	GB_INT16	nWidth;
+	GB_INT16	nPitch;
+	GB_INT16	nInkTop;
+	GB_INT16	nInkHeight;
+	GB_INT32	nInDataLen;
+	GB_BYTE *	pByteData;
+	GB_BYTE *	pOut;
+	GB_UINT32	nStreamPos;
+	GBF_Decoder	me = (GBF_Decoder)decoder;
+
+	if (nSize != me->gbInfoHeader.gbiHeight
+	 || pDst->bitcount != me->gbInfoHeader.gbiBitCount)
+		return GB_FAILED;
+	if (me->gbInfoHeader.gbiCompression && pDst->bitcount != 8)
+		return GB_FAILED;
+	if (x < 0 || y < 0 || y + nSize > pDst->height
+	 || ((x * pDst->bitcount) & 7))
+		return GB_FAILED;
+	nWidth = (GB_INT16)GreyBitFile_Decoder_GetWidth(decoder, nCode, nSize);
+	if (!nWidth || x + nWidth > pDst->width)
+		return GB_FAILED;
+	nHoriOff = GreyBitFile_Decoder_GetHoriOff(decoder, nCode, nSize);
+	nPitch = (GB_INT16)(pDst->bitcount * 8 * nWidth + 63) >> 6;
+	nStreamPos = RAM_MASK;
+	pByteData = GreyBitFile_Decoder_ReadData(me, nCode, nPitch * nSize,
+											 &nInDataLen, &nStreamPos);
+	if (!pByteData)
+		return GB_FAILED;
+	pOut = pDst->buffer + y * pDst->pitch + ((x * pDst->bitcount) >> 3);
+	if (GreyBitFile_Decoder_Unpack(me, pOut, pDst->pitch, nWidth, 1,
+								   pByteData, nInDataLen, &nInkTop,
+								   &nInkHeight) != GB_SUCCESS)
+		return GB_FAILED;
+	if (pData)
 	{
-		GET_INDEX(Offset);
-		pByteData = me->gpGreyBits[Offset];
-		nInDataLen = me->pnGreySize[Offset];
+		pData->format = GB_FORMAT_BITMAP;
+		pData->data = pDst;
+		pData->width = nWidth;
+		pData->horioff = nHoriOff;
+		pData->inktop = nInkTop;
+		pData->inkheight = nInkHeight;
+		pData->inkleft = 0;
+		pData->inkwidth = pData->width;
 	}
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_DecodeSpans
+** Description: Decode a character as coverage spans straight from its stored
+**              runs, never filling a bitmap. Only done at the font height for
+**              8 bit fonts; fails otherwise so the caller can decode.
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer, may be 0; data is left 0
+**		  func - span callback, y is the character row
+**		  user - callback data
+**		  nSize - character size
+** Output: Spans passed to func
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_DecodeSpans(GB_Decoder decoder, GB_UINT32 nCode,
+											GB_Data pData, GB_SpanFunc func,
+											void* user, GB_INT16 nSize)
+{
+	GB_INT16	nHoriOff;
+	GB_INT16	nWidth;
+	GB_INT16	nInkTop;
+	GB_INT16	nInkHeight;
+	GB_INT32	nInDataLen;
+	GB_BYTE *	pByteData;
+	GB_UINT32	nStreamPos;
+	GBF_Decoder	me = (GBF_Decoder)decoder;
+
+	if (nSize != me->gbInfoHeader.gbiHeight
+	 || me->gbInfoHeader.gbiBitCount != 8)
+		return GB_FAILED;
+	nWidth = (GB_INT16)GreyBitFile_Decoder_GetWidth(decoder, nCode, nSize);
+	if (!nWidth)
+		return GB_FAILED;
+	nHoriOff = GreyBitFile_Decoder_GetHoriOff(decoder, nCode, nSize);
+	nStreamPos = RAM_MASK;
+	pByteData = GreyBitFile_Decoder_ReadData(me, nCode, nWidth * nSize,
+											 &nInDataLen, &nStreamPos);
 	if (!pByteData)
-		return GB_SUCCESS;
-	if (me->gbInfoHeader.gbiCompression)
-		GreyBitFile_Decoder_Decompress(me->gbBitmap->buffer, &nDataLen,
-									   pByteData, nInDataLen);
-	else
-		GB_MEMCPY(me->gbBitmap->buffer, pByteData, nDataLen);
+		return GB_FAILED;
+	if (GreyBitFile_Decoder_Spans(me, nWidth, pByteData, nInDataLen, func,
+								  user, &nInkTop, &nInkHeight) != GB_SUCCESS)
+		return GB_FAILED;
 	if (pData)
 	{
 		pData->format = GB_FORMAT_BITMAP;
-		pData->data = me->gbBitmap;
-		pData->width = (GB_INT16)nWidth;
+		pData->data = 0;
+		pData->width = nWidth;
 		pData->horioff = nHoriOff;
+		pData->inktop = nInkTop;
+		pData->inkheight = nInkHeight;
+		pData->inkleft = 0;
+		pData->inkwidth = pData->width;
 	}
 	return GB_SUCCESS;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_DecodeBatch
+** Description: Decode a run of characters into caller bitmaps. Table entries
+**              are looked up first, reusing the section of the previous code,
+**              then the data is read in one pass so that glyphs stored back
+**              to back need no seek. A code met again in the batch is copied
+**              from its first bitmap, never read twice.
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+**	      pData - data array, pData[i].data is a caller GB_Bitmap whose
+**		          pitch * height on entry is the room available
+**		  nSize - character size
+** Output: Decoded characters, width 0 for characters not decoded
+** Return value: number of characters decoded
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_DecodeBatch(GB_Decoder decoder,
+											const GB_UINT32* pCodes,
+											GB_INT32 nCount, GB_Data pData,
+											GB_INT16 nSize)
+{
+	GB_BYTE		nWidth;
+	GB_INT8		nHoriOff;
+	GB_UINT16	nMinCode;
+	GB_UINT16	nMaxCode;
+	GB_INT16	nPitch;
+	GB_INT32	UniIndex;
+	GB_INT32	nInDataLen;
+	GB_INT32	nDataLen;
+	GB_INT32	nDecoded;
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_UINT32	nStreamPos;
+	GB_BYTE*	pByteData;
+	GB_Bitmap	bitmap;
+	GBF_Decoder	me = (GBF_Decoder)decoder;
+
+	UniIndex = UNICODE_SECTION_NUM;
+	nMinCode = 0;
+	nMaxCode = 0;
+	for (i = 0; i < nCount; ++i)
+	{
+		pData[i].format = GB_FORMAT_BITMAP;
+		pData[i].width = 0;
+		pData[i].horioff = 0;
+		pData[i].inktop = 0;
+		pData[i].inkheight = 0;
+		if (UniIndex >= UNICODE_SECTION_NUM
+		 || pCodes[i] < nMinCode || pCodes[i] > nMaxCode)
+		{
+			UniIndex = UnicodeSection_GetIndex((GB_UINT16)pCodes[i]);
+			if (UniIndex >= UNICODE_SECTION_NUM)
+				continue;
+			UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, &nMaxCode);
+		}
+		if (GreyBitFile_Decoder_GetEntry(me, UniIndex, nMinCode, pCodes[i],
+										 &nWidth, &nHoriOff) != GB_SUCCESS)
+			continue;
+		pData[i].width = nWidth;
+		pData[i].horioff = (GB_INT16)(nSize * nHoriOff
+						 / me->gbInfoHeader.gbiHeight);
+	}
+	nStreamPos = RAM_MASK;
+	nDecoded = 0;
+	for (i = 0; i < nCount; ++i)
+	{
+		bitmap = (GB_Bitmap)pData[i].data;
+		if (!pData[i].width || !bitmap)
+			continue;
+		nPitch = (GB_INT16)(me->gbInfoHeader.gbiBitCount * 8 * pData[i].width
+			   + 63) >> 6;
+		nDataLen = nPitch * me->gbInfoHeader.gbiHeight;
+		if (nDataLen > bitmap->pitch * bitmap->height)
+		{
+			pData[i].width = 0;
+			continue;
+		}
+		for (j = i - 1; j >= 0; --j)
+		{
+			if (pCodes[j] == pCodes[i] && pData[j].width && pData[j].data)
+				break;
+		}
+		bitmap->width = pData[i].width;
+		bitmap->height = me->gbInfoHeader.gbiHeight;
+		bitmap->pitch = nPitch;
+		bitmap->bitcount = me->gbInfoHeader.gbiBitCount;
+		bitmap->horioff = pData[i].horioff;
+		if (j >= 0)
+		{
+			GB_MEMCPY(bitmap->buffer, ((GB_Bitmap)pData[j].data)->buffer,
+					  nDataLen);
+			pData[i].inktop = pData[j].inktop;
+			pData[i].inkheight = pData[j].inkheight;
+			pData[i].inkleft = 0;
+			pData[i].inkwidth = pData[i].width;
+			nDecoded++;
+			continue;
+		}
+		pByteData = GreyBitFile_Decoder_ReadData(me, pCodes[i], nDataLen,
+												 &nInDataLen, &nStreamPos);
+		if (!pByteData)
+		{
+			pData[i].width = 0;
+			continue;
+		}
+		GreyBitFile_Decoder_Unpack(me, bitmap->buffer, nPitch, pData[i].width,
+								   0, pByteData, nInDataLen, &pData[i].inktop,
+								   &pData[i].inkheight);
+		pData[i].inkleft = 0;
+		pData[i].inkwidth = pData[i].width;
+		nDecoded++;
+	}
+	return nDecoded;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_Preload
+** Description: Read a set of characters into the cache. Offsets are resolved
+**              and sorted first, so neighbouring glyphs share one read, which
+**              ends at the last glyph when the font has a length table.
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+** Output: Cached characters
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Decoder_Preload(GB_Decoder decoder,
+										const GB_UINT32* pCodes,
+										GB_INT32 nCount)
+{
+	GB_UINT16		Lenght;
+	GB_INT16		nWidth;
+	GB_INT32		nItem;
+	GB_INT32		nFirst;
+	GB_INT32		nLast;
+	GB_INT32		nRecSize;
+	GB_INT32		nWindow;
+	GB_INT32		nRead;
+	GB_INT32		nPos;
+	GB_INT32		nRows;
+	GB_INT32		nHead;
+	GB_INT32		nInDataLen;
+	GB_INT32		nRet;
+	GB_INT32		i;
+	GB_BOOL			bLength;
+	GB_BOOL			bTable;
+	GB_BYTE*		pWindow;
+	PRELOADITEM*	pItems;
+	GBF_Decoder		me = (GBF_Decoder)decoder;
+	GBF_Decoder		font = GBF_FONT(me);
+
+	if (!font->gpGreyBits || nCount <= 0)
+		return GB_FAILED;
+	pItems = (PRELOADITEM*)GreyBit_Malloc(me->gbMem,
+										  sizeof(PRELOADITEM) * nCount);
+	if (!pItems)
+		return GB_FAILED;
+	GreyBit_Stream_Lock(me->gbStream);
+	nItem = 0;
+	for (i = 0; i < nCount; ++i)
+	{
+		if (!GreyBitFile_Decoder_GetWidth(decoder, pCodes[i],
+										  me->gbInfoHeader.gbiHeight))
+			continue;
+		pItems[nItem].nOffset = GreyBitFile_Decoder_GetDataOffset(me,
+																  pCodes[i]);
+		if (IS_INRAM(pItems[nItem].nOffset))
+			continue;
+		pItems[nItem++].nCode = pCodes[i];
+	}
+	GreyBit_Preload_Sort(pItems, nItem);
+	bTable = (GB_BOOL)((me->gbInfoHeaderEx.gbiFlags & GBF_FLAG_LENGTHTAB) != 0);
+	bLength = (GB_BOOL)(me->gbInfoHeader.gbiCompression && !bTable);
+	nRecSize = me->nBuffSize + (bLength ? sizeof(GB_UINT16) : 0);
+	nWindow = nRecSize > GB_PRELOAD_WINDOW ? nRecSize : GB_PRELOAD_WINDOW;
+	pWindow = (GB_BYTE *)GreyBit_Malloc(me->gbMem, nWindow);
+	nRet = pWindow ? GB_SUCCESS : GB_FAILED;
+	i = 0;
+	while (nRet == GB_SUCCESS && i < nItem)
+	{
+		nFirst = i;
+		for (nLast = nFirst; nLast + 1 < nItem; ++nLast)
+		{
+			if (pItems[nLast + 1].nOffset - pItems[nFirst].nOffset + nRecSize
+			  > (GB_UINT32)nWindow)
+				break;
+		}
+		nInDataLen = nRecSize;
+		if (bTable)
+			nInDataLen = GreyBitFile_Decoder_GetDataLength(me,
+														   pItems[nLast].nCode);
+		GreyBit_Stream_Seek(me->gbStream, me->gbInfoHeader.gbiOffGreyBits
+						  + me->gbOffDataBits + pItems[nFirst].nOffset);
+		nRead = GreyBit_Stream_Read(me->gbStream, pWindow,
+									pItems[nLast].nOffset
+								  - pItems[nFirst].nOffset + nInDataLen);
+		for (; i <= nLast; ++i)
+		{
+			if (i > nFirst && pItems[i].nCode == pItems[i - 1].nCode)
+				continue;
+			nPos = pItems[i].nOffset - pItems[nFirst].nOffset;
+			if (bTable)
+			{
+				nInDataLen = GreyBitFile_Decoder_GetDataLength(me,
+															pItems[i].nCode);
+			}
+			else if (bLength)
+			{
+				if (nPos + (GB_INT32)sizeof(GB_UINT16) > nRead)
+					continue;
+				GB_MEMCPY(&Lenght, pWindow + nPos, sizeof(GB_UINT16));
+				nPos += sizeof(GB_UINT16);
+				nInDataLen = Lenght;
+			}
+			else
+			{
+				nWidth = (GB_INT16)GreyBitFile_Decoder_GetWidth(decoder,
+									pItems[i].nCode, me->gbInfoHeader.gbiHeight);
+				nRows = me->gbInfoHeader.gbiHeight;
+				nHead = 0;
+				if (me->gbInfoHeaderEx.gbiFlags & GBF_FLAG_CROP)
+				{
+					if (nPos + GBF_CROP_SIZE > nRead)
+						continue;
+					nRows = pWindow[nPos + 1];
+					nHead = GBF_CROP_SIZE;
+				}
+				nInDataLen = nHead + ((me->gbInfoHeader.gbiBitCount * 8 * nWidth
+							+ 63) >> 6) * nRows;
+			}
+			if (nPos + nInDataLen > nRead)
+				continue;
+			nRet = GreyBitFile_Decoder_CaheItem(font, pItems[i].nCode,
+												pWindow + nPos, nInDataLen);
+			if (nRet != GB_SUCCESS)
+				break;
+		}
+	}
+	GreyBit_Stream_Unlock(me->gbStream);
+	if (pWindow)
+		GreyBit_Free(me->gbMem, pWindow);
+	GreyBit_Free(me->gbMem, pItems);
+	return nRet;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Decoder_NewContext
+** Description: Make a decode context of a font. All tables are loaded first
+**              and stay as they are; the context shares them and the cache
+**              of the font, and has its own bitmap and read buffer, so that
+**              only stream reads and cache fills take the stream lock.
+** Input: decoder - decoder
+**        loader - loader of the context
+**        stream - stream of the context, a child of the font stream
+** Output: New decoder context
+** Return value: decoder context/0 if tables could not be loaded
+** ---------------------------------------------------------------------------
+*/
+
+GB_Decoder	GreyBitFile_Decoder_NewContext(GB_Decoder decoder,
+										   GB_Loader loader, GB_Stream stream)
+{
+	GB_INT32	nRet;
+	GBF_Decoder	font;
+	GBF_Decoder	me;
+
+	font = GBF_FONT((GBF_Decoder)decoder);
+	if (GreyBit_Stream_Share(font->gbStream) != GB_SUCCESS)
+		return 0;
+	me = (GBF_Decoder)GreyBit_Malloc(loader->gbMem, sizeof(GBF_DecoderRec));
+	if (!me)
+		return 0;
+	GreyBit_Stream_Lock(font->gbStream);
+	nRet = GreyBitFile_Decoder_LoadTables(font);
+	if (nRet == GB_SUCCESS)
+	{
+		font->bShared = GB_TRUE;
+		GB_MEMCPY(me, font, sizeof(GBF_DecoderRec));
+	}
+	GreyBit_Stream_Unlock(font->gbStream);
+	if (nRet != GB_SUCCESS)
+	{
+		GreyBit_Free(loader->gbMem, me);
+		return 0;
+	}
+	me->gbFont = font;
+	me->gbLibrary = loader->gbLibrary;
+	me->gbMem = loader->gbMem;
+	me->gbStream = stream;
+	me->nCacheItem = 0;
+	me->gpGreyBits = 0;
+	me->pnGreySize = 0;
+	me->nGreyBitsCount = 0;
+	GreyBitFile_Decoder_InfoInit(me, font->gbInfoHeader.gbiWidth,
+								 font->gbInfoHeader.gbiHeight,
+								 font->gbInfoHeader.gbiBitCount);
+	if (!me->pBuff)
+	{
+		GreyBitFile_Decoder_Done((GB_Decoder)me);
+		return 0;
+	}
+	return (GB_Decoder)me;
+}
 
 /*
 ** ---------------------------------------------------------------------------
@@ -661,7 +1810,17 @@ void		GreyBitFile_Decoder_Done(GB_Decoder decoder)
 {
 	GBF_Decoder	me = (GBF_Decoder)decoder;
 
-	GreyBitFile_Decoder_ClearCache(me);
+	if (me->gbFont)
+	{
+		if (me->gbBitmap)
+			GreyBitType_Bitmap_Done(me->gbLibrary, me->gbBitmap);
+		if (me->pBuff)
+			GreyBit_Free(me->gbMem, me->pBuff);
+	}
+	else
+	{
+		GreyBitFile_Decoder_ClearCache(me);
+	}
 	GreyBit_Free(me->gbMem, decoder);
 }
 #endif //ENABLE_GREYBITFILE
\ No newline at end of file
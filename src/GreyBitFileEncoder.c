@@ -8,6 +8,11 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				1 bit compression only on request
+** 10/18/2026	me				Size of the flushed font
+** 10/18/2026	me				1 bit compression, fix RLE overrun
+** 10/18/2026	me				Length table
+** 10/18/2026	me				Cropped glyph storage
 ** 09/16/2023	me				Upgrade
 ** 08/10/2023	me              Init
 ** ===========================================================================
@@ -31,6 +36,9 @@
 **----------------------------------------------------------------------------
 */
 
+/* byte i of 1 bit data XORed with the byte above it */
+#define XOR_ROW(d,i,p)				((d)[i] ^ ((i) >= (p) ? (d)[(i) - (p)] : 0))
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
@@ -83,6 +91,9 @@ GB_INT32	GreyBitFile_Encoder_Init(GBF_Encoder encoder)
 	encoder->nCacheItem = MAX_COUNT;
 	GB_MEMSET(encoder->gbWidthTable, 0, MAX_COUNT);
 	GB_MEMSET(encoder->gbHoriOffTable, 0, MAX_COUNT);
+	GB_MEMSET(encoder->gbOffsetTable, 0, sizeof(GB_UINT32) * MAX_COUNT);
+	GB_MEMSET(encoder->gpGreyBits, 0, sizeof(GB_BYTE *) * MAX_COUNT);
+	GB_MEMSET(encoder->pnGreySize, 0, sizeof(GB_UINT16) * MAX_COUNT);
 	return GB_SUCCESS;
 }
 
@@ -93,7 +104,7 @@ GB_INT32	GreyBitFile_Encoder_Init(GBF_Encoder encoder)
 ** Input: encoder - encoder
 **        nHeight - height
 **        nBitCount - bit count
-**		  bCompress - compress?
+**		  bCompress - compress? GBF_COMPRESS_BITS to compress 1 bit too
 ** Output: Initialized info
 ** Return value: success
 ** ---------------------------------------------------------------------------
@@ -102,13 +113,19 @@ GB_INT32	GreyBitFile_Encoder_Init(GBF_Encoder encoder)
 GB_INT32	GreyBitFile_Encoder_InfoInit(GBF_Encoder encoder, GB_INT16 nHeight,
 										 GB_INT16 nBitCount, GB_INT16 bCompress)
 {
+	GB_INT16	nCompression;
 	GB_INT32	i;
 
+	nCompression = GBF_COMPRESS_NONE;
+	if (bCompress && nBitCount == 8)
+		nCompression = GBF_COMPRESS_RLE;
+	else if (bCompress == GBF_COMPRESS_BITS && nBitCount == 1)
+		nCompression = GBF_COMPRESS_BITS;
 	if (encoder->gbInited)
 	{
 		if (encoder->gbInfoHeader.gbiHeight == nHeight
-			|| encoder->gbInfoHeader.gbiBitCount == nBitCount
-			|| encoder->gbInfoHeader.gbiHeight == nHeight)
+			&& encoder->gbInfoHeader.gbiBitCount == nBitCount
+			&& encoder->gbInfoHeader.gbiCompression == nCompression)
 			return GB_SUCCESS;
 		GB_MEMSET(encoder->gbWidthTable, 0, MAX_COUNT);
 		GB_MEMSET(encoder->gbHoriOffTable, 0, MAX_COUNT);
@@ -126,10 +143,7 @@ GB_INT32	GreyBitFile_Encoder_InfoInit(GBF_Encoder encoder, GB_INT16 nHeight,
 	encoder->gbInited = 1;
 	encoder->gbInfoHeader.gbiBitCount = nBitCount;
 	encoder->gbInfoHeader.gbiHeight = nHeight;
-	if (nBitCount == 8)
-		encoder->gbInfoHeader.gbiCompression = bCompress;
-	else
-		encoder->gbInfoHeader.gbiCompression = 0;
+	encoder->gbInfoHeader.gbiCompression = nCompression;
 	return GB_SUCCESS;
 }
 
@@ -169,8 +183,9 @@ void		GreyBitFile_Encoder_ClearCache(GBF_Encoder encoder)
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitFile_Encoder_Compress
-** Description: Compress character data
-** Input: pOutData - output data
+** Description: Compress 8 bit character data. A run of equal 7 bit values
+**              is a length byte and the value, anything else is the value.
+** Input: pOutData - output data, 0 to only get the length
 **        pnInOutLen - output data length
 **        pInData - input data
 **        nInDataLen - input data length
@@ -184,71 +199,142 @@ GB_INT32	GreyBitFile_Encoder_Compress(GB_BYTE *pOutData,
 										 GB_INT32 nInDataLen)
 {
 	GB_INT32	nCompressLen;
-	GB_INT32	nCompressLena;
+	GB_INT32	nRun;
 	GB_INT32	i;
-	GB_INT32	ia;
-	GB_BYTE		nNextData; 
 	GB_BYTE		nData;
-	GB_BYTE		nLen;
 
 	nCompressLen = 0;
-	nLen = 0;
-	nData = *pInData >> 1;
-	if (pOutData)
+	for (i = 0; i < nInDataLen; i += nRun)
 	{
-		for (i = 1; i < nInDataLen; ++i)
+		nData = pInData[i] >> 1;
+		for (nRun = 1; i + nRun < nInDataLen && nRun < LEN_MASK; ++nRun)
 		{
-			nNextData = pInData[i] >> 1;
-			if (nData == nNextData && nLen < MAX_LEN())
-			{
-				++nLen;
-			}
-			else if (nLen)
-			{
-				pOutData[nCompressLen] = SET_LEN(nLen);
-				pOutData[nCompressLen+1] = nData;
-				nLen = 0;
-			}
-			else
-			{
-				pOutData[nCompressLen] = nData;
-			}
-			nCompressLen += ((nLen > 0) ? 2 : 1);
-			nData = nNextData;
+			if (pInData[i + nRun] >> 1 != nData)
+				break;
 		}
-		if (nLen)
+		if (nRun > 1)
 		{
-			pOutData[nCompressLen] = SET_LEN(nLen);
+			if (pOutData)
+				pOutData[nCompressLen] = (GB_BYTE)SET_LEN(nRun - 1);
 			nCompressLen++;
 		}
-		pOutData[nCompressLen] = nData;
-		nCompressLena = nCompressLen + 1;
+		if (pOutData)
+			pOutData[nCompressLen] = nData;
+		nCompressLen++;
 	}
-	else
+	*pnInOutLen = nCompressLen;
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Encoder_CompressBits
+** Description: Compress 1 bit character data. Each row is XORed with the
+**              row above, so repeated rows become zero, then the bytes are
+**              stored as runs of 3 or more (length byte with LEN_MASK, then
+**              the byte) and literals (count - 1, then the bytes). Output is
+**              at most one byte per 128 longer than the input.
+** Input: pOutData - output data, 0 to only get the length
+**        pnInOutLen - output data length
+**        pInData - input data
+**        nInDataLen - input data length
+**        nPitch - bytes per row
+** Output: Compressed data
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Encoder_CompressBits(GB_BYTE *pOutData,
+											 GB_INT32*pnInOutLen,
+											 GB_BYTE *pInData,
+											 GB_INT32 nInDataLen,
+											 GB_INT32 nPitch)
+{
+	GB_INT32	nCompressLen;
+	GB_INT32	nRun;
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_BYTE		nData;
+
+	nCompressLen = 0;
+	for (i = 0; i < nInDataLen; i += nRun)
 	{
-		for (ia = 1; ia < nInDataLen; ++ia)
+		nData = (GB_BYTE)XOR_ROW(pInData, i, nPitch);
+		for (nRun = 1; i + nRun < nInDataLen && nRun < LEN_MASK; ++nRun)
 		{
-			if (nData == pInData[ia] >> 1 && nLen < MAX_LEN())
-			{
-				++nLen;
-			}
-			else if (nLen)
-			{
-				nCompressLen += 2;
-				nLen = 0;
-			}
-			else
+			if (XOR_ROW(pInData, i + nRun, nPitch) != nData)
+				break;
+		}
+		if (nRun > 2)
+		{
+			if (pOutData)
 			{
-				++nCompressLen;
+				pOutData[nCompressLen] = (GB_BYTE)SET_LEN(nRun - 1);
+				pOutData[nCompressLen + 1] = nData;
 			}
-			nData = pInData[ia] >> 1;
+			nCompressLen += 2;
+			continue;
+		}
+		for (nRun = 1; i + nRun < nInDataLen && nRun < LEN_MASK; ++nRun)
+		{
+			if (i + nRun + 2 < nInDataLen
+			 && XOR_ROW(pInData, i + nRun, nPitch)
+			 == XOR_ROW(pInData, i + nRun + 1, nPitch)
+			 && XOR_ROW(pInData, i + nRun, nPitch)
+			 == XOR_ROW(pInData, i + nRun + 2, nPitch))
+				break;
 		}
-		if (nLen)
-			nCompressLena = nCompressLen + 2;
-		else
-			nCompressLena = nCompressLen + 1;
+		if (pOutData)
+		{
+			pOutData[nCompressLen] = (GB_BYTE)(nRun - 1);
+			for (j = 0; j < nRun; ++j)
+				pOutData[nCompressLen + 1 + j] = (GB_BYTE)XOR_ROW(pInData,
+																  i + j,
+																  nPitch);
+		}
+		nCompressLen += 1 + nRun;
 	}
-	*pnInOutLen = nCompressLena;
+	*pnInOutLen = nCompressLen;
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitFile_Encoder_GetInk
+** Description: Get the inked rows of a bitmap
+** Input: bitmap - bitmap
+** Output: pnInkTop - first inked row
+**         pnInkHeight - inked row count, 0 for a blank bitmap
+** Return value: success
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitFile_Encoder_GetInk(GB_Bitmap bitmap, GB_INT16* pnInkTop,
+									   GB_INT16* pnInkHeight)
+{
+	GB_INT16	nTop;
+	GB_INT16	nBottom;
+	GB_INT32	i;
+	GB_BYTE *	pRow;
+
+	for (nTop = 0; nTop < bitmap->height; ++nTop)
+	{
+		pRow = bitmap->buffer + nTop * bitmap->pitch;
+		for (i = 0; i < bitmap->pitch && !pRow[i]; ++i)
+			;
+		if (i < bitmap->pitch)
+			break;
+	}
+	for (nBottom = bitmap->height; nBottom > nTop; --nBottom)
+	{
+		pRow = bitmap->buffer + (nBottom - 1) * bitmap->pitch;
+		for (i = 0; i < bitmap->pitch && !pRow[i]; ++i)
+			;
+		if (i < bitmap->pitch)
+			break;
+	}
+	*pnInkHeight = nBottom - nTop;
+	*pnInkTop = *pnInkHeight ? nTop : 0;
 	return GB_SUCCESS;
 }
 
@@ -269,11 +355,12 @@ GB_INT32	GreyBitFile_Encoder_BuildAll(GBF_Encoder encoder)
 	GB_UINT32	nCount;
 	GB_UINT32	nGreyBitSize;
 	GB_UINT32	nOffSetTableSize;
+	GB_UINT32	nLengthTableSize;
 	GB_UINT32	nHoriOffTableSize;
 	GB_UINT32	nWidthTableSize;
-	GB_UINT16	nCode;
-	GB_UINT16	nCodea;
-	GB_UINT16	nCodeb;
+	GB_INT32	nCode;
+	GB_INT32	nCodea;
+	GB_INT32	nCodeb;
 	GB_UINT16	nMinCode;
 	GB_UINT16	nMaxCode;
 	GB_UINT16	nSectionLen;
@@ -282,6 +369,7 @@ GB_INT32	GreyBitFile_Encoder_BuildAll(GBF_Encoder encoder)
 	nWidthTableSize = 0;
 	nHoriOffTableSize = 0;
 	nOffSetTableSize = 0;
+	nLengthTableSize = 0;
 	nGreyBitSize = 0;
 	nCount = 0;
 	nCodea = 0;
@@ -301,12 +389,13 @@ GB_INT32	GreyBitFile_Encoder_BuildAll(GBF_Encoder encoder)
 				nWidthTableSize += nSectionLen;
 				nHoriOffTableSize += nSectionLen;
 				nOffSetTableSize += sizeof(GB_UINT32) * nSectionLen;
+				if (encoder->bLengthTab)
+					nLengthTableSize += sizeof(GB_UINT16) * nSectionLen;
 				break;
 			}
 		}
 	}
-	if (encoder->gbInfoHeader.gbiCompression
-	 && encoder->gbInfoHeader.gbiBitCount == 8)
+	if (encoder->gbInfoHeader.gbiCompression && !encoder->bLengthTab)
 	{
 		while (nCodea < MAX_COUNT)
 		{
@@ -336,11 +425,22 @@ GB_INT32	GreyBitFile_Encoder_BuildAll(GBF_Encoder encoder)
 	}
 	encoder->gbInfoHeader.gbiCount = nCount;
 	encoder->gbInfoHeader.gbiOffGreyBits =nOffSetTableSize + nHoriOffTableSize
-										 + nWidthTableSize;
+										 + nWidthTableSize + nLengthTableSize;
+	encoder->gbInfoHeaderEx.gbiLengthTabOff = nOffSetTableSize
+											+ nHoriOffTableSize
+											+ nWidthTableSize;
 	encoder->gbInfoHeader.gbiOffsetTabOff=nHoriOffTableSize + nWidthTableSize;
 	encoder->gbInfoHeader.gbiHoriOffTabOff = nWidthTableSize;
 	encoder->gbInfoHeader.gbiWidthTabOff = 0;
+	encoder->gbInfoHeaderEx.gbiFlags = encoder->bCrop ? GBF_FLAG_CROP : 0;
+	if (encoder->bLengthTab)
+		encoder->gbInfoHeaderEx.gbiFlags |= GBF_FLAG_LENGTHTAB;
 	encoder->gbInfoHeader.gbiSize = sizeof(GREYBITINFOHEADER);
+	if (encoder->gbInfoHeaderEx.gbiFlags)
+		encoder->gbInfoHeader.gbiSize += sizeof(GREYBITINFOHEADEREX);
+	encoder->nFileSize = sizeof(GREYBITFILEHEADER)
+					   + encoder->gbInfoHeader.gbiSize
+					   + encoder->gbInfoHeader.gbiOffGreyBits + nGreyBitSize;
 	encoder->gbFileHeader.gbfTag[0] = 'g';
 	encoder->gbFileHeader.gbfTag[1] = 'b';
 	encoder->gbFileHeader.gbfTag[2] = 't';
@@ -373,6 +473,10 @@ GB_INT32	GreyBitFile_Encoder_WriteAll(GBF_Encoder encoder)
 						 sizeof(GREYBITFILEHEADER));
 	GreyBit_Stream_Write(encoder->gbStream, (GB_BYTE*)&encoder->gbInfoHeader,
 						 sizeof(GREYBITINFOHEADER));
+	if (encoder->gbInfoHeaderEx.gbiFlags)
+		GreyBit_Stream_Write(encoder->gbStream,
+							 (GB_BYTE*)&encoder->gbInfoHeaderEx,
+							 sizeof(GREYBITINFOHEADEREX));
 	for (nSection = 0; nSection < UNICODE_SECTION_NUM; ++nSection)
 	{
 		UnicodeSection_GetSectionInfo(nSection, &nMinCode, &nMaxCode);
@@ -406,8 +510,19 @@ GB_INT32	GreyBitFile_Encoder_WriteAll(GBF_Encoder encoder)
 			GreyBit_Stream_Write(encoder->gbStream, pData, nDataSize);
 		}
 	}
-	if (encoder->gbInfoHeader.gbiCompression
-	 && encoder->gbInfoHeader.gbiBitCount == 8)
+	for (nSection = 0; nSection < UNICODE_SECTION_NUM
+		 && encoder->bLengthTab; ++nSection)
+	{
+		UnicodeSection_GetSectionInfo(nSection, &nMinCode, &nMaxCode);
+		nSectionLen = nMaxCode - nMinCode + 1;
+		if (encoder->gbInfoHeader.gbiIndexSection.gbSectionOff[nSection])
+		{
+			pData = (GB_BYTE *)&encoder->pnGreySize[nMinCode];
+			nDataSize = sizeof(GB_UINT16) * (GB_UINT16)nSectionLen;
+			GreyBit_Stream_Write(encoder->gbStream, pData, nDataSize);
+		}
+	}
+	if (encoder->gbInfoHeader.gbiCompression && !encoder->bLengthTab)
 	{
 		for (nCode = 0; nCode < encoder->nCacheItem; ++nCode)
 		{
@@ -484,6 +599,14 @@ GB_INT32	GreyBitFile_Encoder_SetParam(GB_Encoder encoder, GB_Param nParam,
 			me->nBitCount = (GB_INT16)dwParam;
 		if (nParam ==GB_PARAM_COMPRESS)
 			me->bCompress = (GB_BOOL)dwParam;
+		if (nParam == GB_PARAM_CROP)
+		{
+			if (me->gbInfoHeader.gbiWidth)
+				return GB_FAILED;
+			me->bCrop = (GB_BOOL)dwParam;
+		}
+		if (nParam == GB_PARAM_LENGTHTABLE)
+			me->bLengthTab = (GB_BOOL)dwParam;
 	}
 	GreyBitFile_Encoder_InfoInit(me,me->nHeight,me->nBitCount,me->bCompress);
 	return GB_SUCCESS;
@@ -519,7 +642,8 @@ GB_INT32	GreyBitFile_Encoder_Delete(GB_Encoder encoder, GB_UINT32 nCode)
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitFile_Encoder_Encode
-** Description: Encode code to new font
+** Description: Encode code to new font. With GB_PARAM_CROP only the inked
+**              rows are stored, after their top row and count.
 ** Input: encoder - encoder
 **        nCode - unicode code
 **        pData - data buffer
@@ -532,6 +656,10 @@ GB_INT32	GreyBitFile_Encoder_Encode(GB_Encoder encoder, GB_UINT32 nCode,
 									   GB_Data pData)
 {
 	GB_BYTE *	pByteData;
+	GB_BYTE *	pInData;
+	GB_INT16	nInkTop;
+	GB_INT16	nInkHeight;
+	GB_INT32	nHead;
 	GB_INT32	nOutLen;
 	GB_INT32	nInDataLen;
 	GB_Bitmap	bitmap;
@@ -548,21 +676,47 @@ GB_INT32	GreyBitFile_Encoder_Encode(GB_Encoder encoder, GB_UINT32 nCode,
 	{
 		return GB_FAILED;
 	}
+	if (me->bCrop && bitmap->height > 0xff)
+		return GB_FAILED;
 	if (me->gbInfoHeader.gbiWidth < bitmap->width)
 		me->gbInfoHeader.gbiWidth = bitmap->width;
-	nInDataLen = bitmap->pitch * bitmap->height;
-	if (me->gbInfoHeader.gbiCompression)
+	nInkTop = 0;
+	nInkHeight = bitmap->height;
+	nHead = 0;
+	if (me->bCrop)
+	{
+		GreyBitFile_Encoder_GetInk(bitmap, &nInkTop, &nInkHeight);
+		nHead = GBF_CROP_SIZE;
+	}
+	pInData = bitmap->buffer + nInkTop * bitmap->pitch;
+	nInDataLen = bitmap->pitch * nInkHeight;
+	if (me->gbInfoHeader.gbiCompression == GBF_COMPRESS_RLE && nInDataLen)
 	{
-		GreyBitFile_Encoder_Compress(0, &nOutLen, bitmap->buffer, nInDataLen);
-		pByteData = (GB_BYTE *)GreyBit_Malloc(me->gbMem, nOutLen);
-		GreyBitFile_Encoder_Compress(pByteData, &nOutLen, bitmap->buffer,
+		GreyBitFile_Encoder_Compress(0, &nOutLen, pInData, nInDataLen);
+		pByteData = (GB_BYTE *)GreyBit_Malloc(me->gbMem, nHead + nOutLen);
+		GreyBitFile_Encoder_Compress(pByteData + nHead, &nOutLen, pInData,
 									 nInDataLen);
 	}
+	else if (me->gbInfoHeader.gbiCompression == GBF_COMPRESS_BITS
+		  && nInDataLen)
+	{
+		GreyBitFile_Encoder_CompressBits(0, &nOutLen, pInData, nInDataLen,
+										 bitmap->pitch);
+		pByteData = (GB_BYTE *)GreyBit_Malloc(me->gbMem, nHead + nOutLen);
+		GreyBitFile_Encoder_CompressBits(pByteData + nHead, &nOutLen, pInData,
+										 nInDataLen, bitmap->pitch);
+	}
 	else
 	{
 		nOutLen = nInDataLen;
-		pByteData = (GB_BYTE *)GreyBit_Malloc(me->gbMem, nInDataLen);
-		GB_MEMCPY(pByteData, bitmap->buffer, nInDataLen);
+		pByteData = (GB_BYTE *)GreyBit_Malloc(me->gbMem, nHead + nInDataLen);
+		GB_MEMCPY(pByteData + nHead, pInData, nInDataLen);
+	}
+	if (nHead)
+	{
+		pByteData[0] = (GB_BYTE)nInkTop;
+		pByteData[1] = (GB_BYTE)nInkHeight;
+		nOutLen += nHead;
 	}
 	if (me->gpGreyBits[nCode])
 		GreyBit_Free(me->gbMem, me->gpGreyBits[nCode]);
@@ -632,14 +786,16 @@ GB_Encoder	GreyBitFile_Encoder_New(GB_Creator creator, GB_Stream stream)
 {
 	GBF_Encoder	codec;
 
-	codec = (GBF_Encoder)GreyBit_Malloc(creator->gbMem, sizeof(GBF_Encoder));
+	codec = (GBF_Encoder)GreyBit_Malloc(creator->gbMem,sizeof(GBF_EncoderRec));
 	if (codec)
 	{
+		GB_MEMSET(codec, 0, sizeof(GBF_EncoderRec));
 		codec->gbEncoder.getcount = GreyBitFile_Encoder_GetCount;
 		codec->gbEncoder.setparam = GreyBitFile_Encoder_SetParam;
 		codec->gbEncoder.remove = GreyBitFile_Encoder_Delete;
 		codec->gbEncoder.encode = GreyBitFile_Encoder_Encode;
 		codec->gbEncoder.flush = GreyBitFile_Encoder_Flush;
+		codec->gbEncoder.bake = 0;
 		codec->gbEncoder.done = GreyBitFile_Encoder_Done;
 		codec->gbLibrary = creator->gbLibrary;
 		codec->gbMem = creator->gbMem;
@@ -8,6 +8,21 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Skip the copy of outlines rendered in place
+** 10/18/2026	me				Dense raster size from the loader
+** 10/18/2026	me				1 bit italic keeps the last byte, any slant
+** 10/18/2026	me				Copy decoder bitmaps, fix buffer switch
+** 10/18/2026	me				Render characters as spans to a caller callback
+** 10/18/2026	me				LCD subpixel glyphs
+** 10/18/2026	me				1 bit outlines rendered without the 8 bit bitmap
+** 10/18/2026	me				Small sizes rendered by the dense raster engine
+** 10/18/2026	me				Bold and italic outlines styled before rendering, italic leans right
+** 10/18/2026	me				1 bit scaled pitch rounded up
+** 10/18/2026	me				Render outlines within their ink box
+** 10/18/2026	me				Render packed outlines
+** 10/18/2026	me				Blit character from decoder spans
+** 10/18/2026	me				Scale, bold and italic only the inked rows
+** 10/18/2026	me				Load character into caller bitmap
 ** 03/29/2024	me				Make bitmap scale function a single function,
 **                              add fixes to 8 to 1 conversion (only for vals
 **	                            > BITMAP8TO1_SWITCH_VALUE)
@@ -36,12 +51,33 @@
 **----------------------------------------------------------------------------
 */
 
+#define LAYOUT_BOLD_MAX			(4 << 6)	// 26.6, widest bitmap bold
+#define LAYOUT_ITALIC_SLANT		0x4000		// 16.16 run per rise, as bitmap
+#define LAYOUT_LCD_WEIGHTS		0x08, 0x4D, 0x56, 0x4D, 0x08	// sum 0x100
+#define LAYOUT_SPANS			32			// spans passed per callback
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
 **----------------------------------------------------------------------------
 */
 
+typedef struct tagBLENDTARGET
+{
+	GB_Bitmap	gbDst;
+	GB_INT16	x;
+	GB_INT16	y;
+} BLENDTARGET;
+
+typedef struct tagSPANTARGET
+{
+	GB_SpanFunc	func;
+	void*		user;
+	GB_INT16	x;
+	GB_INT16	y;
+	GB_BBox		clip;
+} SPANTARGET;
+
 /*
 **----------------------------------------------------------------------------
 **  Global variables
@@ -54,6 +90,8 @@
 **----------------------------------------------------------------------------
 */
 
+static const GB_BYTE s_LcdWeights[5] = { LAYOUT_LCD_WEIGHTS };
+
 /*
 **----------------------------------------------------------------------------
 **  Function(internal use only) Declarations
@@ -67,7 +105,7 @@
 ** Input: bitmap - bitmap
 **        pNewBuf - new buffer
 ** Output: New buffer
-** Return value: pNewBuf
+** Return value: old buffer
 ** ---------------------------------------------------------------------------
 */
 
@@ -77,13 +115,223 @@ GB_BYTE*	GreyBitType_Bitmap_SwitcBuffer(GB_Bitmap bitmap, void * pNewBuf)
 
 	pBuf = bitmap->buffer;
 	bitmap->buffer = (GB_BYTE *)pNewBuf;
-	return pNewBuf;
+	return pBuf;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Bitmap_BlendSpans
+** Description: Blend coverage spans over an 8 bit bitmap, clipped to its
+**              bounds. Full coverage is a fill, anything else is blended.
+** Input: y - span row, relative to the target
+**        count - span count
+**        spans - spans
+**        user - BLENDTARGET
+** Output: Blended spans
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyBitType_Bitmap_BlendSpans(int y, int count,
+										  const GB_Span* spans, void* user)
+{
+	GB_INT32		x0;
+	GB_INT32		x1;
+	GB_BYTE *		pDst;
+	BLENDTARGET*	target = (BLENDTARGET*)user;
+	GB_Bitmap		dst = target->gbDst;
+
+	y += target->y;
+	if (y < 0 || y >= dst->height)
+		return;
+	pDst = dst->buffer + y * dst->pitch;
+	for (; count > 0; count--, spans++)
+	{
+		x0 = target->x + spans->x;
+		x1 = x0 + spans->len;
+		if (x0 < 0)
+			x0 = 0;
+		if (x1 > dst->width)
+			x1 = dst->width;
+		if (spans->coverage == 0xff)
+		{
+			if (x1 > x0)
+				GB_MEMSET(pDst + x0, 0xff, x1 - x0);
+			continue;
+		}
+		for (; x0 < x1; ++x0)
+			pDst[x0] += (GB_BYTE)(((0xff - pDst[x0]) * spans->coverage
+					  + 0x7f) / 0xff);
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Bitmap_BlendTo
+** Description: Blend an 8 bit bitmap over a larger one, row by row as spans
+** Input: dst - destination bitmap
+**        src - source bitmap
+**        x - left of src in dst
+**        y - top of src in dst
+** Output: Blended bitmap
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Bitmap_BlendTo(GB_Bitmap dst, GB_Bitmap src,
+									   GB_INT16 x, GB_INT16 y)
+{
+	GB_Span		span;
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_BYTE *	pSrc;
+	BLENDTARGET	target;
+
+	if (dst->bitcount != 8 || src->bitcount != 8)
+		return GB_FAILED;
+	target.gbDst = dst;
+	target.x = x;
+	target.y = y;
+	for (i = 0; i < src->height; ++i)
+	{
+		pSrc = src->buffer + i * src->pitch;
+		for (j = 0; j < src->width; j += span.len)
+		{
+			span.x = (short)j;
+			span.len = 1;
+			span.coverage = pSrc[j];
+			while (j + span.len < src->width
+				&& pSrc[j + span.len] == span.coverage)
+				span.len++;
+			if (span.coverage)
+				GreyBitType_Bitmap_BlendSpans(i, 1, &span, &target);
+		}
+	}
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_ClipSpans
+** Description: Move character spans to the caller position, clip them and
+**              pass them on to the caller callback
+** Input: y - span row, relative to the character
+**        count - span count
+**        spans - spans
+**        user - SPANTARGET
+** Output: Spans passed to the caller
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyBitType_Layout_ClipSpans(int y, int count,
+										 const GB_Span* spans, void* user)
+{
+	GB_INT32		x0;
+	GB_INT32		x1;
+	GB_INT32		n;
+	GB_Span			out[LAYOUT_SPANS];
+	SPANTARGET*		target = (SPANTARGET*)user;
+
+	y += target->y;
+	if (y < target->clip.yMin || y >= target->clip.yMax)
+		return;
+	n = 0;
+	for (; count > 0; count--, spans++)
+	{
+		x0 = target->x + spans->x;
+		x1 = x0 + spans->len;
+		if (x0 < target->clip.xMin)
+			x0 = target->clip.xMin;
+		if (x1 > target->clip.xMax)
+			x1 = target->clip.xMax;
+		if (x1 <= x0)
+			continue;
+		out[n].x = (short)x0;
+		out[n].len = (unsigned short)(x1 - x0);
+		out[n].coverage = spans->coverage;
+		if (++n == LAYOUT_SPANS)
+		{
+			target->func(y, n, out, target->user);
+			n = 0;
+		}
+	}
+	if (n)
+		target->func(y, n, out, target->user);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_BitmapSpans
+** Description: Pass the inked rows of the layout bitmap on as spans, runs
+**              of pixels of the same value, scaled to 8 bit coverage
+** Input: layout - layout
+**        target - SPANTARGET
+** Output: Spans passed to the caller
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_BitmapSpans(GB_Layout layout,
+										   SPANTARGET* target)
+{
+	GB_BYTE		nPixel;
+	GB_BYTE		nLast;
+	GB_BYTE		nMask;
+	GB_INT32	nBits;
+	GB_INT32	nStart;
+	GB_INT32	n;
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_BYTE *	pSrc;
+	GB_Span		spans[LAYOUT_SPANS];
+	GB_Bitmap	bitmap = layout->gbBitmap;
+
+	nBits = bitmap->bitcount;
+	if (nBits > 8)
+		return GB_FAILED;
+	nMask = (GB_BYTE)((1 << nBits) - 1);
+	for (i = layout->nInkTop; i < layout->nInkTop + layout->nInkHeight; ++i)
+	{
+		pSrc = bitmap->buffer + i * bitmap->pitch;
+		n = 0;
+		nLast = 0;
+		nStart = 0;
+		for (j = 0; j <= bitmap->width; ++j)
+		{
+			if (j == bitmap->width)
+				nPixel = 0;
+			else if (nBits == 8)
+				nPixel = pSrc[j];
+			else
+				nPixel = (GB_BYTE)((pSrc[(j * nBits) >> 3]
+						 >> (8 - nBits - ((j * nBits) & 7))) & nMask);
+			if (nPixel == nLast)
+				continue;
+			if (nLast)
+			{
+				spans[n].x = (short)nStart;
+				spans[n].len = (unsigned short)(j - nStart);
+				spans[n].coverage = (GB_BYTE)(nLast * 0xff / nMask);
+				if (++n == LAYOUT_SPANS)
+				{
+					GreyBitType_Layout_ClipSpans(i, n, spans, target);
+					n = 0;
+				}
+			}
+			nLast = nPixel;
+			nStart = j;
+		}
+		if (n)
+			GreyBitType_Layout_ClipSpans(i, n, spans, target);
+	}
+	return GB_SUCCESS;
 }
 
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Layout_Bold
-** Description: Bold character
+** Description: Bold the inked rows of character
 ** Input: layout - layout
 ** Output: Bolded character bitmap
 ** Return value: success/fail
@@ -100,6 +348,7 @@ int			GreyBitType_Layout_Bold(GB_Layout layout)
 	GB_BYTE *	pDst;
 	GB_BYTE *	pDsta;
 	GB_BYTE *	pSrc;
+	GB_INT32	nInk;
 	GB_INT32	y;
 	GB_INT32	ya;
 	GB_INT32	x;
@@ -107,19 +356,26 @@ int			GreyBitType_Layout_Bold(GB_Layout layout)
 	GB_Bitmap	bitmap;
 
 	bitmap = layout->gbBitmap;
-	pSrc = bitmap->buffer;
-	yMax = bitmap->height;
-	nOff = yMax >> 5;
+	nOff = bitmap->height >> 5;
 	if (!nOff)
 		return GB_FAILED;
 	if (nOff > 4)
 		nOff = 4;
+	if (bitmap->bitcount != 8 && bitmap->bitcount != 1)
+		return GB_FAILED;
+	nInk = layout->nInkTop * bitmap->pitch;
+	pSrc = bitmap->buffer + nInk;
+	yMax = layout->nInkTop + layout->nInkHeight;
+	GB_MEMSET(layout->gbSwitchBuf, 0, nInk);
+	GB_MEMSET(layout->gbSwitchBuf + yMax * bitmap->pitch, 0,
+			  layout->nSwitchBufLen - yMax * bitmap->pitch);
 	if (bitmap->bitcount == 8)
 	{
-		pDst = &layout->gbSwitchBuf[nOff];
+		pDst = &layout->gbSwitchBuf[nInk + nOff];
 		xMax = bitmap->pitch - nOff;
-		GB_MEMCPY(layout->gbSwitchBuf, bitmap->buffer, layout->nSwitchBufLen);
-		for (y = 0; y < yMax; ++y)
+		GB_MEMCPY(layout->gbSwitchBuf + nInk, pSrc,
+				  layout->nInkHeight * bitmap->pitch);
+		for (y = layout->nInkTop; y < yMax; ++y)
 		{
 			for (x = 0; x < xMax; ++x)
 			{
@@ -134,11 +390,9 @@ int			GreyBitType_Layout_Bold(GB_Layout layout)
 	}
 	else
 	{
-		if (bitmap->bitcount != 1)
-			return GB_FAILED;
-		pDsta = layout->gbSwitchBuf;
+		pDsta = layout->gbSwitchBuf + nInk;
 		xMaxa = bitmap->pitch;
-		for (ya = 0; ya < yMax; ++ya)
+		for (ya = layout->nInkTop; ya < yMax; ++ya)
 		{
 			bitMove = 0;
 			for (xa = 0; xa < xMaxa; ++xa)
@@ -158,7 +412,8 @@ int			GreyBitType_Layout_Bold(GB_Layout layout)
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Layout_Italic
-** Description: Italicize character
+** Description: Italicize the inked rows of character, top rows leaning
+**              right
 ** Input: layout - layout
 ** Output: Italic character bitmap
 ** Return value: success/fail
@@ -173,11 +428,12 @@ int			GreyBitType_Layout_Italic(GB_Layout layout)
 	GB_INT16	nHalfOffMax;
 	GB_INT16	xMax;
 	GB_INT16	xMaxa;
-	GB_INT16	xMaxb;
+	GB_INT16	nBit;
 	GB_INT16	yMax;
 	GB_BYTE *	pDst;
 	GB_BYTE *	pDsta;
 	GB_BYTE	*	pSrc;
+	GB_INT32	nInk;
 	GB_INT32	y;
 	GB_INT32	ya;
 	GB_INT32	x;
@@ -187,18 +443,22 @@ int			GreyBitType_Layout_Italic(GB_Layout layout)
 	GB_Bitmap	bitmap;
 
 	bitmap = layout->gbBitmap;
-	pSrc = bitmap->buffer;
-	yMax = bitmap->height;
-	nHalfOffMax = yMax >> 3;
-	if (!(yMax >> 2))
+	nHalfOffMax = bitmap->height >> 3;
+	if (!(bitmap->height >> 2))
+		return GB_FAILED;
+	if (bitmap->bitcount != 8 && bitmap->bitcount != 1)
 		return GB_FAILED;
+	nInk = layout->nInkTop * bitmap->pitch;
+	pSrc = bitmap->buffer + nInk;
+	yMax = layout->nInkTop + layout->nInkHeight;
 	if (bitmap->bitcount == 8)
 	{
 		pDst = layout->gbSwitchBuf;
 		GB_MEMSET(pDst, 0, layout->nSwitchBufLen);
-		for (y = 0; y < yMax; ++y)
+		pDst += nInk;
+		for (y = layout->nInkTop; y < yMax; ++y)
 		{
-			nOff = (GB_INT16)(y >> 2) - nHalfOffMax;
+			nOff = nHalfOffMax - (GB_INT16)(y >> 2);
 			if (nOff >= 0)
 			{
 				xMaxa = bitmap->pitch - nOff;
@@ -217,29 +477,24 @@ int			GreyBitType_Layout_Italic(GB_Layout layout)
 	}
 	else
 	{
-		if (bitmap->bitcount != 1)
-			return GB_FAILED;
 		pDsta = layout->gbSwitchBuf;
-		xMaxb = bitmap->pitch;
-		for (ya = 0; ya < yMax; ++ya)
+		GB_MEMSET(pDsta, 0, layout->nSwitchBufLen);
+		pDsta += nInk;
+		for (ya = layout->nInkTop; ya < yMax; ++ya)
 		{
-			nOffa = (GB_INT16)(ya >> 2) - nHalfOffMax;
-			bitMove = 0;
-			if (nOffa >= 0)
-			{
-				for (xc = 0; xc < xMaxb; ++xc)
-				{
-					pDsta[xc] = (bitMove << (8 - nOffa))|(pSrc[xc] >> nOffa);
-					bitMove = (255 >> (8 - nOffa)) & pSrc[xc];
-				}
-			}
-			else
+			/* the row moves nOffa pixels right: xb whole bytes, then nBit */
+			nOffa = nHalfOffMax - (GB_INT16)(ya >> 2);
+			xb = nOffa >= 0 ? nOffa >> 3 : -((7 - nOffa) >> 3);
+			nBit = (GB_INT16)(nOffa - xb * 8);
+			for (xc = 0; xc < bitmap->pitch; ++xc)
 			{
-				--xMaxb;
-				for (xb = 0; xb < xMaxb; ++xb)
-					pDsta[xb] = (((255<<(nOffa + 8))&pSrc[xb+1])>>(nOffa+8))
-							  | (pSrc[xb] << nOffa);
-				pDsta[xb] = pSrc[xb] << nOffa;
+				xa = xc - xb;
+				bitMove = 0;
+				if (xa >= 0 && xa < bitmap->pitch)
+					bitMove = (GB_BYTE)(pSrc[xa] >> nBit);
+				if (nBit && xa > 0 && xa <= bitmap->pitch)
+					bitMove |= (GB_BYTE)(pSrc[xa - 1] << (8 - nBit));
+				pDsta[xc] = bitMove;
 			}
 			pSrc += bitmap->pitch;
 			pDsta += bitmap->pitch;
@@ -253,69 +508,88 @@ int			GreyBitType_Layout_Italic(GB_Layout layout)
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Layout_ScaleBitmap
-** Description: Scale bitmaop character
+** Description: Scale bitmaop character. Only the rows sampling the inked rows
+**              of src are scaled, the others are cleared.
 ** Input: dst - destination bitmap
 **        src - source bitmap
-** Output: Scaled bitmap
+**        pnInkTop - first inked row of src
+**        pnInkHeight - inked row count of src
+** Output: Scaled bitmap, pnInkTop/pnInkHeight set to the inked rows of dst
 ** Return value: success/fail
 ** ---------------------------------------------------------------------------
 */
 
-int			GreyBitType_Layout_ScaleBitmap(GB_Bitmap dst, GB_Bitmap src)
+int			GreyBitType_Layout_ScaleBitmap(GB_Bitmap dst, GB_Bitmap src,
+										   GB_INT16* pnInkTop,
+										   GB_INT16* pnInkHeight)
 {
 	GB_INT32	i;
 	GB_INT32	j;
 	GB_INT32	ja;
+	GB_INT32	nStep;
+	GB_INT32	nFirst;
+	GB_INT32	nLast;
 	GB_BYTE *	pSrc;
 	GB_BYTE *	pDst;
 	
-	pSrc = src->buffer;
-	pDst = dst->buffer;
+	if ((dst->bitcount != 8 && dst->bitcount != 1)
+	 || (src->bitcount != 8 && src->bitcount != 1))
+		return GB_SUCCESS;
+	dst->width = src->width * dst->height / src->height;
+	dst->horioff = src->horioff * dst->height / src->height;
+	if (dst->bitcount == 8)
+	{
+		dst->pitch = dst->width;
+	}
+	else
+	{
+		dst->pitch = (dst->width + 7) >> 3;
+		if (!dst->pitch)
+			dst->pitch = 1;
+	}
+	nStep = (src->height << 10) / dst->height;
+	for (nFirst = 0; nFirst < dst->height
+		 && ((nStep * nFirst) >> 10) < *pnInkTop; ++nFirst)
+		;
+	for (nLast = nFirst; nLast < dst->height
+		 && ((nStep * nLast) >> 10) < *pnInkTop + *pnInkHeight; ++nLast)
+		;
+	pSrc = src->buffer + nFirst * src->pitch;
+	pDst = dst->buffer + nFirst * dst->pitch;
 	if (dst->bitcount == src->bitcount)
 	{
 		if (dst->bitcount == 8)
 		{
-			dst->width = src->width * dst->height / src->height;
-			dst->horioff = src->horioff * dst->height / src->height;
-			dst->pitch = dst->width;
-			for (i = 0; i < dst->height; ++i)
+			for (i = nFirst; i < nLast; ++i)
 			{
 				for (j = 0; j < dst->width; ++j)
-					pDst[j] = pSrc[(((src->height << 10) / dst->height*i)>>10)
-								  * src->pitch + (((src->width << 10)
-								  / dst->width*j)>>10)];
+					pDst[j] = src->buffer[((nStep * i) >> 10) * src->pitch
+										+ (((src->width << 10)
+										/ dst->width*j)>>10)];
 				pDst += dst->pitch;
 			}
 		}
-		else if (dst->bitcount == 1)
+		else
 		{
-			dst->width = src->width * dst->height / src->height;
-			dst->horioff = src->horioff * dst->height / src->height;
-			dst->pitch = dst->width >> 3;
-			if (!dst->pitch)
-				dst->pitch = 1;
-			for (i = 0; i < dst->height; ++i)
+			for (i = nFirst; i < nLast; ++i)
 			{
 				for (j = 0; j < dst->pitch; ++j)
 					pDst[j] = 0;
 				for (ja = 0; ja < dst->width; ++ja)
-					pDst[ja >> 3] |= ((pSrc[(((src->height << 10)/dst->height
-								  * i) >> 10) * src->pitch + (((src->width
-								  << 10) / dst->width * ja) >> 13)] >> (7
+					pDst[ja >> 3] |= ((src->buffer[((nStep * i) >> 10)
+								  * src->pitch + (((src->width << 10)
+								  / dst->width * ja) >> 13)] >> (7
 								  -(((src->width << 10) / dst->width * ja)
 								  >> 10) % 8))&1) << (7 - ja % 8);
 				pDst += dst->pitch;
 			}
 		}
 	}
-	else if (dst->bitcount == 8 && src->bitcount == 1)
+	else if (dst->bitcount == 8)
 	{
-		dst->width = src->width * dst->height / src->height;
-		dst->horioff = src->horioff * dst->height / src->height;
-		dst->pitch = dst->width;
 		if (dst->height == src->height)
 		{
-			for (i = 0; i < dst->height; ++i)
+			for (i = nFirst; i < nLast; ++i)
 			{
 				for (j = 0; j < dst->width; ++j)
 					pDst[j] = -(((pSrc[j >> 3] >> (7-j%8))&1) != 0);
@@ -325,11 +599,11 @@ int			GreyBitType_Layout_ScaleBitmap(GB_Bitmap dst, GB_Bitmap src)
 		}
 		else
 		{
-			for (i = 0; i < dst->height; ++i)
+			for (i = nFirst; i < nLast; ++i)
 			{
 				for (j = 0; j < dst->width; ++j)
-					pDst[j] = -(((pSrc[(((src->height << 10) / dst->height
-							* i) >> 10) * src->pitch + ( ((src->width 
+					pDst[j] = -(((src->buffer[((nStep * i) >> 10)
+							* src->pitch + ( ((src->width 
 							<< 10) / dst->width * j) >> 13)] >> (7
 							- (((src->width << 10) / dst->width * j) >> 10)
 							% 8))& 1) != 0);
@@ -337,16 +611,11 @@ int			GreyBitType_Layout_ScaleBitmap(GB_Bitmap dst, GB_Bitmap src)
 			}
 		}
 	}
-	else if (dst->bitcount == 1 && src->bitcount == 8)
+	else
 	{
-		dst->width = src->width * dst->height / src->height;
-		dst->horioff = src->horioff * dst->height / src->height;
-		dst->pitch = dst->width >> 3;
-		if (!dst->pitch)
-			dst->pitch = 1;
 		if (dst->height == src->height)
 		{
-			for (i = 0; i < dst->height; ++i)
+			for (i = nFirst; i < nLast; ++i)
 			{
 				for (j = 0; j < dst->pitch; ++j)
 					pDst[j] = 0;
@@ -361,24 +630,434 @@ int			GreyBitType_Layout_ScaleBitmap(GB_Bitmap dst, GB_Bitmap src)
 		}
 		else
 		{
-			for (i = 0; i < dst->height; ++i)
+			for (i = nFirst; i < nLast; ++i)
 			{
 				for (j = 0; j < dst->pitch; ++j)
 					pDst[j] = 0;
 				for (ja = 0; ja < dst->width; ++ja)
 				{
-					if (pSrc[(((src->height << 10) / dst->height * i) >> 10)
-							 * src->pitch + (((src->width << 10) / dst->width
-						     * ja) >> 10)] > BITMAP8TO1_SWITCH_VALUE)
+					if (src->buffer[((nStep * i) >> 10) * src->pitch
+								  + (((src->width << 10) / dst->width
+								  * ja) >> 10)] > BITMAP8TO1_SWITCH_VALUE)
 						pDst[ja >> 3] |= 1 << (7 - ja % 8);
 				}
 				pDst += dst->pitch;
 			}
 		}
 	}
+	GB_MEMSET(dst->buffer, 0, nFirst * dst->pitch);
+	GB_MEMSET(dst->buffer + nLast * dst->pitch, 0,
+			  (dst->height - nLast) * dst->pitch);
+	*pnInkTop = (GB_INT16)nFirst;
+	*pnInkHeight = (GB_INT16)(nLast - nFirst);
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Bitmap_CopyTo
+** Description: Copy a bitmap into a larger one, clipped to its bounds
+** Input: dst - destination bitmap
+**        src - source bitmap
+**        x - left of src in dst
+**        y - top of src in dst
+** Output: Copied bitmap
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Bitmap_CopyTo(GB_Bitmap dst, GB_Bitmap src,
+									  GB_INT16 x, GB_INT16 y)
+{
+	GB_BYTE		nPixel;
+	GB_BYTE		nMask;
+	GB_INT32	nBits;
+	GB_INT32	nShift;
+	GB_INT32	x0;
+	GB_INT32	x1;
+	GB_INT32	y0;
+	GB_INT32	y1;
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_INT32	k;
+	GB_BYTE *	pSrc;
+	GB_BYTE *	pDst;
+
+	if (dst->bitcount != src->bitcount)
+		return GB_FAILED;
+	nBits = src->bitcount;
+	nMask = (GB_BYTE)((1 << nBits) - 1);
+	x0 = x < 0 ? -x : 0;
+	y0 = y < 0 ? -y : 0;
+	x1 = src->width;
+	if (x + x1 > dst->width)
+		x1 = dst->width - x;
+	y1 = src->height;
+	if (y + y1 > dst->height)
+		y1 = dst->height - y;
+	for (i = y0; i < y1; ++i)
+	{
+		pSrc = src->buffer + i * src->pitch;
+		pDst = dst->buffer + (y + i) * dst->pitch;
+		if (nBits >= 8)
+		{
+			if (x1 > x0)
+				GB_MEMCPY(pDst + ((x + x0) * nBits >> 3),
+						  pSrc + (x0 * nBits >> 3), (x1 - x0) * nBits >> 3);
+			continue;
+		}
+		for (j = x0; j < x1; ++j)
+		{
+			nPixel = (pSrc[(j * nBits) >> 3]
+				   >> (8 - nBits - ((j * nBits) & 7))) & nMask;
+			k = (x + j) * nBits;
+			nShift = 8 - nBits - (k & 7);
+			pDst[k >> 3] = (pDst[k >> 3] & ~(nMask << nShift))
+						 | (nPixel << nShift);
+		}
+	}
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_Lcd
+** Description: Fill the inked rows of the LCD layout bitmap from an 8 bit
+**              bitmap. An outline rendered one pixel a subpixel goes
+**              through the 5 tap filter of the layout; a bitmap character
+**              is grey, each pixel given to all three channels.
+** Input: layout - layout
+**        src - 8 bit bitmap
+**        bFilter - src is three times as wide, to be filtered
+** Output: Layout bitmap, 3 bytes a pixel in RGB or BGR order
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_Lcd(GB_Layout layout, GB_Bitmap src,
+								   GB_BOOL bFilter)
+{
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_INT32	k;
+	GB_INT32	nSub;
+	GB_INT32	nSum;
+	GB_INT32	nFirst;
+	GB_INT32	nLast;
+	GB_BYTE *	pSrc;
+	GB_BYTE *	pDst;
+	GB_BYTE *	w;
+	GB_Bitmap	dst;
+
+	dst = layout->gbBitmap;
+	if (src->bitcount != 8)
+		return GB_FAILED;
+	dst->width = bFilter ? src->width / 3 : src->width;
+	dst->pitch = dst->width * 3;
+	dst->horioff = src->horioff;
+	nFirst = layout->nInkTop;
+	nLast = layout->nInkTop + layout->nInkHeight;
+	if (nLast > src->height)
+		nLast = src->height;
+	GB_MEMSET(dst->buffer, 0, nFirst * dst->pitch);
+	GB_MEMSET(dst->buffer + nLast * dst->pitch, 0,
+			  (dst->height - nLast) * dst->pitch);
+	nSub = dst->pitch;
+	w = layout->gbLcdWeights;
+	for (i = nFirst; i < nLast; ++i)
+	{
+		pSrc = src->buffer + i * src->pitch;
+		pDst = dst->buffer + i * dst->pitch;
+		if (!bFilter)
+		{
+			for (j = 0; j < dst->width; ++j)
+				pDst[3 * j] = pDst[3 * j + 1] = pDst[3 * j + 2] = pSrc[j];
+			continue;
+		}
+		for (j = 0; j < nSub; ++j)
+		{
+			if (j >= 2 && j < nSub - 2)
+				nSum = w[0] * pSrc[j - 2] + w[1] * pSrc[j - 1]
+					 + w[2] * pSrc[j] + w[3] * pSrc[j + 1]
+					 + w[4] * pSrc[j + 2];
+			else
+			{
+				nSum = 0;
+				for (k = -2; k <= 2; ++k)
+					if (j + k >= 0 && j + k < nSub)
+						nSum += w[k + 2] * pSrc[j + k];
+			}
+			nSum >>= 8;
+			pDst[j] = (GB_BYTE)(nSum > 255 ? 255 : nSum);
+		}
+		if (layout->bLcdBGR)
+		{
+			for (j = 0; j < nSub; j += 3)
+			{
+				nSum = pDst[j];
+				pDst[j] = pDst[j + 2];
+				pDst[j + 2] = (GB_BYTE)nSum;
+			}
+		}
+	}
+	return GB_SUCCESS;
+}
+
+#ifdef ENABLE_GREYVECTORFILE
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_Style
+** Description: Bold and italicize an outline before it is rendered: the
+**              outline is emboldened and sheared into the layout outline,
+**              and the ink box of data is moved to match. LCD layouts get
+**              the outline three times as wide, one pixel a subpixel.
+** Input: layout - layout
+**        data - decoded outline
+** Output: Styled outline in data
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_Style(GB_Layout layout, GB_Data data)
+{
+	GB_INT32		i;
+	GB_INT32		nStrength;
+	GB_Pos			xMin, yMin, xMax, yMax;
+	GB_Outline		source;
+	GB_Outline		outline;
+	GB_MatrixRec	matrix;
+
+	source = (GB_Outline)data->data;
+	if (!source || source->n_points <= 0)
+		return GB_FAILED;
+	if (!layout->gbOutline || source->n_contours > layout->nOutlineContours
+	 || source->n_points > layout->nOutlinePoints)
+	{
+		if (layout->gbOutline)
+			GreyBitType_Outline_Done(layout->gbLibrary, layout->gbOutline);
+		layout->gbOutline = GreyBitType_Outline_New(layout->gbLibrary,
+													source->n_contours,
+													source->n_points);
+		if (!layout->gbOutline)
+			return GB_FAILED;
+		layout->nOutlineContours = source->n_contours;
+		layout->nOutlinePoints = source->n_points;
+	}
+	outline = layout->gbOutline;
+	matrix.xx = 0x10000L;
+	matrix.xy = 0;
+	matrix.yx = 0;
+	matrix.yy = 0x10000L;
+	matrix.dx = 0;
+	matrix.dy = 0;
+	if (layout->bItalic)
+	{
+		/* top rows lean right, the middle row stays */
+		matrix.xy = -LAYOUT_ITALIC_SLANT;
+		matrix.dx = GB_MULFIX((GB_INT32)layout->nSize << 5,
+							  LAYOUT_ITALIC_SLANT);
+	}
+	GreyBitType_Outline_TransformEx(outline, source, &matrix);
+	if (layout->bBold)
+	{
+		nStrength = (GB_INT32)layout->nSize << 1;
+		if (nStrength > LAYOUT_BOLD_MAX)
+			nStrength = LAYOUT_BOLD_MAX;
+		GreyBitType_Outline_Embolden(outline, (GB_Pos)nStrength);
+	}
+	if (layout->nBitCount == GB_LCD_BITCOUNT)
+	{
+		matrix.xx = 3L << 16;
+		matrix.xy = 0;
+		matrix.dx = 0;
+		GreyBitType_Outline_TransformEx(outline, outline, &matrix);
+	}
+	xMin = xMax = outline->points[0].x;
+	yMin = yMax = outline->points[0].y;
+	for (i = 1; i < outline->n_points; ++i)
+	{
+		if (outline->points[i].x < xMin)
+			xMin = outline->points[i].x;
+		if (outline->points[i].x > xMax)
+			xMax = outline->points[i].x;
+		if (outline->points[i].y < yMin)
+			yMin = outline->points[i].y;
+		if (outline->points[i].y > yMax)
+			yMax = outline->points[i].y;
+	}
+	data->data = outline;
+	data->inkleft = (GB_INT16)(xMin >> 6);
+	data->inkwidth = (GB_INT16)(((xMax + 63) >> 6) - data->inkleft);
+	data->inktop = (GB_INT16)(yMin >> 6);
+	data->inkheight = (GB_INT16)(((yMax + 63) >> 6) - data->inktop);
+	return GB_SUCCESS;
+}
+#endif //ENABLE_GREYVECTORFILE
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_Process
+** Description: Turn decoded character data into the layout bitmap. Bold and
+**              italic outlines are styled before they are rendered, the
+**              bitmap passes are left for bitmap characters.
+** Input: layout - layout
+**        data - decoded data
+** Output: Layout bitmap
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_Process(GB_Layout layout, GB_Data data)
+{
+	GB_BOOL		bStyled;
+	GB_BOOL		bLcd;
+	GB_Bitmap	bitmap;
+#ifdef ENABLE_GREYVECTORFILE
+	GB_BBox		cbox;
+#endif //ENABLE_GREYVECTORFILE
+
+	bStyled = GB_FALSE;
+	bLcd = (GB_BOOL)(layout->nBitCount == GB_LCD_BITCOUNT);
+#ifdef ENABLE_GREYVECTORFILE
+	if (data->format == GB_FORMAT_BITMAP)
+	{
+		bitmap = (GB_Bitmap)data->data;
+	}
+	else
+	{
+		if (data->format != GB_FORMAT_OUTLINE
+		 && data->format != GB_FORMAT_PACKED)
+			return GB_FAILED;
+		if (layout->gbBitmap8)
+			bitmap = layout->gbBitmap8;
+		else
+			bitmap = layout->gbBitmap;
+		bitmap->width = bLcd ? data->width * 3 : data->width;
+		if (bitmap->bitcount == 1)
+			bitmap->pitch = (data->width + 7) >> 3;
+		else
+			bitmap->pitch = bitmap->width;
+		bitmap->horioff = data->horioff;
+		GB_MEMSET(bitmap->buffer, 0, bitmap->height * bitmap->pitch);
+		if ((layout->bBold || layout->bItalic || bLcd)
+		 && data->format == GB_FORMAT_OUTLINE)
+			bStyled = (GB_BOOL)(GreyBitType_Layout_Style(layout, data)
+							  == GB_SUCCESS);
+		cbox.xMin = data->inkleft;
+		cbox.yMin = data->inktop;
+		cbox.xMax = data->inkleft + data->inkwidth;
+		cbox.yMax = data->inktop + data->inkheight;
+		if (data->inkwidth <= 0 || data->inkheight <= 0)
+			;	/* nothing inked, the raster is skipped */
+		else if (data->format == GB_FORMAT_PACKED)
+			GreyBit_Raster_RenderPacked(layout->gbRaster, bitmap,
+										(GB_PackedOutline)data->data, &cbox);
+		else
+			GreyBit_Raster_Render(layout->gbRaster, bitmap, data->data,
+								  &cbox);
+	}
+#else
+	bitmap = (GB_Bitmap)data->data;
+#endif //ENABLE_GREYVECTORFILE
+	layout->nInkTop = data->inktop;
+	layout->nInkHeight = data->inkheight;
+	if (layout->nInkTop < 0 || layout->nInkHeight < 0
+	 || layout->nInkTop + layout->nInkHeight > bitmap->height)
+	{
+		layout->nInkTop = 0;
+		layout->nInkHeight = bitmap->height;
+	}
+	if (bLcd)
+	{
+		if (data->format == GB_FORMAT_BITMAP
+		 && (bitmap->bitcount != 8
+		  || bitmap->height != layout->gbBitmap->height))
+		{
+			GreyBitType_Layout_ScaleBitmap(layout->gbBitmap8, bitmap,
+										   &layout->nInkTop,
+										   &layout->nInkHeight);
+			bitmap = layout->gbBitmap8;
+		}
+		GreyBitType_Layout_Lcd(layout, bitmap,
+							   (GB_BOOL)(data->format != GB_FORMAT_BITMAP));
+	}
+	else if (bitmap == layout->gbBitmap)
+	{
+		/* outlines are rendered in place */
+	}
+	else if (bitmap->bitcount == layout->gbBitmap->bitcount
+	 && bitmap->height == layout->gbBitmap->height
+	 && bitmap->pitch * bitmap->height <= layout->nSwitchBufLen)
+	{
+		/* copied, the decoder bitmap stays the decoder's own */
+		layout->gbBitmap->pitch = bitmap->pitch;
+		layout->gbBitmap->width = bitmap->width;
+		layout->gbBitmap->horioff = bitmap->horioff;
+		GB_MEMCPY(layout->gbBitmap->buffer, bitmap->buffer,
+				  bitmap->pitch * bitmap->height);
+	}
+	else
+	{
+		GreyBitType_Layout_ScaleBitmap(layout->gbBitmap, bitmap,
+									   &layout->nInkTop, &layout->nInkHeight);
+	}
+	if (layout->bBold && !bStyled)
+		GreyBitType_Layout_Bold(layout);
+	if (layout->bItalic && !bStyled)
+		GreyBitType_Layout_Italic(layout);
 	return GB_SUCCESS;
 }
 
+#ifdef ENABLE_GREYVECTORFILE
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_RenderTo
+** Description: Render an outline straight into a caller 8 bit bitmap,
+**              within the ink box of data
+** Input: layout - layout
+**        data - decoded outline or packed outline
+**        pDst - destination bitmap
+**        x - left of the character in pDst
+**        y - top of the character in pDst
+** Output: Rendered character in pDst
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_RenderTo(GB_Layout layout, GB_Data data,
+										GB_Bitmap pDst, GB_INT16 x,
+										GB_INT16 y)
+{
+	GB_INT32		i;
+	GB_BitmapRec	view;
+	GB_BBox			cbox;
+
+	if (pDst->bitcount != 8 || x < 0 || y < 0
+	 || x + data->width > pDst->width || y + layout->nSize > pDst->height)
+		return GB_FAILED;
+	view.width = data->width;
+	view.height = layout->nSize;
+	view.horioff = data->horioff;
+	view.pitch = pDst->pitch;
+	view.bitcount = 8;
+	view.buffer = pDst->buffer + y * pDst->pitch + x;
+	for (i = 0; i < view.height; ++i)
+		GB_MEMSET(view.buffer + i * view.pitch, 0, view.width);
+	if (data->inkwidth <= 0 || data->inkheight <= 0)
+		return GB_SUCCESS;
+	cbox.xMin = data->inkleft;
+	cbox.yMin = data->inktop;
+	cbox.xMax = data->inkleft + data->inkwidth;
+	cbox.yMax = data->inktop + data->inkheight;
+	if (data->format == GB_FORMAT_PACKED)
+		return GreyBit_Raster_RenderPacked(layout->gbRaster, &view,
+										   (GB_PackedOutline)data->data,
+										   &cbox);
+	return GreyBit_Raster_Render(layout->gbRaster, &view,
+								 (GB_Outline)data->data, &cbox);
+}
+#endif //ENABLE_GREYVECTORFILE
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Layout_New
@@ -414,11 +1093,20 @@ GBHANDLE	GreyBitType_Layout_New(GBHANDLE loader, GB_INT16 nSize,
 		layout->bItalic = bItalic;
 		layout->gbBitmap = GreyBitType_Bitmap_New(layout->gbLibrary,
 												  2 *nSize,nSize,nBitCount,0);
-		if (nBitCount != 8)
+		if (nBitCount == GB_LCD_BITCOUNT)
+			layout->gbBitmap8 = GreyBitType_Bitmap_New(layout->gbLibrary,
+													   6 *nSize, nSize, 8, 0);
+		else if (nBitCount != 8 && nBitCount != 1)
 			layout->gbBitmap8 = GreyBitType_Bitmap_New(layout->gbLibrary,
 													   2 *nSize, nSize, 8, 0);
+		GB_MEMCPY(layout->gbLcdWeights, s_LcdWeights,
+				  sizeof(layout->gbLcdWeights));
+		layout->bLcdBGR = GB_FALSE;
 #ifdef ENABLE_GREYVECTORFILE
 		layout->gbRaster = (void *)GreyBit_Raster_New(layout->gbLibrary, 0);
+		if (layout->gbRaster && nSize <= me->nAccumMax)
+			GreyBit_Raster_SetEngine(layout->gbRaster, GB_RASTER_ACCUM);
+		layout->gbOutline = 0;
 #endif //ENABLE_GREYVECTORFILE
 		layout->nSwitchBufLen = layout->gbBitmap->height
 							  * layout->gbBitmap->pitch;
@@ -446,6 +1134,30 @@ GB_INT32	GreyBitType_Layout_GetWidth(GBHANDLE layout, GB_UINT32 nCode)
 	return GreyBit_Decoder_GetAdvance(me->gbDecoder, nCode, me->nSize);
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_Decode
+** Description: Decode a character for the layout: packed where the decoder
+**              has it, as an outline when it is to be bold, italic or LCD
+** Input: layout - layout
+**		  nCode - unicode code
+**	      pData - data buffer
+** Output: Decoded character
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_Decode(GB_Layout layout, GB_UINT32 nCode,
+									  GB_Data pData)
+{
+	if (layout->bBold || layout->bItalic
+	 || layout->nBitCount == GB_LCD_BITCOUNT)
+		return GreyBit_Decoder_Decode(layout->gbDecoder, nCode, pData,
+									  layout->nSize);
+	return GreyBit_Decoder_DecodePacked(layout->gbDecoder, nCode, pData,
+										layout->nSize);
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Layout_LoadChar
@@ -462,59 +1174,237 @@ int			GreyBitType_Layout_LoadChar(GBHANDLE layout, GB_UINT32 nCode,
 										GB_Bitmap * pBmp)
 {
 	GB_DataRec	data;
-	GB_Bitmap	bitmap;
 	GB_Layout	me = (GB_Layout)layout;
 
 	if (!me->gbBitmap)
 		return GB_FAILED;
 	if (me->dwCode != nCode)
 	{
-		if (GreyBit_Decoder_Decode(me->gbDecoder, nCode, &data, me->nSize)
-		 != GB_SUCCESS)
+		if (GreyBitType_Layout_Decode(me, nCode, &data) != GB_SUCCESS)
+			return GB_FAILED;
+		if (GreyBitType_Layout_Process(me, &data) != GB_SUCCESS)
+			return GB_FAILED;
+		me->dwCode = nCode;
+	}
+	if (pBmp)
+		*pBmp = me->gbBitmap;
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_LoadCharTo
+** Description: Load a character into a caller bitmap, e.g. a framebuffer
+**              or atlas, with its top left at x/y. Bitmap fonts at their own
+**              height and 8 bit outlines land there directly; bold, italic
+**              and scaled characters go through the layout bitmap and are
+**              copied, clipped to pDst.
+** Input: layout - layout
+**		  nCode - unicode code
+**        pDst - destination bitmap, same bit count as the layout
+**        x - left of the character in pDst
+**        y - top of the character in pDst
+** Output: Loaded character in pDst
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_LoadCharTo(GBHANDLE layout, GB_UINT32 nCode,
+										  GB_Bitmap pDst, GB_INT16 x,
+										  GB_INT16 y)
+{
+	GB_BOOL		bDirect;
+	GB_DataRec	data;
+	GB_Layout	me = (GB_Layout)layout;
+
+	if (!me->gbBitmap || !pDst || pDst->bitcount != me->nBitCount)
+		return GB_FAILED;
+	if (me->dwCode != nCode)
+	{
+		bDirect = (GB_BOOL)(!me->bBold && !me->bItalic
+						  && me->nBitCount != GB_LCD_BITCOUNT);
+		if (bDirect && GreyBit_Decoder_DecodeTo(me->gbDecoder, nCode, &data,
+												pDst, x, y, me->nSize)
+												== GB_SUCCESS)
+			return GB_SUCCESS;
+		if (GreyBitType_Layout_Decode(me, nCode, &data) != GB_SUCCESS)
 			return GB_FAILED;
 #ifdef ENABLE_GREYVECTORFILE
-		if (data.format == GB_FORMAT_BITMAP)
-		{
-			bitmap = (GB_Bitmap)data.data;
-		}
-		else
-		{
-			if (data.format != GB_FORMAT_OUTLINE)
-				return GB_FAILED;
-			if (me->gbBitmap8)
-				bitmap = me->gbBitmap8;
-			else
-				bitmap = me->gbBitmap;
-			bitmap->width = data.width;
-			bitmap->pitch = data.width;
-			bitmap->horioff = data.horioff;
-			GB_MEMSET(bitmap->buffer, 0, bitmap->height * bitmap->pitch);
-			GreyBit_Raster_Render(me->gbRaster, bitmap, data.data);
-		}
-#else
-		bitmap = (GB_Bitmap)data.data;
+		if (bDirect && (data.format == GB_FORMAT_OUTLINE
+					 || data.format == GB_FORMAT_PACKED)
+		 && GreyBitType_Layout_RenderTo(me, &data, pDst, x, y) == GB_SUCCESS)
+			return GB_SUCCESS;
 #endif //ENABLE_GREYVECTORFILE
-		if (bitmap->bitcount == me->gbBitmap->bitcount
-		 && bitmap->height == me->gbBitmap->height)
-		{
-			me->gbBitmap->pitch = bitmap->pitch;
-			me->gbBitmap->width = bitmap->width;
-			me->gbBitmap->horioff = bitmap->horioff;
-			bitmap->buffer=(GB_BYTE *)GreyBitType_Bitmap_SwitcBuffer
-									  (me->gbBitmap, bitmap->buffer);
-		}
-		else
+		if (GreyBitType_Layout_Process(me, &data) != GB_SUCCESS)
+			return GB_FAILED;
+		me->dwCode = nCode;
+	}
+	return GreyBitType_Bitmap_CopyTo(pDst, me->gbBitmap, x, y);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_BlitChar
+** Description: Blend a character over a caller 8 bit bitmap, e.g. a text
+**              surface, with its top left at x/y. Bitmap fonts at their own
+**              height are blended straight from their stored runs, without
+**              filling the layout bitmap; other characters are loaded as
+**              usual and blended from it. Clipped to pDst.
+** Input: layout - layout
+**		  nCode - unicode code
+**        pDst - destination bitmap, 8 bit
+**        x - left of the character in pDst
+**        y - top of the character in pDst
+** Output: Blended character in pDst
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_BlitChar(GBHANDLE layout, GB_UINT32 nCode,
+										GB_Bitmap pDst, GB_INT16 x,
+										GB_INT16 y)
+{
+	BLENDTARGET	target;
+	GB_Layout	me = (GB_Layout)layout;
+
+	if (!me->gbBitmap || !pDst || pDst->bitcount != 8
+	 || me->nBitCount != 8)
+		return GB_FAILED;
+	if (me->dwCode != nCode && !me->bBold && !me->bItalic)
+	{
+		target.gbDst = pDst;
+		target.x = x;
+		target.y = y;
+		if (GreyBit_Decoder_DecodeSpans(me->gbDecoder, nCode, 0,
+										GreyBitType_Bitmap_BlendSpans,
+										&target, me->nSize) == GB_SUCCESS)
+			return GB_SUCCESS;
+	}
+	if (GreyBitType_Layout_LoadChar(layout, nCode, 0) != GB_SUCCESS)
+		return GB_FAILED;
+	return GreyBitType_Bitmap_BlendTo(pDst, me->gbBitmap, x, y);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_RenderSpans
+** Description: Render a character as coverage spans passed to a callback,
+**              for callers compositing into their own framebuffer with
+**              their own blending. Outlines go from the raster straight to
+**              func, and bitmap fonts at their own height from their stored
+**              runs, with no layout bitmap filled; other characters are
+**              loaded first and their bitmap passed on. Coverage is 8 bit
+**              whatever the bit count of the layout.
+** Input: layout - layout
+**		  nCode - unicode code
+**        x - left of the character, in caller coordinates
+**        y - top of the character, in caller coordinates
+**        pClip - box spans are clipped to, in caller coordinates, 0 for none
+**        func - span callback, given caller coordinates
+**        user - callback data
+** Output: Spans passed to func
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_RenderSpans(GBHANDLE layout, GB_UINT32 nCode,
+										   GB_INT16 x, GB_INT16 y,
+										   const GB_BBox * pClip,
+										   GB_SpanFunc func, void * user)
+{
+	SPANTARGET	target;
+	GB_DataRec	data;
+	GB_Layout	me = (GB_Layout)layout;
+#ifdef ENABLE_GREYVECTORFILE
+	GB_BBox		clip;
+#endif //ENABLE_GREYVECTORFILE
+
+	if (!me->gbBitmap || !func || me->nBitCount == GB_LCD_BITCOUNT)
+		return GB_FAILED;
+	target.func = func;
+	target.user = user;
+	target.x = x;
+	target.y = y;
+	if (pClip)
+		target.clip = *pClip;
+	else
+	{
+		target.clip.xMin = -32768;
+		target.clip.yMin = -32768;
+		target.clip.xMax = 32767;
+		target.clip.yMax = 32767;
+	}
+	if (me->dwCode != nCode)
+	{
+		if (!me->bBold && !me->bItalic
+		 && GreyBit_Decoder_DecodeSpans(me->gbDecoder, nCode, 0,
+										GreyBitType_Layout_ClipSpans,
+										&target, me->nSize) == GB_SUCCESS)
+			return GB_SUCCESS;
+		if (GreyBitType_Layout_Decode(me, nCode, &data) != GB_SUCCESS)
+			return GB_FAILED;
+#ifdef ENABLE_GREYVECTORFILE
+		if (data.format == GB_FORMAT_OUTLINE
+		 || data.format == GB_FORMAT_PACKED)
 		{
-			GreyBitType_Layout_ScaleBitmap(me->gbBitmap, bitmap);
+			if ((me->bBold || me->bItalic)
+			 && data.format == GB_FORMAT_OUTLINE)
+				GreyBitType_Layout_Style(me, &data);
+			/* the box of the layout bitmap, within the caller clip */
+			clip.xMin = (GB_Pos)(target.clip.xMin > x
+							   ? target.clip.xMin - x : 0);
+			clip.yMin = (GB_Pos)(target.clip.yMin > y
+							   ? target.clip.yMin - y : 0);
+			clip.xMax = (GB_Pos)(target.clip.xMax - x < data.width
+							   ? target.clip.xMax - x : data.width);
+			clip.yMax = (GB_Pos)(target.clip.yMax - y < me->nSize
+							   ? target.clip.yMax - y : me->nSize);
+			if (data.inkwidth <= 0 || data.inkheight <= 0
+			 || clip.xMin >= clip.xMax || clip.yMin >= clip.yMax)
+				return GB_SUCCESS;
+			if (data.format == GB_FORMAT_PACKED)
+				return GreyBit_Raster_RenderPackedSpans(me->gbRaster,
+											(GB_PackedOutline)data.data,
+											GreyBitType_Layout_ClipSpans,
+											&target, &clip);
+			return GreyBit_Raster_RenderSpans(me->gbRaster,
+											  (GB_Outline)data.data,
+											  GreyBitType_Layout_ClipSpans,
+											  &target, &clip);
 		}
-		if (me->bBold)
-			GreyBitType_Layout_Bold(me);
-		if (me->bItalic)
-			GreyBitType_Layout_Italic(me);
+#endif //ENABLE_GREYVECTORFILE
+		if (GreyBitType_Layout_Process(me, &data) != GB_SUCCESS)
+			return GB_FAILED;
 		me->dwCode = nCode;
 	}
-	if (pBmp)
-		*pBmp = me->gbBitmap;
+	return GreyBitType_Layout_BitmapSpans(me, &target);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Layout_SetLcdFilter
+** Description: Set the subpixel filter of a GB_LCD_BITCOUNT layout
+** Input: layout - layout
+**        pWeights - 5 taps summing to 0x100, 0 for the default
+**        bBGR - panel subpixels are ordered blue, green, red
+** Output: Glyphs loaded afterwards use the filter
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Layout_SetLcdFilter(GBHANDLE layout,
+											const GB_BYTE * pWeights,
+											GB_BOOL bBGR)
+{
+	GB_Layout	me = (GB_Layout)layout;
+
+	if (!me || me->nBitCount != GB_LCD_BITCOUNT)
+		return GB_FAILED;
+	if (!pWeights)
+		pWeights = s_LcdWeights;
+	GB_MEMCPY(me->gbLcdWeights, pWeights, sizeof(me->gbLcdWeights));
+	me->bLcdBGR = bBGR;
+	me->dwCode = 0xffff;
 	return GB_SUCCESS;
 }
 
@@ -543,6 +1433,8 @@ void		GreyBitType_Layout_Done(GBHANDLE layout)
 #ifdef ENABLE_GREYVECTORFILE
 	if (me->gbRaster)
 		GreyBit_Raster_Done(me->gbRaster);
+	if (me->gbOutline)
+		GreyBitType_Outline_Done(me->gbLibrary, me->gbOutline);
 #endif //ENABLE_GREYVECTORFILE
 	GreyBit_Free(me->gbMem, me);
 }
\ No newline at end of file
@@ -8,6 +8,10 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				GB_PARAM_ACCUMMAX
+** 10/18/2026	me				Contexts
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
 ** 09/16/2023	me				Upgrade
 ** 08/08/2023	me              Init
 ** ===========================================================================
@@ -111,6 +115,7 @@ GBHANDLE	GreyBitType_Loader_New(GBHANDLE library,
 		return loader;
 	loader->gbLibrary = me;
 	loader->gbMem = loader->gbLibrary->gbMem;
+	loader->nAccumMax = GB_ACCUM_MAX;
 	loader->gbStream = (GB_Stream)GreyBit_Stream_New(filepathname, 0);
 	if (loader->gbStream)
 		loader->gbDecoder=GreyBitType_Loader_Probe(loader->gbLibrary,loader);
@@ -144,6 +149,7 @@ GBHANDLE    GreyBitType_Loader_New_Stream(GBHANDLE library, GBHANDLE stream,
 		return loader;
 	loader->gbLibrary = me;
 	loader->gbMem = loader->gbLibrary->gbMem;
+	loader->nAccumMax = GB_ACCUM_MAX;
 	loader->gbStream = (GB_Stream)GreyBit_Stream_New_Child(stream);
 	if (loader->gbStream)
 		GreyBit_Stream_Offset(loader->gbStream, 0, size);
@@ -179,6 +185,7 @@ GBHANDLE	GreyBitType_Loader_New_Memory(GBHANDLE library, void *pBuf,
 		return loader;
 	loader->gbLibrary = me;
 	loader->gbMem = loader->gbLibrary->gbMem;
+	loader->nAccumMax = GB_ACCUM_MAX;
 	loader->gbStream = (GB_Stream)GreyBit_Stream_New_Memory(pBuf, nBufSize);
 	if (loader->gbStream)
 		loader->gbDecoder = GreyBitType_Loader_Probe(loader->gbLibrary,
@@ -189,10 +196,47 @@ GBHANDLE	GreyBitType_Loader_New_Memory(GBHANDLE library, void *pBuf,
 	return 0;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Loader_NewContext
+** Description: Make a loader for another thread that shares the font of an
+**              open loader: tables and glyph cache are used in common, only
+**              the decode buffers are its own. Contexts must be done before
+**              the loader they were made from.
+** Input: loader - loader
+** Output: New loader context
+** Return value: loader context/0 if the font format has no contexts
+** ---------------------------------------------------------------------------
+*/
+
+GBHANDLE	GreyBitType_Loader_NewContext(GBHANDLE loader)
+{
+	GB_Loader	me = (GB_Loader)loader;
+	GB_Loader	context;
+
+	context = (GB_Loader)GreyBit_Malloc(me->gbMem, sizeof(GB_LoaderRec));
+	if (!context)
+		return context;
+	context->gbLibrary = me->gbLibrary;
+	context->gbMem = me->gbMem;
+	context->nAccumMax = me->nAccumMax;
+	context->gbDecoder = 0;
+	context->gbStream = (GB_Stream)GreyBit_Stream_New_Child(me->gbStream);
+	if (context->gbStream)
+		context->gbDecoder = GreyBit_Decoder_NewContext(me->gbDecoder,
+														context,
+														context->gbStream);
+	if (context->gbStream && context->gbDecoder)
+		return context;
+	GreyBitType_Loader_Done(context);
+	return 0;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Loader_SetParam
-** Description: Set loader param
+** Description: Set loader param. GB_PARAM_ACCUMMAX is kept by the loader
+**              for the layouts made after it, others go to the decoder.
 ** Input: loader - loader
 **        nParam - param type
 **        dwParam - param value
@@ -206,6 +250,11 @@ int			GreyBitType_Loader_SetParam(GBHANDLE loader, GB_Param nParam,
 {
 	GB_Loader	me = (GB_Loader)loader;
 
+	if (nParam == GB_PARAM_ACCUMMAX)
+	{
+		me->nAccumMax = (GB_INT32)dwParam;
+		return GB_SUCCESS;
+	}
 	return GreyBit_Decoder_SetParam(me->gbDecoder, nParam, dwParam);
 }
 
@@ -261,6 +310,60 @@ GB_BOOL		GreyBitType_Loader_IsExist(GBHANDLE loader, GB_UINT32 nCode)
 	return GreyBit_Decoder_GetWidth(me->gbDecoder, nCode, 100) != 0;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Loader_DecodeBatch
+** Description: Decode a run of characters into caller-provided storage.
+**              pData[i].data must point to a GB_BitmapRec (bitmap fonts) or
+**              GB_OutlineRec (vector fonts) owned by the caller. Its size on
+**              entry (pitch * height, or n_contours/n_points) is the space
+**              available; glyphs that are missing or don't fit get width 0.
+** Input: loader - loader
+**        pCodes - character codes
+**        nCount - code count
+**        pData - data array
+**        nSize - character size
+** Output: Decoded characters
+** Return value: number of characters decoded
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBitType_Loader_DecodeBatch(GBHANDLE loader,
+										   const GB_UINT32* pCodes,
+										   GB_INT32 nCount, GB_Data pData,
+										   GB_INT16 nSize)
+{
+	GB_Loader	me = (GB_Loader)loader;
+
+	if (!me->gbDecoder || !pCodes || !pData || nCount <= 0)
+		return 0;
+	return GreyBit_Decoder_DecodeBatch(me->gbDecoder, pCodes, nCount, pData,
+									   nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Loader_Preload
+** Description: Read a set of characters into the decoder cache at once. The
+**              cache must have been sized with GB_PARAM_CACHEITEM first.
+** Input: loader - loader
+**        pCodes - character codes
+**        nCount - code count
+** Output: Cached characters
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBitType_Loader_Preload(GBHANDLE loader, const GB_UINT32* pCodes,
+									   GB_INT32 nCount)
+{
+	GB_Loader	me = (GB_Loader)loader;
+
+	if (!me->gbDecoder || !pCodes)
+		return GB_FAILED;
+	return GreyBit_Decoder_Preload(me->gbDecoder, pCodes, nCount);
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitType_Loader_Done
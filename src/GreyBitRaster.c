@@ -8,6 +8,14 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Render spans to a callback
+** 10/18/2026	me				Growable raster pool, band split counts
+** 10/18/2026	me				1 bit targets rendered directly
+** 10/18/2026	me				Dense accumulation engine
+** 10/18/2026	me				State kept in the worker of each raster, rasters are re-entrant
+** 10/18/2026	me				Polyline outlines go straight to the line renderer
+** 10/18/2026	me				Render with a known box
+** 10/18/2026	me				Render packed GVF points scaled on the fly
 ** 03/27/2024	me				Warning pragma for MSC
 ** 09/16/2023	me				Return retypes
 ** 08/10/2023	me				Compile only if vector font is supported
@@ -87,6 +95,13 @@
 
 #define SCALED(x) ( ( (x) << shift ) - delta )
 
+/* all state lives in the worker of the raster being rendered */
+#define RAS_ARG		PWorker worker
+#define RAS_ARG_	PWorker worker,
+#define RAS_VAR		worker
+#define RAS_VAR_	worker,
+#define ras			(*worker)
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
@@ -150,8 +165,11 @@ typedef struct  TWorker_
 	int         lev_stack[32];
 
 	GB_OutlineRec  outline;
+	GB_PackedOutline packed;
+	int            lines;
 	GB_BitmapRec   target;
 	GB_BBox     clip_box;
+	GB_BBox*    cbox;
 
 	GB_Span     gray_spans[GB_MAX_GRAY_SPANS];
 	int         num_gray_spans;
@@ -172,14 +190,20 @@ typedef struct  TWorker_
 	PCell*     ycells;
 	TPos       ycount;
 
+	int        engine;        /* GB_RASTER_CELLS or GB_RASTER_ACCUM     */
+	TArea*     accum;         /* band rows of count_ex + 2 accumulators */
+	TPos       accum_pitch;
+
+	GB_Memory  memory;        /* pool grows up to buffer_max from here  */
+	long       buffer_max;
+	int        overflow;      /* the band ran out of cells              */
+	GB_RasterStatsRec  stats;
+
 } TWorker, *PWorker;
 
 typedef struct TRaster_
 {
 	GB_Memory gbMem;
-	void *buffer;
-	long buffer_size;
-	int band_size;
 	PWorker worker;
 }TRaster, *PRaster;
 
@@ -200,8 +224,6 @@ typedef struct TBand_
 **---------------------------------------------------------------------------
 */
 
-static TWorker	ras;
-
 /*
 **---------------------------------------------------------------------------
 **  Function(internal use only) Declarations
@@ -212,14 +234,15 @@ static TWorker	ras;
 ** ---------------------------------------------------------------------------
 ** Function: gray_init_cells
 ** Description: Initialize raster cell table
-** Input: buffer - buffer
+** Input: worker - worker
+**        buffer - buffer
 **		  byte_size - buffer size
 ** Output: Init'ed raster tbl
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_init_cells(void *buffer, int byte_size)
+static void	gray_init_cells(RAS_ARG_ void *buffer, int byte_size)
 {
 	ras.buffer      = buffer;
     ras.buffer_size = byte_size;
@@ -233,23 +256,110 @@ static void	gray_init_cells(void *buffer, int byte_size)
     ras.invalid     = 1;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: gray_grow_pool
+** Description: Grow the render pool of the worker to size bytes, at most
+**              MAX_POOL_SIZE. The pool keeps its size for the glyphs after,
+**              so a large size splits bands only until the pool fits it.
+** Input: worker - worker
+**        size - pool size wanted
+** Output: Bigger pool
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+static int	gray_grow_pool(RAS_ARG_ long size)
+{
+	void *	buffer;
+
+	if (size > ras.buffer_max)
+		size = ras.buffer_max;
+	size = size >> 4 << 4;
+	if (size <= ras.buffer_size)
+		return GB_FAILED;
+	buffer = GreyBit_Malloc(ras.memory, size);
+	if (!buffer)
+		return GB_FAILED;
+	GreyBit_Free(ras.memory, ras.buffer);
+	ras.buffer = buffer;
+	ras.buffer_size = size;
+	ras.stats.nGrows++;
+	ras.stats.nPoolSize = size;
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: gray_compute_packed_cbox
+** Description: Compute the bound box of a packed outline. The scale keeps
+**              the order of coordinates, so the extreme bytes are found
+**              first and only those are scaled.
+** Input: worker - worker
+** Output: Raster outline bound box x/y start and end
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+static void	gray_compute_packed_cbox(RAS_ARG)
+{
+	GB_PackedOutline  packed = ras.packed;
+	GB_BYTE*          vec = packed->points;
+	GB_BYTE*          limit = vec + packed->n_points * 2;
+	GB_BYTE           min_x, max_x, min_y, max_y;
+
+
+	if (packed->n_points <= 0)
+	{
+		ras.min_ex = ras.max_ex = 0;
+		ras.min_ey = ras.max_ey = 0;
+		return;
+	}
+
+	min_x = max_x = vec[0] >> 1;
+	min_y = max_y = vec[1] >> 1;
+
+	for (vec += 2; vec < limit; vec += 2)
+	{
+		GB_BYTE  x = vec[0] >> 1;
+		GB_BYTE  y = vec[1] >> 1;
+
+
+		if (x < min_x) min_x = x;
+		if (x > max_x) max_x = x;
+		if (y < min_y) min_y = y;
+		if (y > max_y) max_y = y;
+	}
+
+	/* truncate the bounding box to integer pixels */
+	ras.min_ex = GB_PACKED_POS(packed, min_x << 1) >> 6;
+	ras.min_ey = GB_PACKED_POS(packed, min_y << 1) >> 6;
+	ras.max_ex = (GB_PACKED_POS(packed, max_x << 1) + 63) >> 6;
+	ras.max_ey = (GB_PACKED_POS(packed, max_y << 1) + 63) >> 6;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: gray_compute_cbox
 ** Description: Computer raster outline bound box
-** Input: none
+** Input: worker - worker
 ** Output: Raster outline bound box x/y start and end
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_compute_cbox()
+static void	gray_compute_cbox(RAS_ARG)
 {
 	GB_Outline  outline = &ras.outline;
 	GB_Vector*  vec = outline->points;
 	GB_Vector*  limit = vec + outline->n_points;
 
 
+	if (ras.packed)
+	{
+		gray_compute_packed_cbox(RAS_VAR);
+		return;
+	}
 	if (outline->n_points <= 0)
 	{
 		ras.min_ex = ras.max_ex = 0;
@@ -285,13 +395,13 @@ static void	gray_compute_cbox()
 ** ---------------------------------------------------------------------------
 ** Function: gray_find_cell
 ** Description: Find cell in table
-** Input: none
+** Input: worker - worker
 ** Output: Cell
-** Return value: none
+** Return value: cell, 0 (overflow set) when the band has no cell left
 ** ---------------------------------------------------------------------------
 */
 
-static PCell gray_find_cell()
+static PCell gray_find_cell(RAS_ARG)
 {
     PCell* pcell, cell;
     TPos   x = ras.ex;
@@ -315,7 +425,8 @@ static PCell gray_find_cell()
 
     if (ras.num_cells >= ras.max_cells)
     {
-        return cell;
+        ras.overflow = 1;
+        return 0;
     }
 
     cell = ras.cells + ras.num_cells++;
@@ -334,19 +445,35 @@ Exit:
 ** ---------------------------------------------------------------------------
 ** Function: gray_record_cell
 ** Description: Record the current cell in the table
-** Input: none
+** Input: worker - worker
 ** Output: Cell
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void gray_record_cell()
+static void gray_record_cell(RAS_ARG)
 {
 	if ( !ras.invalid && ( ras.area | ras.cover ) )
     {
-      PCell  cell = gray_find_cell();
+      PCell  cell;
 
 
+      if ( ras.accum )
+      {
+        /* the cell adds its cover from x on, its area at x only; slot 0 */
+        /* is the column left of the clip box                            */
+        TArea*  a = ras.accum + ras.ey * ras.accum_pitch + ras.ex + 1;
+
+
+        a[0] += (TArea)( ras.cover * ( ONE_PIXEL * 2 ) - ras.area );
+        a[1] += ras.area;
+        ras.num_cells++;
+        return;
+      }
+      cell = gray_find_cell(RAS_VAR);
+      if ( !cell )
+        return;
+
       cell->area  += ras.area;
       cell->cover += ras.cover;
     }
@@ -356,14 +483,15 @@ static void gray_record_cell()
 ** ---------------------------------------------------------------------------
 ** Function: gray_set_cell
 ** Description: Set cell position
-** Input: ex - X end
+** Input: worker - worker
+**        ex - X end
 **        ey - Y end
 ** Output: Set cell position
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_set_cell(TCoord ex, TCoord ey)
+static void	gray_set_cell(RAS_ARG_ TCoord ex, TCoord ey)
 {
 	/* Move the cell pointer to a new position.  We set the `invalid'      */
     /* flag to indicate that the cell isn't part of those we're interested */
@@ -391,7 +519,7 @@ static void	gray_set_cell(TCoord ex, TCoord ey)
     {
       /* record the current one if it is valid */
       if ( !ras.invalid )
-        gray_record_cell();
+        gray_record_cell(RAS_VAR);
 
       ras.area  = 0;
       ras.cover = 0;
@@ -407,14 +535,15 @@ static void	gray_set_cell(TCoord ex, TCoord ey)
 ** ---------------------------------------------------------------------------
 ** Function: gray_start_cell
 ** Description: Start a new contour in cell
-** Input: ex - X end
+** Input: worker - worker
+**        ex - X end
 **        ey - Y end
 ** Output: Started contour
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_start_cell(TCoord ex, TCoord ey)
+static void	gray_start_cell(RAS_ARG_ TCoord ex, TCoord ey)
 {
 	if ( ex > ras.max_ex )
       ex = (TCoord)( ras.max_ex );
@@ -429,14 +558,15 @@ static void	gray_start_cell(TCoord ex, TCoord ey)
     ras.last_ey = SUBPIXELS( ey );
     ras.invalid = 0;
 
-    gray_set_cell( ex, ey );
+    gray_set_cell( RAS_VAR_ ex, ey );
 }
 
 /*
 ** ---------------------------------------------------------------------------
 ** Function: gray_render_scanline
 ** Description: Render a scanline of cell
-** Input: ey - Y end
+** Input: worker - worker
+**        ey - Y end
 **        x1 - X 1
 **        y1 - Y 1
 **        x2 - X 2
@@ -446,8 +576,8 @@ static void	gray_start_cell(TCoord ex, TCoord ey)
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_render_scanline(TCoord ey, TPos x1, TCoord y1, TPos x2,
-							     TCoord y2)
+static void	gray_render_scanline(RAS_ARG_ TCoord ey, TPos x1, TCoord y1,
+								 TPos x2, TCoord y2)
 {
 	TCoord  ex1, ex2, fx1, fx2, delta, mod, lift, rem;
     long    p, first, dx;
@@ -464,7 +594,7 @@ static void	gray_render_scanline(TCoord ey, TPos x1, TCoord y1, TPos x2,
     /* trivial case.  Happens often */
     if ( y1 == y2 )
     {
-      gray_set_cell( ex2, ey );
+      gray_set_cell( RAS_VAR_ ex2, ey );
       return;
     }
 
@@ -505,7 +635,7 @@ static void	gray_render_scanline(TCoord ey, TPos x1, TCoord y1, TPos x2,
     ras.cover += delta;
 
     ex1 += incr;
-    gray_set_cell( ex1, ey );
+    gray_set_cell( RAS_VAR_ ex1, ey );
     y1  += delta;
 
     if ( ex1 != ex2 )
@@ -535,7 +665,7 @@ static void	gray_render_scanline(TCoord ey, TPos x1, TCoord y1, TPos x2,
         ras.cover += delta;
         y1        += delta;
         ex1       += incr;
-        gray_set_cell( ex1, ey );
+        gray_set_cell( RAS_VAR_ ex1, ey );
       }
     }
 
@@ -548,14 +678,15 @@ static void	gray_render_scanline(TCoord ey, TPos x1, TCoord y1, TPos x2,
 ** ---------------------------------------------------------------------------
 ** Function: gray_render_line
 ** Description: Render a line of cell
-** Input: to_x - X 
+** Input: worker - worker
+**        to_x - X 
 **        to_y - Y
 ** Output: Rendered line
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_render_line(TPos to_x, TPos to_y)
+static void	gray_render_line(RAS_ARG_ TPos to_x, TPos to_y)
 {
 	TCoord  ey1, ey2, fy1, fy2, mod;
     TPos    dx, dy, x, x2;
@@ -593,7 +724,7 @@ static void	gray_render_line(TPos to_x, TPos to_y)
     /* everything is on a single scanline */
     if ( ey1 == ey2 )
     {
-      gray_render_scanline( ey1, ras.x, fy1, to_x, fy2 );
+      gray_render_scanline( RAS_VAR_ ey1, ras.x, fy1, to_x, fy2 );
       goto End;
     }
 
@@ -619,7 +750,7 @@ static void	gray_render_line(TPos to_x, TPos to_y)
       ras.cover += delta;
       ey1       += incr;
 
-      gray_set_cell( ex, ey1 );
+      gray_set_cell( RAS_VAR_ ex, ey1 );
 
       delta = (int)( first + first - ONE_PIXEL );
       area  = (TArea)two_fx * delta;
@@ -629,7 +760,7 @@ static void	gray_render_line(TPos to_x, TPos to_y)
         ras.cover += delta;
         ey1       += incr;
 
-        gray_set_cell( ex, ey1 );
+        gray_set_cell( RAS_VAR_ ex, ey1 );
       }
 
       delta      = (int)( fy2 - ONE_PIXEL + first );
@@ -661,10 +792,10 @@ static void	gray_render_line(TPos to_x, TPos to_y)
     }
 
     x = ras.x + delta;
-    gray_render_scanline( ey1, ras.x, fy1, x, (TCoord)first );
+    gray_render_scanline( RAS_VAR_ ey1, ras.x, fy1, x, (TCoord)first );
 
     ey1 += incr;
-    gray_set_cell( TRUNC( x ), ey1 );
+    gray_set_cell( RAS_VAR_ TRUNC( x ), ey1 );
 
     if ( ey1 != ey2 )
     {
@@ -689,17 +820,17 @@ static void	gray_render_line(TPos to_x, TPos to_y)
         }
 
         x2 = x + delta;
-        gray_render_scanline( ey1, x,
+        gray_render_scanline( RAS_VAR_ ey1, x,
                                        (TCoord)( ONE_PIXEL - first ), x2,
                                        (TCoord)first );
         x = x2;
 
         ey1 += incr;
-        gray_set_cell( TRUNC( x ), ey1 );
+        gray_set_cell( RAS_VAR_ TRUNC( x ), ey1 );
       }
     }
 
-    gray_render_scanline( ey1, x,
+    gray_render_scanline( RAS_VAR_ ey1, x,
                                    (TCoord)( ONE_PIXEL - first ), to_x,
                                    fy2 );
 
@@ -719,7 +850,7 @@ static void	gray_render_line(TPos to_x, TPos to_y)
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_split_conic(GB_Vector* base)
+static void	gray_split_conic(RST_Vector* base)
 {
 	TPos  a, b;
 
@@ -741,19 +872,21 @@ static void	gray_split_conic(GB_Vector* base)
 ** ---------------------------------------------------------------------------
 ** Function: gray_render_conic
 ** Description: Render conic
-** Input: control - control vector
+** Input: worker - worker
+**        control - control vector
 **        to - dest vector
 ** Output: Rendered conic
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_render_conic(const GB_Vector* control, const GB_Vector* to)
+static void	gray_render_conic(RAS_ARG_ const GB_Vector* control,
+							  const GB_Vector* to)
 {
 	TPos        dx, dy;
     int         top, level;
     int*        levels;
-    GB_Vector*  arc;
+    RST_Vector* arc;
 
 
     dx = DOWNSCALE( ras.x ) + to->x - ( control->x << 1 );
@@ -786,8 +919,8 @@ static void	gray_render_conic(const GB_Vector* control, const GB_Vector* to)
       mid_x = ( ras.x + to_x + 2 * UPSCALE( control->x ) ) / 4;
       mid_y = ( ras.y + to_y + 2 * UPSCALE( control->y ) ) / 4;
 
-      gray_render_line( mid_x, mid_y );
-      gray_render_line( to_x, to_y );
+      gray_render_line( RAS_VAR_ mid_x, mid_y );
+      gray_render_line( RAS_VAR_ to_x, to_y );
 
       return;
     }
@@ -843,8 +976,8 @@ static void	gray_render_conic(const GB_Vector* control, const GB_Vector* to)
         mid_x = ( ras.x + to_x + 2 * arc[1].x ) / 4;
         mid_y = ( ras.y + to_y + 2 * arc[1].y ) / 4;
 
-        gray_render_line( mid_x, mid_y );
-        gray_render_line( to_x, to_y );
+        gray_render_line( RAS_VAR_ mid_x, mid_y );
+        gray_render_line( RAS_VAR_ to_x, to_y );
 
         top--;
         arc -= 2;
@@ -864,7 +997,7 @@ static void	gray_render_conic(const GB_Vector* control, const GB_Vector* to)
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_split_cubic(GB_Vector* base)
+static void	gray_split_cubic(RST_Vector* base)
 {
 	TPos  a, b, c, d;
 
@@ -894,7 +1027,8 @@ static void	gray_split_cubic(GB_Vector* base)
 ** ---------------------------------------------------------------------------
 ** Function: gray_render_cubic
 ** Description: Render cubic
-** Input: control1 - control vector 1
+** Input: worker - worker
+**        control1 - control vector 1
 **        control2 - control vector 2
 **        to - dest vector
 ** Output: Rendered cubic
@@ -902,13 +1036,13 @@ static void	gray_split_cubic(GB_Vector* base)
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_render_cubic(const GB_Vector* control1,
+static void	gray_render_cubic(RAS_ARG_ const GB_Vector* control1,
 							  const GB_Vector* control2, const GB_Vector* to)
 {
 	TPos        dx, dy, da, db;
     int         top, level;
     int*        levels;
-    GB_Vector*  arc;
+    RST_Vector* arc;
 
 
     dx = DOWNSCALE( ras.x ) + to->x - ( control1->x << 1 );
@@ -953,8 +1087,8 @@ static void	gray_render_cubic(const GB_Vector* control1,
       mid_y = ( ras.y + to_y +
                 3 * UPSCALE( control1->y + control2->y ) ) / 8;
 
-      gray_render_line( mid_x, mid_y );
-      gray_render_line( to_x, to_y );
+      gray_render_line( RAS_VAR_ mid_x, mid_y );
+      gray_render_line( RAS_VAR_ to_x, to_y );
       return;
     }
 
@@ -1010,8 +1144,8 @@ static void	gray_render_cubic(const GB_Vector* control1,
         mid_x = ( ras.x + to_x + 3 * ( arc[1].x + arc[2].x ) ) / 8;
         mid_y = ( ras.y + to_y + 3 * ( arc[1].y + arc[2].y ) ) / 8;
 
-        gray_render_line( mid_x, mid_y );
-        gray_render_line( to_x, to_y );
+        gray_render_line( RAS_VAR_ mid_x, mid_y );
+        gray_render_line( RAS_VAR_ to_x, to_y );
         top --;
         arc -= 3;
       }
@@ -1037,13 +1171,13 @@ static int	gray_move_to(const GB_Vector* to, PWorker worker)
 
 
     /* record current cell, if any */
-    gray_record_cell();
+    gray_record_cell(RAS_VAR);
 
     /* start to a new position */
     x = UPSCALE( to->x );
     y = UPSCALE( to->y );
 
-    gray_start_cell( TRUNC( x ), TRUNC( y ) );
+    gray_start_cell( RAS_VAR_ TRUNC( x ), TRUNC( y ) );
 
     worker->x = x;
     worker->y = y;
@@ -1057,14 +1191,14 @@ static int	gray_move_to(const GB_Vector* to, PWorker worker)
 ** Input: to - dest vector
 **        worker - worker
 ** Output: Moved line
-** Return value: success
+** Return value: success, overflow when the band is out of cells
 ** ---------------------------------------------------------------------------
 */
 
 static int  gray_line_to(const GB_Vector* to, PWorker worker)
 {
-	gray_render_line( UPSCALE(to->x), UPSCALE(to->y));
-	return GB_SUCCESS;
+	gray_render_line(RAS_VAR_ UPSCALE(to->x), UPSCALE(to->y));
+	return ras.overflow ? ErrRaster_Memory_Overflow : GB_SUCCESS;
 }
 
 /*
@@ -1075,15 +1209,15 @@ static int  gray_line_to(const GB_Vector* to, PWorker worker)
 **        to - dest vector
 **        worker - worker
 ** Output: Moved conic
-** Return value: success
+** Return value: success, overflow when the band is out of cells
 ** ---------------------------------------------------------------------------
 */
 
 static int	gray_conic_to(const GB_Vector* control, const GB_Vector* to,
 						  PWorker worker)
 {
-	gray_render_conic( control, to);
-	return GB_SUCCESS;
+	gray_render_conic(RAS_VAR_ control, to);
+	return ras.overflow ? ErrRaster_Memory_Overflow : GB_SUCCESS;
 }
 
 /*
@@ -1095,15 +1229,15 @@ static int	gray_conic_to(const GB_Vector* control, const GB_Vector* to,
 **        to - dest vector
 **        worker - worker
 ** Output: Moved cubic
-** Return value: success
+** Return value: success, overflow when the band is out of cells
 ** ---------------------------------------------------------------------------
 */
 
 static int	gray_cubic_to(const GB_Vector* control1,const GB_Vector* control2,
 						  const GB_Vector* to, PWorker worker)
 {
-	gray_render_cubic(control1, control2, to);
-	return GB_SUCCESS;
+	gray_render_cubic(RAS_VAR_ control1, control2, to);
+	return ras.overflow ? ErrRaster_Memory_Overflow : GB_SUCCESS;
 }
 
 /*
@@ -1164,11 +1298,52 @@ static void	gray_render_span(int y, int count, const GB_Span* spans,
     }
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: gray_render_span_mono
+** Description: Render span into a 1 bit bitmap, pixels covered more than
+**              BITMAP8TO1_SWITCH_VALUE set
+** Input: y - Y
+**        count - span count
+**        spans - spans
+**        worker - worker
+** Output: Rendered span
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+static void	gray_render_span_mono(int y, int count, const GB_Span* spans,
+								  PWorker worker)
+{
+	unsigned char*  p;
+	int             x;
+	int             x1;
+
+
+    p = (unsigned char*)worker->target.buffer + y * worker->target.pitch;
+
+    for ( ; count > 0; count--, spans++ )
+    {
+      if ( spans->coverage <= BITMAP8TO1_SWITCH_VALUE )
+        continue;
+
+      x  = spans->x;
+      x1 = x + spans->len;
+      for ( ; x < x1 && ( x & 7 ); x++ )
+        p[x >> 3] |= (unsigned char)( 0x80 >> ( x & 7 ) );
+      for ( ; x + 8 <= x1; x += 8 )
+        p[x >> 3] = 0xFF;
+      for ( ; x < x1; x++ )
+        p[x >> 3] |= (unsigned char)( 0x80 >> ( x & 7 ) );
+    }
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: gray_hline
 ** Description: Render hline
-** Input: x - X
+** Input: worker - worker
+**        x - X
 **        y - Y
 **        area - horiz line area
 **        acount - area coord
@@ -1177,7 +1352,7 @@ static void	gray_render_span(int y, int count, const GB_Span* spans,
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_hline(TCoord x, TCoord y, TPos area, TCoord acount)
+static void	gray_hline(RAS_ARG_ TCoord x, TCoord y, TPos area, TCoord acount)
 {
 	GB_Span*  span;
     int       count;
@@ -1253,13 +1428,13 @@ static void	gray_hline(TCoord x, TCoord y, TPos area, TCoord acount)
 ** ---------------------------------------------------------------------------
 ** Function: gray_sweep
 ** Description: Render span
-** Input: none
+** Input: worker - worker
 ** Output: added sweep
 ** Return value: none
 ** ---------------------------------------------------------------------------
 */
 
-static void	gray_sweep()
+static void	gray_sweep(RAS_ARG)
 {
 	int yindex;
 
@@ -1281,20 +1456,20 @@ static void	gray_sweep()
 
 
         if ( cell->x > x && cover != 0 )
-          gray_hline( x, yindex, cover * ( ONE_PIXEL * 2 ),
+          gray_hline( RAS_VAR_ x, yindex, cover * ( ONE_PIXEL * 2 ),
                       cell->x - x );
 
         cover += cell->cover;
         area   = cover * ( ONE_PIXEL * 2 ) - cell->area;
 
         if ( area != 0 && cell->x >= 0 )
-          gray_hline( cell->x, yindex, area, 1 );
+          gray_hline( RAS_VAR_ cell->x, yindex, area, 1 );
 
         x = cell->x + 1;
       }
 
       if ( cover != 0 )
-        gray_hline( x, yindex, cover * ( ONE_PIXEL * 2 ),
+        gray_hline( RAS_VAR_ x, yindex, cover * ( ONE_PIXEL * 2 ),
                     ras.count_ex - x );
     }
 
@@ -1303,6 +1478,59 @@ static void	gray_sweep()
                        ras.gray_spans, ras.render_span_data );
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: gray_sweep_accum
+** Description: Render the spans of the accumulation buffer, the prefix sum
+**              of a row giving the coverage of each of its pixels. The sum
+**              is plain C; a SIMD sum is left out, as the tree is C89 for
+**              targets without known vector units.
+** Input: worker - worker
+** Output: added sweep
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+static void	gray_sweep_accum(RAS_ARG)
+{
+	int     yindex;
+	TCoord  x;
+	TCoord  start;
+	TArea*  a;
+	TArea   acc;
+	TArea   run;
+
+	if (ras.num_cells == 0)
+		return;
+
+	ras.num_gray_spans = 0;
+
+	for ( yindex = 0; yindex < ras.ycount; yindex++ )
+    {
+      a     = ras.accum + yindex * ras.accum_pitch;
+      acc   = a[0];
+      run   = 0;
+      start = 0;
+      for ( x = 0; x < ras.count_ex; x++ )
+      {
+        acc += a[x + 1];
+        if ( acc != run )
+        {
+          if ( run != 0 )
+            gray_hline( RAS_VAR_ start, yindex, run, x - start );
+          run   = acc;
+          start = x;
+        }
+      }
+      if ( run != 0 )
+        gray_hline( RAS_VAR_ start, yindex, run, x - start );
+    }
+
+    if ( ras.render_span && ras.num_gray_spans > 0 )
+      ras.render_span( ras.span_y, ras.num_gray_spans,
+                       ras.gray_spans, ras.render_span_data );
+}
+
 GB_DEFINE_OUTLINE_FUNCS(func_interface,
     (GB_Outline_MoveTo_Func)gray_move_to,
     (GB_Outline_LineTo_Func)gray_line_to,
@@ -1314,9 +1542,11 @@ GB_DEFINE_OUTLINE_FUNCS(func_interface,
 
 /*
 ** ---------------------------------------------------------------------------
-** Function: GB_Outline_Decompose
-** Description: Decompose outline
-** Input: outline - outline
+** Function: gray_decompose
+** Description: Decompose an outline, or a packed outline whose points are
+**              unpacked and scaled as they are walked
+** Input: outline - outline, 0 if packed is given
+**        packed - packed outline, 0 if outline is given
 **        func_interface - raster funcs
 **        user - user
 ** Output: Decomposed glyph
@@ -1324,24 +1554,41 @@ GB_DEFINE_OUTLINE_FUNCS(func_interface,
 ** ---------------------------------------------------------------------------
 */
 
-int			GB_Outline_Decompose(GB_Outline outline,
-								 const GB_Outline_Funcs * func_interface,
-								 void * user)
+static int	gray_decompose(GB_Outline outline, GB_PackedOutline packed,
+						   const GB_Outline_Funcs * func_interface,
+						   void * user)
 {
 #undef SCALED
 #define SCALED( x )  ( ( (x) << shift ) - delta )
+#define POINT_TAG( i )  GB_CURVE_TAG( packed ? GB_PACKED_TAG( packed, i ) \
+                                             : outline->tags[i] )
+#define LOAD_POINT( v, i )                                              \
+          do {                                                          \
+            if ( packed )                                               \
+            {                                                           \
+              (v).x = SCALED( GB_PACKED_POS( packed,                    \
+                                             packed->points[(i) * 2] ) ); \
+              (v).y = SCALED( GB_PACKED_POS( packed,                    \
+                                         packed->points[(i) * 2 + 1] ) ); \
+            }                                                           \
+            else                                                        \
+            {                                                           \
+              (v).x = SCALED( outline->points[i].x );                   \
+              (v).y = SCALED( outline->points[i].y );                   \
+            }                                                           \
+          } while ( 0 )
 
 	GB_Vector   v_last;
     GB_Vector   v_control;
     GB_Vector   v_start;
 
-    GB_Vector*  point;
-    GB_Vector*  limit;
-    char*       tags;
+    int         point;
+    int         limit;
 
     int         error;
 
     int   n;         /* index of contour in outline     */
+    int   n_contours;
     int   first;     /* index of first point in contour */
     char  tag;       /* current point's state           */
 
@@ -1349,35 +1596,30 @@ int			GB_Outline_Decompose(GB_Outline outline,
     TPos  delta;
 
 
-    if ( !outline || !func_interface )
+    if ( ( !outline && !packed ) || !func_interface )
       return ErrRaster_Invalid_Argument;
 
     shift = func_interface->shift;
     delta = func_interface->delta;
     first = 0;
+    n_contours = packed ? packed->n_contours : outline->n_contours;
 
-    for ( n = 0; n < outline->n_contours; n++ )
+    for ( n = 0; n < n_contours; n++ )
     {
       int  last;  /* index of last point in contour */
 
-      last  = outline->contours[n];
+      last  = packed ? packed->contours[n] : outline->contours[n];
       if ( last < 0 )
         goto Invalid_Outline;
-      limit = outline->points + last;
-
-      v_start   = outline->points[first];
-      v_start.x = SCALED( v_start.x );
-      v_start.y = SCALED( v_start.y );
+      limit = last;
 
-      v_last   = outline->points[last];
-      v_last.x = SCALED( v_last.x );
-      v_last.y = SCALED( v_last.y );
+      LOAD_POINT( v_start, first );
+      LOAD_POINT( v_last, last );
 
       v_control = v_start;
 
-      point = outline->points + first;
-      tags  = outline->tags   + first;
-      tag   = GB_CURVE_TAG( tags[0] );
+      point = first;
+      tag   = POINT_TAG( point );
 
       /* A contour cannot start with a cubic control point! */
       if ( tag == GB_CURVE_TAG_CUBIC )
@@ -1387,7 +1629,7 @@ int			GB_Outline_Decompose(GB_Outline outline,
       if ( tag == GB_CURVE_TAG_CONIC )
       {
         /* first point is conic control.  Yes, this happens. */
-        if ( GB_CURVE_TAG( outline->tags[last] ) == GB_CURVE_TAG_ON )
+        if ( POINT_TAG( last ) == GB_CURVE_TAG_ON )
         {
           /* start at last point if it is on the curve */
           v_start = v_last;
@@ -1404,7 +1646,6 @@ int			GB_Outline_Decompose(GB_Outline outline,
           v_last = v_start;
         }
         point--;
-        tags--;
       }
 
       error = func_interface->move_to( &v_start, user );
@@ -1414,9 +1655,8 @@ int			GB_Outline_Decompose(GB_Outline outline,
       while ( point < limit )
       {
         point++;
-        tags++;
 
-        tag = GB_CURVE_TAG( tags[0] );
+        tag = POINT_TAG( point );
         switch ( tag )
         {
         case GB_CURVE_TAG_ON:  /* emit a single line_to */
@@ -1424,8 +1664,7 @@ int			GB_Outline_Decompose(GB_Outline outline,
             GB_Vector  vec;
 
 
-            vec.x = SCALED( point->x );
-            vec.y = SCALED( point->y );
+            LOAD_POINT( vec, point );
 
             error = func_interface->line_to( &vec, user );
             if ( error )
@@ -1434,8 +1673,7 @@ int			GB_Outline_Decompose(GB_Outline outline,
           }
 
         case GB_CURVE_TAG_CONIC:  /* consume conic arcs */
-          v_control.x = SCALED( point->x );
-          v_control.y = SCALED( point->y );
+          LOAD_POINT( v_control, point );
 
         Do_Conic:
           if ( point < limit )
@@ -1445,11 +1683,9 @@ int			GB_Outline_Decompose(GB_Outline outline,
 
 
             point++;
-            tags++;
-            tag = GB_CURVE_TAG( tags[0] );
+            tag = POINT_TAG( point );
 
-            vec.x = SCALED( point->x );
-            vec.y = SCALED( point->y );
+            LOAD_POINT( vec, point );
 
             if ( tag == GB_CURVE_TAG_ON )
             {
@@ -1482,25 +1718,20 @@ int			GB_Outline_Decompose(GB_Outline outline,
 
 
             if ( point + 1 > limit                             ||
-                 GB_CURVE_TAG( tags[1] ) != GB_CURVE_TAG_CUBIC )
+                 POINT_TAG( point + 1 ) != GB_CURVE_TAG_CUBIC )
               goto Invalid_Outline;
 
             point += 2;
-            tags  += 2;
 
-            vec1.x = SCALED( point[-2].x );
-            vec1.y = SCALED( point[-2].y );
-
-            vec2.x = SCALED( point[-1].x );
-            vec2.y = SCALED( point[-1].y );
+            LOAD_POINT( vec1, point - 2 );
+            LOAD_POINT( vec2, point - 1 );
 
             if ( point <= limit )
             {
               GB_Vector  vec;
 
 
-              vec.x = SCALED( point->x );
-              vec.y = SCALED( point->y );
+              LOAD_POINT( vec, point );
 
               error = func_interface->cubic_to( &vec1, &vec2, &vec, user );
               if ( error )
@@ -1531,24 +1762,117 @@ int			GB_Outline_Decompose(GB_Outline outline,
 
   Invalid_Outline:
     return ErrRaster_Invalid_Outline;
+
+#undef LOAD_POINT
+#undef POINT_TAG
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GB_Outline_Decompose
+** Description: Decompose outline
+** Input: outline - outline
+**        func_interface - raster funcs
+**        user - user
+** Output: Decomposed glyph
+** Return value: error level
+** ---------------------------------------------------------------------------
+*/
+
+int			GB_Outline_Decompose(GB_Outline outline,
+								 const GB_Outline_Funcs * func_interface,
+								 void * user)
+{
+	if (!outline)
+		return ErrRaster_Invalid_Argument;
+	return gray_decompose(outline, 0, func_interface, user);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GB_Outline_DecomposePacked
+** Description: Decompose a packed outline straight from its record bytes
+** Input: outline - packed outline
+**        func_interface - raster funcs
+**        user - user
+** Output: Decomposed glyph
+** Return value: error level
+** ---------------------------------------------------------------------------
+*/
+
+int			GB_Outline_DecomposePacked(GB_PackedOutline outline,
+									   const GB_Outline_Funcs * func_interface,
+									   void * user)
+{
+	if (!outline)
+		return ErrRaster_Invalid_Argument;
+	return gray_decompose(0, outline, func_interface, user);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: gray_decompose_lines
+** Description: Decompose an outline of on points only, as flattened GVF
+**              records are, feeding the points straight to the line
+**              renderer without looking at tags
+** Input: worker - worker
+**        outline - outline
+** Output: Decomposed glyph
+** Return value: error level
+** ---------------------------------------------------------------------------
+*/
+
+static int	gray_decompose_lines(RAS_ARG_ GB_Outline outline)
+{
+	int       n;
+	int       first;
+	int       last;
+	int       point;
+	GB_Point  points;
+
+	points = outline->points;
+	first = 0;
+	for (n = 0; n < outline->n_contours; n++)
+	{
+		last = outline->contours[n];
+		if (last < first)
+			return ErrRaster_Invalid_Outline;
+		gray_move_to(&points[first], worker);
+		for (point = first + 1; point <= last; point++)
+			gray_render_line(RAS_VAR_ UPSCALE(points[point].x),
+							 UPSCALE(points[point].y));
+		gray_render_line(RAS_VAR_ UPSCALE(points[first].x),
+						 UPSCALE(points[first].y));
+		if (ras.overflow)
+			return ErrRaster_Memory_Overflow;
+		first = last + 1;
+	}
+	return 0;
 }
 
 /*
 ** ---------------------------------------------------------------------------
 ** Function: gray_convert_glyph_inner
 ** Description: Inner glyph convert
-** Input: none
+** Input: worker - worker
 ** Output: Inner glyph convert
 ** Return value: error level
 ** ---------------------------------------------------------------------------
 */
 
-static int	gray_convert_glyph_inner()
+static int	gray_convert_glyph_inner(RAS_ARG)
 {
 	volatile int  error;
 
-	error = GB_Outline_Decompose(&ras.outline, &func_interface, &ras);
-    gray_record_cell();
+	if (ras.packed)
+		error = GB_Outline_DecomposePacked(ras.packed, &func_interface, worker);
+	else if (ras.lines)
+		error = gray_decompose_lines(RAS_VAR_ &ras.outline);
+	else
+		error = GB_Outline_Decompose(&ras.outline, &func_interface, worker);
+    gray_record_cell(RAS_VAR);
+	if (!error && ras.overflow)
+		error = ErrRaster_Memory_Overflow;
 	return error;
 }
 
@@ -1556,23 +1880,32 @@ static int	gray_convert_glyph_inner()
 ** ---------------------------------------------------------------------------
 ** Function: gray_convert_glyph
 ** Description: Glyph convert
-** Input: none
+** Input: worker - worker
 ** Output: Glyph convert
 ** Return value: error level
 ** ---------------------------------------------------------------------------
 */
 
-static int	gray_convert_glyph()
+static int	gray_convert_glyph(RAS_ARG)
 {
 	TBand            bands[40];
     TBand* volatile  band;
     int volatile     n, num_bands;
     TPos volatile    min, max, max_y;
+    TPos             band_rows;
     GB_BBox*         clip;
 
 
     /* Set up state in the raster object */
-    gray_compute_cbox();
+    if ( ras.cbox )
+    {
+      ras.min_ex = ras.cbox->xMin;
+      ras.min_ey = ras.cbox->yMin;
+      ras.max_ex = ras.cbox->xMax;
+      ras.max_ey = ras.cbox->yMax;
+    }
+    else
+      gray_compute_cbox(RAS_VAR);
 
     /* clip to target bitmap, exit if nothing to do */
     clip = &ras.clip_box;
@@ -1609,8 +1942,26 @@ static int	gray_convert_glyph()
       ras.cubic_level <<= level;
     }
 
-    /* set up vertical bands */
-    num_bands = (int)( ( ras.max_ey - ras.min_ey ) / ras.band_size );
+    /* set up vertical bands; the accumulation buffer takes as many rows */
+    /* as the pool holds                                                 */
+    ras.accum       = 0;
+    ras.accum_pitch = ras.count_ex + 2;
+    if ( ras.engine == GB_RASTER_ACCUM )
+    {
+      if ( ras.count_ey * ras.accum_pitch * (long)sizeof ( TArea )
+           > ras.buffer_size )
+        gray_grow_pool( RAS_VAR_ ras.count_ey * ras.accum_pitch
+                                 * (long)sizeof ( TArea ) );
+      band_rows = (TPos)( ras.buffer_size
+                        / ( ras.accum_pitch * sizeof ( TArea ) ) );
+      if ( band_rows <= 0 )
+        return 1;
+      if ( band_rows > ras.band_size )
+        band_rows = ras.band_size;
+    }
+    else
+      band_rows = ras.band_size;
+    num_bands = (int)( ( ras.max_ey - ras.min_ey ) / band_rows );
     if ( num_bands == 0 )
       num_bands = 1;
     if ( num_bands >= 39 )
@@ -1623,7 +1974,7 @@ static int	gray_convert_glyph()
 
     for ( n = 0; n < num_bands; n++, min = max )
     {
-      max = min + ras.band_size;
+      max = min + band_rows;
       if ( n == num_bands - 1 || max > max_y )
         max = max_y;
 
@@ -1636,6 +1987,17 @@ static int	gray_convert_glyph()
         TPos  bottom, top, middle;
         int   error;
 
+        if ( ras.engine == GB_RASTER_ACCUM )
+        {
+          ras.ycount = band->max - band->min;
+          if ( ras.ycount * ras.accum_pitch * (long)sizeof ( TArea )
+               > ras.buffer_size )
+            goto ReduceBands;
+          ras.accum = (TArea*)ras.buffer;
+          GB_MEM_ZERO( ras.accum, ras.ycount * ras.accum_pitch
+                                  * sizeof ( TArea ) );
+        }
+        else
         {
           PCell  cells_max;
           int    yindex;
@@ -1667,16 +2029,21 @@ static int	gray_convert_glyph()
         }
 
         ras.num_cells = 0;
+        ras.overflow  = 0;
         ras.invalid   = 1;
         ras.min_ey    = band->min;
         ras.max_ey    = band->max;
         ras.count_ey  = band->max - band->min;
 
-        error = gray_convert_glyph_inner();
+        error = gray_convert_glyph_inner(RAS_VAR);
 
         if ( !error )
         {
-          gray_sweep( &ras.target );
+          if ( ras.accum )
+            gray_sweep_accum(RAS_VAR);
+          else
+            gray_sweep(RAS_VAR);
+          ras.stats.nBands++;
           band--;
           continue;
         }
@@ -1684,7 +2051,14 @@ static int	gray_convert_glyph()
           return 1;
 
       ReduceBands:
-        /* render pool overflow; we will reduce the render band by half */
+        /* render pool overflow; grow the pool and render the band again, */
+        /* or once it is as big as it gets, reduce the band by half        */
+        if ( gray_grow_pool( RAS_VAR_ ras.buffer_size * 2 ) == GB_SUCCESS )
+        {
+          ras.band_size = (int)( ras.buffer_size >> 7 );
+          continue;
+        }
+
         bottom = band->min;
         top    = band->max;
         middle = bottom + ( ( top - bottom ) >> 1 );
@@ -1699,6 +2073,7 @@ static int	gray_convert_glyph()
         if ( bottom-top >= ras.band_size )
           ras.band_shoot++;
 
+        ras.stats.nSplits++;
         band[1].min = bottom;
         band[1].max = middle;
         band[0].min = middle;
@@ -1713,23 +2088,64 @@ static int	gray_convert_glyph()
     return 0;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: gray_convert_spans
+** Description: Convert the outline set in the worker, passing its spans to
+**              a callback instead of a target bitmap
+** Input: worker - worker
+**        func - span callback
+**        user - callback data
+**        clip - box spans are clipped to, 0 for none
+** Output: Spans passed to func
+** Return value: error level
+** ---------------------------------------------------------------------------
+*/
+
+static int	gray_convert_spans(RAS_ARG_ GB_SpanFunc func, void * user,
+							   GB_BBox* clip)
+{
+	if (clip)
+		ras.clip_box = *clip;
+	else
+	{
+		ras.clip_box.xMin = -32768;
+		ras.clip_box.yMin = -32768;
+		ras.clip_box.xMax = 32767;
+		ras.clip_box.yMax = 32767;
+	}
+	gray_init_cells(RAS_VAR_ ras.buffer, ras.buffer_size);
+    ras.cbox = 0;
+    ras.num_cells = 0;
+    ras.invalid = 1;
+    ras.band_size = (int)( ras.buffer_size >> 7 );
+    ras.stats.nRenders++;
+    ras.num_gray_spans = 0;
+    ras.target.buffer = 0;
+    ras.render_span = (GB_Raster_Span_Func)func;
+    ras.render_span_data = user;
+	return gray_convert_glyph(RAS_VAR);
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBit_Raster_Render
 ** Description: Render font character from raster
 ** Input: raster - raster
-**        tobitmap - rendered bitmap
+**        tobitmap - rendered bitmap, 8 bit coverage or 1 bit
 **        fromoutline - src outline
+**        cbox - box of the outline in whole pixels, 0 to compute it
 ** Output: Rendered bitmap (if conditions are met)
 ** Return value: GB_FAILED (if confitions are not met)
 ** ---------------------------------------------------------------------------
 */
 
 int			GreyBit_Raster_Render(void * raster, GB_Bitmap tobitmap,
-								  GB_Outline fromoutline)
+								  GB_Outline fromoutline, GB_BBox* cbox)
 {
 	PRaster me = (PRaster)raster;
 	PWorker worker = me->worker;
+	int     n;
 
 	if (!fromoutline)
 		return GB_FAILED;
@@ -1750,24 +2166,174 @@ int			GreyBit_Raster_Render(void * raster, GB_Bitmap tobitmap,
     ras.clip_box.yMin = 0;
     ras.clip_box.xMax = tobitmap->width;
     ras.clip_box.yMax = tobitmap->height;
-	gray_init_cells(me->buffer, me->buffer_size);
+	gray_init_cells(RAS_VAR_ ras.buffer, ras.buffer_size);
     ras.outline = *fromoutline;
+    ras.packed = 0;
+    ras.lines = 1;
+    for (n = 0; n < fromoutline->n_points && ras.lines; n++)
+      ras.lines = GB_CURVE_TAG(fromoutline->tags[n]) == GB_CURVE_TAG_ON;
+    ras.cbox = cbox;
+    ras.num_cells = 0;
+    ras.invalid = 1;
+    ras.band_size = (int)( ras.buffer_size >> 7 );
+    ras.stats.nRenders++;
+    ras.num_gray_spans = 0;
+    ras.target = *tobitmap;
+    ras.render_span = (GB_Raster_Span_Func)( tobitmap->bitcount == 1
+                                           ? gray_render_span_mono
+                                           : gray_render_span );
+    ras.render_span_data = &ras;
+	return gray_convert_glyph(RAS_VAR);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Raster_RenderPacked
+** Description: Render a packed outline, the points of a GVF record, scaling
+**              them while the outline is walked instead of expanding and
+**              transforming the record into an outline first
+** Input: raster - raster
+**        tobitmap - rendered bitmap, 8 bit coverage or 1 bit
+**        fromoutline - src packed outline
+**        cbox - box of the outline in whole pixels, 0 to compute it
+** Output: Rendered bitmap (if conditions are met)
+** Return value: GB_FAILED (if confitions are not met)
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBit_Raster_RenderPacked(void * raster, GB_Bitmap tobitmap,
+										GB_PackedOutline fromoutline,
+										GB_BBox* cbox)
+{
+	PRaster me = (PRaster)raster;
+	PWorker worker = me->worker;
+
+	if (!fromoutline)
+		return GB_FAILED;
+	if (!fromoutline->n_points || fromoutline->n_contours <= 0)
+		return GB_FAILED;
+	if (!fromoutline->contours || !fromoutline->points)
+		return GB_FAILED;
+	if (fromoutline->n_points
+	!= fromoutline->contours[fromoutline->n_contours - 1] + 1)
+		return GB_FAILED;
+	if (!tobitmap)
+		return GB_FAILED;
+	if (!tobitmap->width || !tobitmap->height)
+		return GB_FAILED;
+	if (!tobitmap->buffer)
+		return GB_FAILED;
+	ras.clip_box.xMin = 0;
+    ras.clip_box.yMin = 0;
+    ras.clip_box.xMax = tobitmap->width;
+    ras.clip_box.yMax = tobitmap->height;
+	gray_init_cells(RAS_VAR_ ras.buffer, ras.buffer_size);
+    ras.outline.n_contours = 0;
+    ras.outline.n_points = 0;
+    ras.packed = fromoutline;
+    ras.lines = 0;
+    ras.cbox = cbox;
     ras.num_cells = 0;
     ras.invalid = 1;
-    ras.band_size = me->band_size;
+    ras.band_size = (int)( ras.buffer_size >> 7 );
+    ras.stats.nRenders++;
     ras.num_gray_spans = 0;
     ras.target = *tobitmap;
-    ras.render_span = gray_render_span;
+    ras.render_span = (GB_Raster_Span_Func)( tobitmap->bitcount == 1
+                                           ? gray_render_span_mono
+                                           : gray_render_span );
     ras.render_span_data = &ras;
-	return gray_convert_glyph();
+	return gray_convert_glyph(RAS_VAR);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Raster_RenderSpans
+** Description: Render an outline as coverage spans passed to a callback,
+**              which may composite them anywhere; no bitmap is filled.
+**              Rows come in order, y going down; a long row may come in
+**              more than one call.
+** Input: raster - raster
+**        outline - src outline
+**        func - span callback
+**        user - callback data
+**        clip - box in whole pixels spans are clipped to, 0 for none
+** Output: Spans passed to func
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBit_Raster_RenderSpans(void * raster, GB_Outline outline,
+									   GB_SpanFunc func, void * user,
+									   GB_BBox* clip)
+{
+	PRaster me = (PRaster)raster;
+	PWorker worker = me->worker;
+	int     n;
+
+	if (!outline || !func)
+		return GB_FAILED;
+	if (!outline->n_points || outline->n_contours <= 0)
+		return GB_FAILED;
+	if (!outline->contours || !outline->points)
+		return GB_FAILED;
+	if (outline->n_points != outline->contours[outline->n_contours - 1] + 1)
+		return GB_FAILED;
+    ras.outline = *outline;
+    ras.packed = 0;
+    ras.lines = 1;
+    for (n = 0; n < outline->n_points && ras.lines; n++)
+      ras.lines = GB_CURVE_TAG(outline->tags[n]) == GB_CURVE_TAG_ON;
+	return gray_convert_spans(RAS_VAR_ func, user, clip);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Raster_RenderPackedSpans
+** Description: Render a packed outline as coverage spans passed to a
+**              callback, as GreyBit_Raster_RenderSpans
+** Input: raster - raster
+**        outline - src packed outline
+**        func - span callback
+**        user - callback data
+**        clip - box in whole pixels spans are clipped to, 0 for none
+** Output: Spans passed to func
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBit_Raster_RenderPackedSpans(void * raster,
+											 GB_PackedOutline outline,
+											 GB_SpanFunc func, void * user,
+											 GB_BBox* clip)
+{
+	PRaster me = (PRaster)raster;
+	PWorker worker = me->worker;
+
+	if (!outline || !func)
+		return GB_FAILED;
+	if (!outline->n_points || outline->n_contours <= 0)
+		return GB_FAILED;
+	if (!outline->contours || !outline->points)
+		return GB_FAILED;
+	if (outline->n_points != outline->contours[outline->n_contours - 1] + 1)
+		return GB_FAILED;
+    ras.outline.n_contours = 0;
+    ras.outline.n_points = 0;
+    ras.packed = outline;
+    ras.lines = 0;
+	return gray_convert_spans(RAS_VAR_ func, user, clip);
 }
 
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBit_Raster_New
-** Description: Create raster pool
+** Description: Create raster pool. A raster keeps all render state in its
+**              own worker, so rasters may render on different threads.
+**              The pool grows when a glyph overflows it, up to
+**              MAX_POOL_SIZE, before bands are split.
 ** Input: library - GreyBit library
-**        nPoolSize - size of paster pool
+**        nPoolSize - first size of raster pool, 0 for DEFAULT_POOL_SIZE
 ** Output: Init'ed raster type
 ** Return value: me
 ** ---------------------------------------------------------------------------
@@ -1776,22 +2342,80 @@ int			GreyBit_Raster_Render(void * raster, GB_Bitmap tobitmap,
 void *		GreyBit_Raster_New(GB_Library library, int nPoolSize)
 {
 	PRaster me;
+	PWorker worker;
+	void *	buffer;
 
 	if (nPoolSize <= 0)
 		nPoolSize = DEFAULT_POOL_SIZE;
-	me = (PRaster)GreyBit_Malloc(library->gbMem, nPoolSize);
-	if (me)
+	nPoolSize = nPoolSize >> 4 << 4;
+	me = (PRaster)GreyBit_Malloc(library->gbMem,
+								 sizeof(TRaster) + sizeof(TWorker));
+	if (!me)
+		return 0;
+	buffer = GreyBit_Malloc(library->gbMem, nPoolSize);
+	if (!buffer)
 	{
-		me->gbMem = library->gbMem;
-		me->worker = (PWorker)((GB_BYTE*)me + sizeof(TRaster));
-		me->buffer = (GB_BYTE*)me->worker + sizeof(TWorker);
-		me->buffer_size = (nPoolSize - sizeof(TRaster)
-		                - sizeof(TWorker)) >> 4 << 4;
-		me->band_size = me->buffer_size >> 7;
+		GreyBit_Free(library->gbMem, me);
+		return 0;
 	}
+	GB_MEMSET(me, 0, sizeof(TRaster) + sizeof(TWorker));
+	me->gbMem = library->gbMem;
+	me->worker = worker = (PWorker)((GB_BYTE*)me + sizeof(TRaster));
+	gray_init_cells(RAS_VAR_ buffer, nPoolSize);
+	ras.memory = library->gbMem;
+	ras.buffer_max = nPoolSize > MAX_POOL_SIZE ? nPoolSize : MAX_POOL_SIZE;
+	ras.engine = GB_RASTER_CELLS;
+	ras.stats.nPoolSize = nPoolSize;
 	return (void *)me;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Raster_SetEngine
+** Description: Choose how a raster collects coverage: as a sorted list of
+**              cells per row, or in a dense buffer of accumulators whose row
+**              prefix sums give the coverage. The dense buffer costs no
+**              search or links per cell but takes the pool by whole rows,
+**              so it suits small glyphs; both give the same bitmap.
+** Input: raster - raster
+**        nEngine - GB_RASTER_CELLS/GB_RASTER_ACCUM
+** Output: Engine of raster
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBit_Raster_SetEngine(void * raster, int nEngine)
+{
+	PRaster me = (PRaster)raster;
+
+	if (!me || (nEngine != GB_RASTER_CELLS && nEngine != GB_RASTER_ACCUM))
+		return GB_FAILED;
+	me->worker->engine = nEngine;
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Raster_GetStats
+** Description: Get the counts of a raster since it was created: glyphs
+**              rendered, bands swept, bands split for want of pool, and
+**              how often and how far the pool grew
+** Input: raster - raster
+** Output: pStats - counts
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			GreyBit_Raster_GetStats(void * raster, GB_RasterStats pStats)
+{
+	PRaster me = (PRaster)raster;
+
+	if (!me || !pStats)
+		return GB_FAILED;
+	*pStats = me->worker->stats;
+	return GB_SUCCESS;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBit_Raster_Done
@@ -1806,6 +2430,7 @@ void		GreyBit_Raster_Done(void * raster)
 {
 	PRaster me = (PRaster)raster;
 
+	GreyBit_Free(me->gbMem, me->worker->buffer);
 	GreyBit_Free(me->gbMem, raster);
 }
 #endif //ENABLE_GREYVECTORFILE
\ No newline at end of file
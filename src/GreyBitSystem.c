@@ -8,6 +8,8 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Quiet unused stream without threads
+** 10/18/2026	me				Stream lock, child streams keep parent IO
 ** 09/16/2023	me				Upgrade
 ** 08/07/2023	me              Init
 ** ===========================================================================
@@ -79,6 +81,16 @@ extern
 void *		GreyBit_Realloc_Sys(void * p, GB_INT32 newsize);
 extern
 void		GreyBit_Free_Sys(void * p);
+#ifdef ENABLE_MULTITHREAD
+extern
+GB_Mutex	GreyBit_Mutex_New_Sys(void);
+extern
+void		GreyBit_Mutex_Lock_Sys(GB_Mutex m);
+extern
+void		GreyBit_Mutex_Unlock_Sys(GB_Mutex m);
+extern
+void		GreyBit_Mutex_Done_Sys(GB_Mutex m);
+#endif //ENABLE_MULTITHREAD
 
 /*
 ** ---------------------------------------------------------------------------
@@ -316,6 +328,7 @@ GB_Stream	GreyBit_Stream_New(const char * filepathname, char bcreate)
 #endif //ENABLE_ENCODER
 		stream->offset = 0;
 		stream->refcnt = 1;
+		stream->lock = 0;
 	}
 	return stream;
 }
@@ -354,6 +367,7 @@ GB_Stream	GreyBit_Stream_New_Memory(const void * pBuf, GB_INT32 nBufSize)
 #endif //ENABLE_ENCODER
 		stream->offset = 0;
 		stream->refcnt = 1;
+		stream->lock = 0;
 	}
 	return stream;
 }
@@ -378,15 +392,19 @@ GB_Stream    GreyBit_Stream_New_Child(GB_Stream parent)
 	if (stream)
 	{
 		++parent->refcnt;
-		stream->read = GreyBit_Read_Sys;
+		stream->read = parent->read;
 		stream->parent = parent;
-		stream->write = GreyBit_Write_Sys;
-		stream->seek = GreyBit_Seek_Sys;
-		stream->close = GreyBit_Close_Sys;
+		stream->write = parent->write;
+		stream->seek = parent->seek;
+		stream->close = parent->close;
 		stream->handler = parent->handler;
 		stream->size = parent->size;
 		stream->offset = parent->offset;
 		stream->refcnt = 1;
+		stream->lock = 0;
+#ifdef ENABLE_ENCODER
+		stream->pfilename = 0;
+#endif //ENABLE_ENCODER
 	}
 	return stream;
 }
@@ -483,6 +501,76 @@ GB_INT32     GreyBit_Stream_Offset(GB_Stream stream, GB_INT32 offset,
 		return GB_SUCCESS;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Stream_Share
+** Description: Prepare a stream to be used from several threads. The lock
+**              lives on the root stream, so every child of one file or
+**              buffer shares it. Without ENABLE_MULTITHREAD there is no lock
+**              and this always succeeds.
+** Input: stream - stream
+** Output: Root stream lock created
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyBit_Stream_Share(GB_Stream stream)
+{
+	while (stream->parent)
+		stream = stream->parent;
+#ifdef ENABLE_MULTITHREAD
+	if (!stream->lock)
+		stream->lock = GreyBit_Mutex_New_Sys();
+	if (!stream->lock)
+		return GB_FAILED;
+#endif //ENABLE_MULTITHREAD
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Stream_Lock
+** Description: Take the root stream lock, if the stream is shared
+** Input: stream - stream
+** Output: Locked stream
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyBit_Stream_Lock(GB_Stream stream)
+{
+#ifdef ENABLE_MULTITHREAD
+	while (stream->parent)
+		stream = stream->parent;
+	if (stream->lock)
+		GreyBit_Mutex_Lock_Sys(stream->lock);
+#else
+	(void)stream;
+#endif //ENABLE_MULTITHREAD
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBit_Stream_Unlock
+** Description: Release the root stream lock, if the stream is shared
+** Input: stream - stream
+** Output: Unlocked stream
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyBit_Stream_Unlock(GB_Stream stream)
+{
+#ifdef ENABLE_MULTITHREAD
+	while (stream->parent)
+		stream = stream->parent;
+	if (stream->lock)
+		GreyBit_Mutex_Unlock_Sys(stream->lock);
+#else
+	(void)stream;
+#endif //ENABLE_MULTITHREAD
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBit_Stream_Done
@@ -504,6 +592,10 @@ void		GreyBit_Stream_Done(GB_Stream stream)
 		{
 			if (stream->close)
 				stream->close(stream->handler);
+#ifdef ENABLE_MULTITHREAD
+			if (stream->lock)
+				GreyBit_Mutex_Done_Sys(stream->lock);
+#endif //ENABLE_MULTITHREAD
 #ifdef ENABLE_ENCODER
 			if (stream->pfilename)
 				GreyBit_Free_Sys(stream->pfilename);
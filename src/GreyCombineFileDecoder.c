@@ -7,6 +7,15 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Params set on every item
+** 10/19/2026	me				Preload every item holding the code
+** 10/18/2026	me				Strikes picked by size
+** 10/18/2026	me				Decode packed
+** 10/18/2026	me				Decode contexts
+** 10/18/2026	me				Span output
+** 10/18/2026	me				Decode into caller bitmap
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
 ** 09/16/2023	me				Upgrade
 ** 08/11/2023	me              Init
 ** ===========================================================================
@@ -53,6 +62,43 @@
 **----------------------------------------------------------------------------
 */
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Decoder_GetItem
+** Description: Get the item that decodes a character at a size: the strike
+**              of that size, else the first item for any size, else the
+**              first item holding the code
+** Input: decoder - decoder
+**        nCode - unicode code
+**        nSize - character size, 0 if not known
+** Output: Item index
+** Return value: item holding the code/GCF_ITEM_MAX if none
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyCombineFile_Decoder_GetItem(GCF_Decoder decoder,
+											GB_UINT32 nCode, GB_INT16 nSize)
+{
+	GB_INT32	nCurrItem;
+	GB_INT32	nFound;
+	GB_UINT32	nHeight;
+
+	nFound = GCF_ITEM_MAX;
+	for (nCurrItem = 0; nCurrItem < GCF_ITEM_MAX; ++nCurrItem)
+	{
+		if (!decoder->gbLoader[nCurrItem]
+		 || !GreyBitType_Loader_IsExist(decoder->gbLoader[nCurrItem], nCode))
+			continue;
+		nHeight = decoder->gbFileHeader.gbfInfo[nCurrItem].gbiHeight;
+		if (nSize > 0 && nHeight == (GB_UINT32)nSize)
+			return nCurrItem;
+		if (nFound == GCF_ITEM_MAX
+		 || (!nHeight && decoder->gbFileHeader.gbfInfo[nFound].gbiHeight))
+			nFound = nCurrItem;
+	}
+	return nFound;
+}
+
 /*
 **----------------------------------------------------------------------------
 **  Function(internal/external use) Declarations
@@ -85,6 +131,12 @@ GB_Decoder GreyCombineFile_Decoder_New(GB_Loader loader, GB_Stream stream)
 		decoder->gbDecoder.getheight = GreyCombineFile_Decoder_GetHeight;
 		decoder->gbDecoder.getadvance = GreyCombineFile_Decoder_GetAdvance;
 		decoder->gbDecoder.decode = GreyCombineFile_Decoder_Decode;
+		decoder->gbDecoder.decodeto = GreyCombineFile_Decoder_DecodeTo;
+		decoder->gbDecoder.decodespans = GreyCombineFile_Decoder_DecodeSpans;
+		decoder->gbDecoder.decodepacked = GreyCombineFile_Decoder_DecodePacked;
+		decoder->gbDecoder.decodebatch = GreyCombineFile_Decoder_DecodeBatch;
+		decoder->gbDecoder.preload = GreyCombineFile_Decoder_Preload;
+		decoder->gbDecoder.newcontext = GreyCombineFile_Decoder_NewContext;
 		decoder->gbDecoder.done = GreyCombineFile_Decoder_Done;
 		decoder->gbLibrary = loader->gbLibrary;
 		decoder->gbMem = loader->gbMem;
@@ -117,7 +169,8 @@ GB_Decoder GreyCombineFile_Decoder_New(GB_Loader loader, GB_Stream stream)
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyBitFile_Decoder_SetParam
-** Description: Set decoder param
+** Description: Set decoder param on every item, so each strike and the
+**              fallback get a cache of their own
 ** Input: decoder - decoder
 **        nParam - param type
 **        dwParam - param value
@@ -131,19 +184,20 @@ GB_INT32	GreyCombineFile_Decoder_SetParam(GB_Decoder decoder,
 											 GB_UINT32 dwParam)
 {
 	GB_INT32	nCurrItem;
-	GB_INT32	nCurrCount = 0;
+	GB_INT32	nRet;
 	GB_Loader	gbCurrLoader;
 	GCF_Decoder	me = (GCF_Decoder)decoder;
 
+	nRet = GB_FAILED;
 	for (nCurrItem = 0; nCurrItem < GCF_ITEM_MAX; ++nCurrItem)
 	{
 		gbCurrLoader = me->gbLoader[nCurrItem];
 		if (gbCurrLoader && GreyBit_Decoder_SetParam(gbCurrLoader->gbDecoder,
 			nParam, dwParam)
 			== GB_SUCCESS)
-			return GB_SUCCESS;
+			nRet = GB_SUCCESS;
 	}
-	return GB_FAILED;
+	return nRet;
 }
 
 /*
@@ -207,13 +261,10 @@ GB_INT32	GreyCombineFile_Decoder_GetWidth(GB_Decoder decoder,
 	GB_Loader	gbCurrLoader;
 	GCF_Decoder	me = (GCF_Decoder)decoder;
 
-	for (nCurrItem = 0; nCurrItem < GCF_ITEM_MAX; ++nCurrItem)
-	{
-		gbCurrLoader = me->gbLoader[nCurrItem];
-		if (gbCurrLoader
-			&& GreyBitType_Loader_IsExist(me->gbLoader[nCurrItem], nCode))
-			break;
-	}
+	nCurrItem = GreyCombineFile_Decoder_GetItem(me, nCode, nSize);
+	if (nCurrItem >= GCF_ITEM_MAX)
+		return 0;
+	gbCurrLoader = me->gbLoader[nCurrItem];
 	return GreyBit_Decoder_GetWidth(gbCurrLoader->gbDecoder, nCode, nSize);
 }
 
@@ -237,13 +288,10 @@ GB_INT16	GreyCombineFile_Decoder_GetAdvance(GB_Decoder decoder,
 	GB_Loader	gbCurrLoader;
 	GCF_Decoder	me = (GCF_Decoder)decoder;
 
-	for (nCurrItem = 0; nCurrItem < GCF_ITEM_MAX; ++nCurrItem)
-	{
-		gbCurrLoader = me->gbLoader[nCurrItem];
-		if (gbCurrLoader
-			&& GreyBitType_Loader_IsExist(me->gbLoader[nCurrItem],nCode))
-			break;
-	}
+	nCurrItem = GreyCombineFile_Decoder_GetItem(me, nCode, nSize);
+	if (nCurrItem >= GCF_ITEM_MAX)
+		return 0;
+	gbCurrLoader = me->gbLoader[nCurrItem];
 	return GreyBit_Decoder_GetAdvance(gbCurrLoader->gbDecoder, nCode, nSize);
 }
 
@@ -267,14 +315,249 @@ GB_INT32	GreyCombineFile_Decoder_Decode(GB_Decoder decoder,GB_UINT32 nCode,
 	GB_Loader	gbCurrLoader;
 	GCF_Decoder	me = (GCF_Decoder)decoder;
 
+	nCurrItem = GreyCombineFile_Decoder_GetItem(me, nCode, nSize);
+	if (nCurrItem >= GCF_ITEM_MAX)
+		return GB_FAILED;
+	gbCurrLoader = me->gbLoader[nCurrItem];
+	return GreyBit_Decoder_Decode(gbCurrLoader->gbDecoder, nCode, pData, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Decoder_DecodeTo
+** Description: Decode a character straight into a caller bitmap
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer, may be 0
+**		  pDst - destination bitmap
+**		  x - left of the character in pDst
+**		  y - top of the character in pDst
+**		  nSize - character size
+** Output: Decoded character in pDst
+** Return value: GreyBit_Decoder_DecodeTo/fail if no item has the code
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyCombineFile_Decoder_DecodeTo(GB_Decoder decoder,
+											 GB_UINT32 nCode, GB_Data pData,
+											 GB_Bitmap pDst, GB_INT16 x,
+											 GB_INT16 y, GB_INT16 nSize)
+{
+	GB_INT32	nCurrItem;
+	GCF_Decoder	me = (GCF_Decoder)decoder;
+
+	nCurrItem = GreyCombineFile_Decoder_GetItem(me, nCode, nSize);
+	if (nCurrItem >= GCF_ITEM_MAX)
+		return GB_FAILED;
+	return GreyBit_Decoder_DecodeTo(me->gbLoader[nCurrItem]->gbDecoder, nCode,
+									pData, pDst, x, y, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Decoder_DecodeSpans
+** Description: Decode a character as coverage spans
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer, may be 0
+**		  func - span callback
+**		  user - callback data
+**		  nSize - character size
+** Output: Spans passed to func
+** Return value: GreyBit_Decoder_DecodeSpans/fail if no item has the code
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyCombineFile_Decoder_DecodeSpans(GB_Decoder decoder,
+												GB_UINT32 nCode, GB_Data pData,
+												GB_SpanFunc func, void* user,
+												GB_INT16 nSize)
+{
+	GB_INT32	nCurrItem;
+	GCF_Decoder	me = (GCF_Decoder)decoder;
+
+	nCurrItem = GreyCombineFile_Decoder_GetItem(me, nCode, nSize);
+	if (nCurrItem >= GCF_ITEM_MAX)
+		return GB_FAILED;
+	return GreyBit_Decoder_DecodeSpans(me->gbLoader[nCurrItem]->gbDecoder,
+									   nCode, pData, func, user, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Decoder_DecodePacked
+** Description: Decode a character, packed if its item can
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer
+**		  nSize - character size
+** Output: Decoded character
+** Return value: GreyBit_Decoder_DecodePacked/fail if no item has the code
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyCombineFile_Decoder_DecodePacked(GB_Decoder decoder,
+												 GB_UINT32 nCode,
+												 GB_Data pData,
+												 GB_INT16 nSize)
+{
+	GB_INT32	nCurrItem;
+	GCF_Decoder	me = (GCF_Decoder)decoder;
+
+	nCurrItem = GreyCombineFile_Decoder_GetItem(me, nCode, nSize);
+	if (nCurrItem >= GCF_ITEM_MAX)
+		return GB_FAILED;
+	return GreyBit_Decoder_DecodePacked(me->gbLoader[nCurrItem]->gbDecoder,
+										nCode, pData, nSize);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Decoder_DecodeBatch
+** Description: Decode a run of characters, handing each stretch of codes
+**              held by the same item to that item in one call
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+**	      pData - data array, pData[i].data is caller storage
+**		  nSize - character size
+** Output: Decoded characters, width 0 for characters not decoded
+** Return value: number of characters decoded
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyCombineFile_Decoder_DecodeBatch(GB_Decoder decoder,
+												const GB_UINT32* pCodes,
+												GB_INT32 nCount,
+												GB_Data pData,
+												GB_INT16 nSize)
+{
+	GB_INT32	nCurrItem;
+	GB_INT32	nRunItem;
+	GB_INT32	nStart;
+	GB_INT32	nDecoded;
+	GB_INT32	i;
+	GCF_Decoder	me = (GCF_Decoder)decoder;
+
+	nDecoded = 0;
+	nStart = 0;
+	nRunItem = GCF_ITEM_MAX;
+	for (i = 0; i <= nCount; ++i)
+	{
+		nCurrItem = GCF_ITEM_MAX;
+		if (i < nCount)
+			nCurrItem = GreyCombineFile_Decoder_GetItem(me, pCodes[i],
+														 nSize);
+		if (i > nStart && i < nCount && nCurrItem == nRunItem)
+			continue;
+		if (i > nStart && nRunItem < GCF_ITEM_MAX)
+		{
+			nDecoded += GreyBit_Decoder_DecodeBatch(
+							me->gbLoader[nRunItem]->gbDecoder, pCodes + nStart,
+							i - nStart, pData + nStart, nSize);
+		}
+		else
+		{
+			for (; nStart < i; ++nStart)
+				pData[nStart].width = 0;
+		}
+		nStart = i;
+		nRunItem = nCurrItem;
+	}
+	return nDecoded;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Decoder_Preload
+** Description: Preload characters in every item holding them, so the
+**              strike or fallback GetItem picks at any size is cached
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+** Output: Cached characters
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyCombineFile_Decoder_Preload(GB_Decoder decoder,
+											const GB_UINT32* pCodes,
+											GB_INT32 nCount)
+{
+	GB_INT32	nCurrItem;
+	GB_INT32	nCodes;
+	GB_INT32	nRet;
+	GB_INT32	i;
+	GB_UINT32*	pItemCodes;
+	GCF_Decoder	me = (GCF_Decoder)decoder;
+
+	if (nCount <= 0)
+		return GB_FAILED;
+	pItemCodes = (GB_UINT32*)GreyBit_Malloc(me->gbMem,
+											sizeof(GB_UINT32) * nCount);
+	if (!pItemCodes)
+		return GB_FAILED;
+	nRet = GB_SUCCESS;
 	for (nCurrItem = 0; nCurrItem < GCF_ITEM_MAX; ++nCurrItem)
 	{
-		gbCurrLoader = me->gbLoader[nCurrItem];
-		if (gbCurrLoader
-			&& GreyBitType_Loader_IsExist(me->gbLoader[nCurrItem], nCode))
-			break;
+		if (!me->gbLoader[nCurrItem])
+			continue;
+		nCodes = 0;
+		for (i = 0; i < nCount; ++i)
+		{
+			if (GreyBitType_Loader_IsExist(me->gbLoader[nCurrItem], pCodes[i]))
+				pItemCodes[nCodes++] = pCodes[i];
+		}
+		if (nCodes && GreyBit_Decoder_Preload(me->gbLoader[nCurrItem]->gbDecoder,
+											  pItemCodes, nCodes) != GB_SUCCESS)
+			nRet = GB_FAILED;
 	}
-	return GreyBit_Decoder_Decode(gbCurrLoader->gbDecoder, nCode, pData, nSize);
+	GreyBit_Free(me->gbMem, pItemCodes);
+	return nRet;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Decoder_NewContext
+** Description: Make a decode context of a combined font, holding a context
+**              of each item loader
+** Input: decoder - decoder
+**        loader - loader of the context
+**        stream - stream of the context
+** Output: New decoder context
+** Return value: decoder context/0 if an item has no context
+** ---------------------------------------------------------------------------
+*/
+
+GB_Decoder	GreyCombineFile_Decoder_NewContext(GB_Decoder decoder,
+											   GB_Loader loader,
+											   GB_Stream stream)
+{
+	GB_INT32	nCurrItem;
+	GCF_Decoder	font = (GCF_Decoder)decoder;
+	GCF_Decoder	me;
+
+	me = (GCF_Decoder)GreyBit_Malloc(loader->gbMem, sizeof(GCF_DecoderRec));
+	if (!me)
+		return 0;
+	GB_MEMCPY(me, font, sizeof(GCF_DecoderRec));
+	me->gbLibrary = loader->gbLibrary;
+	me->gbMem = loader->gbMem;
+	me->gbStream = stream;
+	GB_MEMSET(me->gbLoader, 0, sizeof(GB_Loader)*GCF_ITEM_MAX);
+	for (nCurrItem = 0; nCurrItem < GCF_ITEM_MAX; ++nCurrItem)
+	{
+		if (!font->gbLoader[nCurrItem])
+			continue;
+		me->gbLoader[nCurrItem] = (GB_Loader)GreyBitType_Loader_NewContext(
+												font->gbLoader[nCurrItem]);
+		if (!me->gbLoader[nCurrItem])
+		{
+			GreyCombineFile_Decoder_Done((GB_Decoder)me);
+			return 0;
+		}
+	}
+	return (GB_Decoder)me;
 }
 
 /*
@@ -8,6 +8,9 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Bake strikes on threads of their own
+** 10/18/2026	me				Quiet unused parameters
+** 10/18/2026	me				Bake bitmap strikes
 ** 09/16/2023	me				Upgrade
 ** 08/11/2023	me              Init
 ** ===========================================================================
@@ -20,6 +23,7 @@
 */
 
 #include "../inc/GreyCombineFile.h"
+#include "../inc/GreyBitFile.h"
 
 #ifdef ENABLE_GREYCOMBINEFILE
 #ifdef ENABLE_ENCODER
@@ -35,6 +39,13 @@
 **----------------------------------------------------------------------------
 */
 
+typedef struct _GCF_BakeRec
+{
+	GB_Loader	gbLoader;	/* source font, a context of it if threaded  */
+	GBHANDLE	gbLayout;
+	GB_Encoder	gbEncoder;	/* GBF of the strike                          */
+} GCF_BakeRec, *GCF_Bake;
+
 /*
 **----------------------------------------------------------------------------
 **  Global variables
@@ -72,17 +83,19 @@ extern GB_BOOL		GreyVectorFile_Probe(GB_Stream stream);
 
 GB_INT32 GreyCombineFile_Encoder_GetCount(GB_Encoder encoder)
 {
+	(void)encoder;
 	return nCurrItemCount;
 }
 
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreCombineFile_Encoder_SetParam
-** Description: Set encoder param
+** Description: Set encoder param. GB_PARAM_HEIGHT is the strike size of the
+**              fonts encoded next, 0 for fonts used at any size.
 ** Input: encoder - encoder
 **        nParam - param type
 **        dwParam - param value
-** Output: None
+** Output: Set param
 ** Return value: success
 ** ---------------------------------------------------------------------------
 */
@@ -91,6 +104,10 @@ GB_INT32	GreyCombineFile_Encoder_SetParam(GB_Encoder encoder,
 										     GB_Param nParam,
 											 GB_UINT32 dwParam)
 {
+	GCF_Encoder	me = (GCF_Encoder)encoder;
+
+	if (nParam == GB_PARAM_HEIGHT)
+		me->nHeight = dwParam;
 	return GB_SUCCESS;
 }
 
@@ -109,6 +126,7 @@ GB_INT32	GreyCombineFile_Encoder_Delete(GB_Encoder encoder,GB_UINT32 nCode)
 {
 	GCF_Encoder	me = (GCF_Encoder)encoder;
 
+	(void)nCode;
 	nCurrItemCount--;
 	me->gbFileHeader.gbfInfo[nCurrItemCount].gbiHeight = 0;
 	me->gbFileHeader.gbfInfo[nCurrItemCount].gbiDataSize = 0;
@@ -132,26 +150,195 @@ GB_INT32	GreyCombineFile_Encoder_Delete(GB_Encoder encoder,GB_UINT32 nCode)
 GB_INT32	GreyCombineFile_Encoder_Encode(GB_Encoder encoder,GB_UINT32 nCode,
 										   GB_Data pData)
 {
+	GB_Stream	stream;
 	GCF_Encoder	me = (GCF_Encoder)encoder;
 
-	if (!pData || pData->format != GB_FORMAT_STREAM || pData->data)
+	(void)nCode;
+	if (!pData || pData->format != GB_FORMAT_STREAM || !pData->data)
 		return GB_FAILED;
-	if (!me->gbCreator[nCurrItemCount]->size)
+	if (nCurrItemCount >= GCF_ITEM_MAX)
 		return GB_FAILED;
-	if (GreyBitFile_Probe(me->gbCreator[nCurrItemCount]) != GB_TRUE
-	|| GreyVectorFile_Probe(me->gbCreator[nCurrItemCount]) != GB_TRUE)
+	stream = (GB_Stream)pData->data;
+	if (!stream->size)
 		return GB_FAILED;
-	if (nCurrItemCount >= GCF_ITEM_MAX)
+	if (GreyBitFile_Probe(stream) != GB_TRUE
+	 && GreyVectorFile_Probe(stream) != GB_TRUE)
 		return GB_FAILED;
-	me->gbCreator[nCurrItemCount] = (GB_Stream)pData->data;
-	me->gbFileHeader.gbfInfo[nCurrItemCount].gbiDataSize
-										= me->gbCreator[nCurrItemCount]->size;
+	me->gbCreator[nCurrItemCount] = stream;
+	me->gbFileHeader.gbfInfo[nCurrItemCount].gbiHeight = me->nHeight;
+	me->gbFileHeader.gbfInfo[nCurrItemCount].gbiDataSize = stream->size;
 	me->gbFileHeader.gbfInfo[nCurrItemCount].gbiDataOff = nOffset;
 	nOffset += me->gbFileHeader.gbfInfo[nCurrItemCount].gbiDataSize;
 	nCurrItemCount++;
 	return GB_SUCCESS;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Encoder_BakeStrike
+** Description: Render every character of the source font into one strike
+** Input: p - strike
+** Output: Encoded characters
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+static void	GreyCombineFile_Encoder_BakeStrike(void * p)
+{
+	GB_UINT32	nCode;
+	GB_Bitmap	bitmap;
+	GB_DataRec	data;
+	GCF_Bake	me = (GCF_Bake)p;
+
+	for (nCode = 0; nCode < MAX_COUNT; ++nCode)
+	{
+		if (!GreyBitType_Loader_IsExist(me->gbLoader, nCode)
+		 || GreyBitType_Layout_LoadChar(me->gbLayout, nCode, &bitmap)
+			!= GB_SUCCESS)
+			continue;
+		data.format = GB_FORMAT_BITMAP;
+		data.data = bitmap;
+		data.width = bitmap->width;
+		data.horioff = bitmap->horioff;
+		GreyBit_Encoder_Encode(me->gbEncoder, nCode, &data);
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyCombineFile_Encoder_Bake
+** Description: Render the characters of a font into GBF strikes, written to
+**              the stream after the items already there. With
+**              ENABLE_MULTITHREAD each strike is rendered on a thread of its
+**              own, through a loader context; otherwise, or if no context
+**              or thread can be made, the strikes are rendered in turn. With
+**              bFallback the source font follows the strikes as an item for
+**              any size.
+** Input: encoder - encoder
+**        loader - loader of the source font
+**        pSizes - strike sizes
+**        pBitCounts - strike bit counts
+**        nCount - strike count
+**        bFallback - keep the source font?
+** Output: Added strikes
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyCombineFile_Encoder_Bake(GB_Encoder encoder, GB_Loader loader,
+										 const GB_INT16* pSizes,
+										 const GB_INT16* pBitCounts,
+										 GB_INT32 nCount, GB_BOOL bFallback)
+{
+#ifdef ENABLE_GREYBITFILE
+	GB_INT32		i;
+	GB_INT32		nRet;
+	GB_CreatorRec	creator;
+	GB_Stream		stream[GCF_ITEM_MAX];
+	GCF_BakeRec		bake[GCF_ITEM_MAX];
+#ifdef ENABLE_MULTITHREAD
+	GB_Thread		thread[GCF_ITEM_MAX];
+#endif //ENABLE_MULTITHREAD
+	GREYCOMBINEITEMINFO*	item;
+	GCF_Encoder		me = (GCF_Encoder)encoder;
+
+	if (!loader || nCount <= 0
+	 || nCurrItemCount + nCount + (bFallback ? 1 : 0) > GCF_ITEM_MAX)
+		return GB_FAILED;
+	GB_MEMSET(stream, 0, sizeof(stream));
+	GB_MEMSET(bake, 0, sizeof(bake));
+	creator.gbLibrary = me->gbLibrary;
+	creator.gbMem = me->gbMem;
+	creator.gbEncoder = 0;
+	nRet = GB_SUCCESS;
+	for (i = 0; i < nCount && nRet == GB_SUCCESS; ++i)
+	{
+		nRet = GB_FAILED;
+		stream[i] = GreyBit_Stream_New_Child(me->gbStream);
+		if (!stream[i])
+			break;
+		creator.gbStream = stream[i];
+		bake[i].gbEncoder = GreyBitFile_Encoder_New(&creator, stream[i]);
+#ifdef ENABLE_MULTITHREAD
+		if (nCount > 1)
+			bake[i].gbLoader =
+				(GB_Loader)GreyBitType_Loader_NewContext(loader);
+#endif //ENABLE_MULTITHREAD
+		if (!bake[i].gbLoader)
+			bake[i].gbLoader = loader;
+		bake[i].gbLayout = GreyBitType_Layout_New(bake[i].gbLoader, pSizes[i],
+												  pBitCounts[i], 0, 0);
+		if (!bake[i].gbEncoder || !bake[i].gbLayout)
+			break;
+		GreyBit_Encoder_SetParam(bake[i].gbEncoder, GB_PARAM_HEIGHT,
+								 pSizes[i]);
+		GreyBit_Encoder_SetParam(bake[i].gbEncoder, GB_PARAM_BITCOUNT,
+								 pBitCounts[i]);
+		GreyBit_Encoder_SetParam(bake[i].gbEncoder, GB_PARAM_CROP, 1);
+		nRet = GreyBit_Encoder_SetParam(bake[i].gbEncoder, GB_PARAM_COMPRESS,
+										0);
+	}
+	if (nRet == GB_SUCCESS)
+	{
+#ifdef ENABLE_MULTITHREAD
+		/* strikes without a context or a thread are rendered here */
+		for (i = 0; i < nCount; ++i)
+		{
+			thread[i] = 0;
+			if (bake[i].gbLoader != loader)
+				thread[i] = GreyBit_Thread_New_Sys(
+								GreyCombineFile_Encoder_BakeStrike, &bake[i]);
+		}
+		for (i = 0; i < nCount; ++i)
+		{
+			if (thread[i])
+				GreyBit_Thread_Join_Sys(thread[i]);
+			else
+				GreyCombineFile_Encoder_BakeStrike(&bake[i]);
+		}
+#else
+		for (i = 0; i < nCount; ++i)
+			GreyCombineFile_Encoder_BakeStrike(&bake[i]);
+#endif //ENABLE_MULTITHREAD
+	}
+	for (i = 0; i < nCount && nRet == GB_SUCCESS; ++i)
+	{
+		GreyBit_Stream_Offset(stream[i], nOffset, 0);
+		GreyBit_Encoder_Flush(bake[i].gbEncoder);
+		item = &me->gbFileHeader.gbfInfo[nCurrItemCount++];
+		item->gbiHeight = pSizes[i];
+		item->gbiDataOff = nOffset;
+		item->gbiDataSize = ((GBF_Encoder)bake[i].gbEncoder)->nFileSize;
+		nOffset += item->gbiDataSize;
+	}
+	for (i = 0; i < nCount; ++i)
+	{
+		if (bake[i].gbLayout)
+			GreyBitType_Layout_Done(bake[i].gbLayout);
+		if (bake[i].gbLoader && bake[i].gbLoader != loader)
+			GreyBitType_Loader_Done(bake[i].gbLoader);
+		if (bake[i].gbEncoder)
+			GreyBit_Encoder_Done(bake[i].gbEncoder);
+		if (stream[i])
+			GreyBit_Stream_Done(stream[i]);
+	}
+	if (nRet != GB_SUCCESS || !bFallback)
+		return nRet;
+	/* copied by WriteAll like an encoded font */
+	me->gbCreator[nCurrItemCount] = GreyBit_Stream_New_Child(loader->gbStream);
+	if (!me->gbCreator[nCurrItemCount])
+		return GB_FAILED;
+	item = &me->gbFileHeader.gbfInfo[nCurrItemCount++];
+	item->gbiHeight = 0;
+	item->gbiDataOff = nOffset;
+	item->gbiDataSize = loader->gbStream->size;
+	nOffset += item->gbiDataSize;
+	return GB_SUCCESS;
+#else
+	return GB_FAILED;
+#endif //ENABLE_GREYBITFILE
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyCombineFile_Encoder_WriteAll
@@ -172,8 +359,11 @@ GB_INT32	GreyCombineFile_Encoder_WriteAll(GCF_Encoder encoder)
 						 sizeof(GREYCOMBINEFILEHEADER));
 	for (nCurrItem = 0; nCurrItem < GCF_ITEM_MAX; nCurrItem++)
 	{
-		if (encoder->gbFileHeader.gbfInfo[nCurrItem].gbiDataSize)
+		/* baked strikes are in the stream already */
+		if (encoder->gbCreator[nCurrItem])
 		{
+			GreyBit_Stream_Seek(encoder->gbStream,
+						encoder->gbFileHeader.gbfInfo[nCurrItem].gbiDataOff);
 			pTmp = (GB_BYTE*)GreyBit_Malloc(encoder->gbMem,
 						encoder->gbFileHeader.gbfInfo[nCurrItem].gbiDataSize);
 			GreyBit_Stream_Seek(encoder->gbCreator[nCurrItem], 0);
@@ -199,9 +389,6 @@ GB_INT32	GreyCombineFile_Encoder_WriteAll(GCF_Encoder encoder)
 
 GB_INT32	GreyCombineFile_Encoder_BuildAll(GCF_Encoder encoder)
 {
-	GB_INT32	nCurrItem = 0;
-
-	nOffset = sizeof(GREYCOMBINEFILEHEADER);
 	encoder->gbFileHeader.gbfTag[0] = 'g';
 	encoder->gbFileHeader.gbfTag[1] = 'c';
 	encoder->gbFileHeader.gbfTag[2] = 't';
@@ -270,7 +457,8 @@ GB_Encoder	GreyCombineFile_Encoder_New(GB_Creator creator, GB_Stream stream)
 {
 	GCF_Encoder	codec;
 
-	codec = (GCF_Encoder)GreyBit_Malloc(creator->gbMem, sizeof(GCF_Encoder));
+	codec = (GCF_Encoder)GreyBit_Malloc(creator->gbMem,
+										sizeof(GCF_EncoderRec));
 	if (codec)
 	{
 		codec->gbEncoder.getcount = GreyCombineFile_Encoder_GetCount;
@@ -278,11 +466,16 @@ GB_Encoder	GreyCombineFile_Encoder_New(GB_Creator creator, GB_Stream stream)
 		codec->gbEncoder.remove = GreyCombineFile_Encoder_Delete;
 		codec->gbEncoder.encode = GreyCombineFile_Encoder_Encode;
 		codec->gbEncoder.flush = GreyCombineFile_Encoder_Flush;
+		codec->gbEncoder.bake = GreyCombineFile_Encoder_Bake;
 		codec->gbEncoder.done = GreyCombineFile_Encoder_Done;
 		codec->gbLibrary = creator->gbLibrary;
 		codec->gbMem = creator->gbMem;
 		codec->gbStream = stream;
 		GB_MEMSET(codec->gbCreator, 0, sizeof(GB_Stream)*GCF_ITEM_MAX);
+		GB_MEMSET(&codec->gbFileHeader, 0, sizeof(GREYCOMBINEFILEHEADER));
+		codec->nHeight = 0;
+		nCurrItemCount = 0;
+		nOffset = sizeof(GREYCOMBINEFILEHEADER);
 	}
 	return (GB_Encoder)codec;
 }
@@ -8,6 +8,11 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Pack plain records without allocating
+** 10/18/2026	me				Pre-flattened polyline records
+** 10/18/2026	me				Encode-time outline simplification
+** 10/18/2026	me				Glyph bounding boxes
+** 10/18/2026	me				Delta coded records
 ** 09/16/2023	me				Upgrade
 ** 08/07/2023	me              Init
 ** ===========================================================================
@@ -30,6 +35,15 @@
 **----------------------------------------------------------------------------
 */
 
+/* Read a varint at p into v, returning 0 from the caller past e */
+#define GVF_READ_VARINT(p,e,v)	do { GB_INT32 nShift_ = 0; (v) = 0;		\
+									do { if ((p) >= (e) || nShift_ > 28)	\
+											 return 0;						\
+										 (v) |= (GB_UINT32)(*(p) & 0x7F)	\
+											  << nShift_;					\
+										 nShift_ += 7;						\
+									} while (*(p)++ & 0x80); } while (0)
+
 /*
 **----------------------------------------------------------------------------
 **  Type Definitions
@@ -110,7 +124,7 @@ GVF_Outline	GreyVector_Outline_Clone(GB_Library library,
 	{
 		for (i = 0; i < outline->n_contours; ++i)
 			outline->contours[i] = source->contours[i];
-		for (ia = 0; ia < outline->n_contours; ++ia)
+		for (ia = 0; ia < outline->n_points; ++ia)
 			outline->points[ia] = source->points[ia];
 	}
 	return outline;
@@ -212,8 +226,8 @@ GVF_Outline	GreyVector_Outline_NewByGB(GB_Library library, GB_Outline source)
 			outline->contours[i] =  (GB_BYTE)source->contours[i];
 		for (ia = 0; ia < outline->n_points; ++ia)
 		{
-			outline->points[ia].x = (GB_BYTE)source->points[ia].x >> 6;
-			outline->points[ia].y = (GB_BYTE)source->points[ia].y >> 6;
+			outline->points[ia].x = (GB_BYTE)(source->points[ia].x >> 6);
+			outline->points[ia].y = (GB_BYTE)(source->points[ia].y >> 6);
 			outline->points[ia].x = (GB_BYTE)source->tags[ia] & 1
 								  | (2 * outline->points[ia].x);
 			outline->points[ia].y = (GB_BYTE)(source->tags[ia] >> 1) & 1
@@ -223,6 +237,38 @@ GVF_Outline	GreyVector_Outline_NewByGB(GB_Library library, GB_Outline source)
 	return outline;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_PackGB
+** Description: Pack a GB outline as a plain GVF record, the bytes
+**              GreyVector_Outline_NewByGB would hold, without allocating
+** Input: source - outline at font height, at most 255 contours and points
+**        pData - data buffer
+** Output: Packed record
+** Return value: record size
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Outline_PackGB(GB_Outline source, GB_BYTE* pData)
+{
+	int			i;
+	GB_BYTE*	pPoints;
+
+	pData[0] = (GB_BYTE)source->n_contours;
+	pData[1] = (GB_BYTE)source->n_points;
+	for (i = 0; i < source->n_contours; ++i)
+		pData[2 + i] = (GB_BYTE)source->contours[i];
+	pPoints = pData + 2 + source->n_contours;
+	for (i = 0; i < source->n_points; ++i)
+	{
+		pPoints[i * 2] = (GB_BYTE)((source->tags[i] & 1)
+								 | (2 * (GB_BYTE)(source->points[i].x >> 6)));
+		pPoints[i * 2 + 1] = (GB_BYTE)(((source->tags[i] >> 1) & 1)
+								 | (2 * (GB_BYTE)(source->points[i].y >> 6)));
+	}
+	return 2 + source->n_contours + 2 * source->n_points;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVector_Outline_NewByGVF
@@ -249,8 +295,8 @@ GB_Outline GreyBitType_Outline_NewByGVF(GB_Library library,GVF_Outline source)
 		for (ia = 0; ia < outline->n_points; ++ia)
 		{
 			outline->points[ia].x = source->points[ia].x >> 1 << 6;
-			outline->points[ia].y = source->points[ia].y << 6;
-			outline->tags[ia] = source->points[ia].y & 1
+			outline->points[ia].y = source->points[ia].y >> 1 << 6;
+			outline->tags[ia] = (2 * (source->points[ia].y & 1))
 							  | source->points[ia].x & 1;
 		}
 	}
@@ -287,4 +333,864 @@ GB_Outline GreyBitType_Outline_UpdateByGVF(GB_Outline outline,
 	}
 	return outline;
 }
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_PutVarint
+** Description: Store a value 7 bits a byte, low bits first, the top bit of
+**              a byte set when more follow
+** Input: pData - data buffer, 0 to only count
+**        nValue - value
+** Output: Stored value
+** Return value: bytes taken
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_PutVarint(GB_BYTE* pData, GB_UINT32 nValue)
+{
+	GB_INT32	nBytes;
+
+	for (nBytes = 1; nValue >= 0x80; ++nBytes)
+	{
+		if (pData)
+			*pData++ = (GB_BYTE)(nValue | 0x80);
+		nValue >>= 7;
+	}
+	if (pData)
+		*pData = (GB_BYTE)nValue;
+	return nBytes;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_PackDelta
+** Description: Pack an outline as a delta coded record: 16 bit contour and
+**              point counts, contour ends as varint steps from the previous
+**              end, the tags 2 bits a point, then x and y of every point in
+**              1/16 pixel as zigzag varint steps from the previous point.
+**              With GVF_FLAG_FLAT all points are on points and the tags
+**              are left out.
+** Input: source - outline at font height
+**        pData - data buffer, 0 to only count
+**        nFlags - font flags
+** Output: Packed record
+** Return value: record size
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Outline_PackDelta(GB_Outline source, GB_BYTE* pData,
+										 GB_UINT32 nFlags)
+{
+	GB_INT32	nPos;
+	GB_INT32	nPrev;
+	GB_INT32	nTags;
+	GB_INT32	x;
+	GB_INT32	y;
+	GB_INT32	nLastX;
+	GB_INT32	nLastY;
+	int			i;
+
+	if (pData)
+	{
+		pData[0] = (GB_BYTE)source->n_contours;
+		pData[1] = (GB_BYTE)(source->n_contours >> 8);
+		pData[2] = (GB_BYTE)source->n_points;
+		pData[3] = (GB_BYTE)(source->n_points >> 8);
+	}
+	nPos = 4;
+	nPrev = -1;
+	for (i = 0; i < source->n_contours; ++i)
+	{
+		nPos += GreyVector_PutVarint(pData ? pData + nPos : 0,
+									 (GB_UINT32)(source->contours[i] - nPrev));
+		nPrev = source->contours[i];
+	}
+	nTags = (nFlags & GVF_FLAG_FLAT) ? 0 : (source->n_points + 3) / 4;
+	if (pData && nTags)
+	{
+		GB_MEMSET(pData + nPos, 0, nTags);
+		for (i = 0; i < source->n_points; ++i)
+			pData[nPos + (i >> 2)] |= (GB_BYTE)((source->tags[i] & 3)
+												<< ((i & 3) << 1));
+	}
+	nPos += nTags;
+	nLastX = 0;
+	nLastY = 0;
+	for (i = 0; i < source->n_points; ++i)
+	{
+		x = ((GB_INT32)source->points[i].x + (1 << (GVF_DELTA_SHIFT - 1)))
+		  >> GVF_DELTA_SHIFT;
+		y = ((GB_INT32)source->points[i].y + (1 << (GVF_DELTA_SHIFT - 1)))
+		  >> GVF_DELTA_SHIFT;
+		nPos += GreyVector_PutVarint(pData ? pData + nPos : 0,
+									 GVF_ZIGZAG(x - nLastX));
+		nPos += GreyVector_PutVarint(pData ? pData + nPos : 0,
+									 GVF_ZIGZAG(y - nLastY));
+		nLastX = x;
+		nLastY = y;
+	}
+	return nPos;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Outline_UpdateByDelta
+** Description: Update outline from a delta coded record, in one pass over
+**              the record
+** Input: outline - outline, room for nMaxContours/nMaxPoints
+**        pData - record data
+**        nLength - record size
+**        nMaxContours - contours the outline has room for
+**        nMaxPoints - points the outline has room for
+**        nFlags - font flags
+** Output: Updated outline
+** Return value: outline/0 if the record is damaged
+** ---------------------------------------------------------------------------
+*/
+
+GB_Outline	GreyBitType_Outline_UpdateByDelta(GB_Outline outline,
+											  GB_BYTE* pData,
+											  GB_INT32 nLength,
+											  GB_INT16 nMaxContours,
+											  GB_INT16 nMaxPoints,
+											  GB_UINT32 nFlags)
+{
+	GB_BYTE*	pEnd;
+	GB_BYTE*	pTags;
+	GB_UINT32	nValue;
+	GB_INT32	n_contours;
+	GB_INT32	n_points;
+	GB_INT32	nPrev;
+	GB_INT32	x;
+	GB_INT32	y;
+	int			i;
+
+	if (nLength < 4)
+		return 0;
+	pEnd = pData + nLength;
+	n_contours = pData[0] | (pData[1] << 8);
+	n_points = pData[2] | (pData[3] << 8);
+	if (n_contours > nMaxContours || n_points > nMaxPoints)
+		return 0;
+	pData += 4;
+	nPrev = -1;
+	for (i = 0; i < n_contours; ++i)
+	{
+		GVF_READ_VARINT(pData, pEnd, nValue);
+		if (!nValue || nValue >= (GB_UINT32)(n_points - nPrev))
+			return 0;
+		nPrev += nValue;
+		outline->contours[i] = (GB_INT16)nPrev;
+	}
+	pTags = pData;
+	if (!(nFlags & GVF_FLAG_FLAT))
+		pData += (n_points + 3) / 4;
+	x = 0;
+	y = 0;
+	for (i = 0; i < n_points; ++i)
+	{
+		GVF_READ_VARINT(pData, pEnd, nValue);
+		x += GVF_UNZIGZAG(nValue);
+		GVF_READ_VARINT(pData, pEnd, nValue);
+		y += GVF_UNZIGZAG(nValue);
+		outline->points[i].x = (GB_Pos)(x << GVF_DELTA_SHIFT);
+		outline->points[i].y = (GB_Pos)(y << GVF_DELTA_SHIFT);
+		if (nFlags & GVF_FLAG_FLAT)
+			outline->tags[i] = GB_CURVE_TAG_ON;
+		else
+			outline->tags[i] = (GB_BYTE)((pTags[i >> 2] >> ((i & 3) << 1))
+										 & 3);
+	}
+	outline->n_contours = (GB_INT16)n_contours;
+	outline->n_points = (GB_INT16)n_points;
+	return outline;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyBitType_Outline_GetBBox
+** Description: Get the bounding box of an outline
+** Input: outline - outline
+** Output: bbox - box of the points, all 0 for an empty outline
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyBitType_Outline_GetBBox(GB_Outline outline, GB_BBox* bbox)
+{
+	GB_Point	vec;
+	GB_Point	limit;
+
+	if (outline->n_points <= 0)
+	{
+		bbox->xMin = bbox->xMax = 0;
+		bbox->yMin = bbox->yMax = 0;
+		return;
+	}
+	vec = outline->points;
+	limit = vec + outline->n_points;
+	bbox->xMin = bbox->xMax = vec->x;
+	bbox->yMin = bbox->yMax = vec->y;
+	for (vec++; vec < limit; vec++)
+	{
+		if (vec->x < bbox->xMin) bbox->xMin = vec->x;
+		if (vec->x > bbox->xMax) bbox->xMax = vec->x;
+		if (vec->y < bbox->yMin) bbox->yMin = vec->y;
+		if (vec->y > bbox->yMax) bbox->yMax = vec->y;
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_GetBBox
+** Description: Get the bounding box of a GVF outline, in 26.6
+** Input: outline - GVF outline
+** Output: bbox - box of the points, all 0 for an empty outline
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyVector_Outline_GetBBox(GVF_Outline outline, GB_BBox* bbox)
+{
+	GB_BYTE	min_x, max_x, min_y, max_y;
+	int		i;
+
+	if (!outline->n_points)
+	{
+		bbox->xMin = bbox->xMax = 0;
+		bbox->yMin = bbox->yMax = 0;
+		return;
+	}
+	min_x = max_x = outline->points[0].x >> 1;
+	min_y = max_y = outline->points[0].y >> 1;
+	for (i = 1; i < outline->n_points; ++i)
+	{
+		GB_BYTE	x = outline->points[i].x >> 1;
+		GB_BYTE	y = outline->points[i].y >> 1;
+
+		if (x < min_x) min_x = x;
+		if (x > max_x) max_x = x;
+		if (y < min_y) min_y = y;
+		if (y > max_y) max_y = y;
+	}
+	bbox->xMin = (GB_Pos)(min_x << 6);
+	bbox->yMin = (GB_Pos)(min_y << 6);
+	bbox->xMax = (GB_Pos)(max_x << 6);
+	bbox->yMax = (GB_Pos)(max_y << 6);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_PackBBox
+** Description: Pack the bounding box of an outline in whole pixels: left and
+**              top as zigzag varints, then width and height as varints
+** Input: source - outline at font height
+**        pData - data buffer, 0 to only count
+** Output: Packed box
+** Return value: box size, at most GVF_BBOX_MAXSIZE
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Outline_PackBBox(GB_Outline source, GB_BYTE* pData)
+{
+	GB_BBox		bbox;
+	GB_INT32	nLeft;
+	GB_INT32	nTop;
+	GB_INT32	nPos;
+
+	GreyBitType_Outline_GetBBox(source, &bbox);
+	nLeft = bbox.xMin >> 6;
+	nTop = bbox.yMin >> 6;
+	nPos = GreyVector_PutVarint(pData, GVF_ZIGZAG(nLeft));
+	nPos += GreyVector_PutVarint(pData ? pData + nPos : 0, GVF_ZIGZAG(nTop));
+	nPos += GreyVector_PutVarint(pData ? pData + nPos : 0,
+						(GB_UINT32)((((GB_INT32)bbox.xMax + 63) >> 6) - nLeft));
+	nPos += GreyVector_PutVarint(pData ? pData + nPos : 0,
+						(GB_UINT32)((((GB_INT32)bbox.yMax + 63) >> 6) - nTop));
+	return nPos;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_UnpackBBox
+** Description: Unpack a bounding box stored ahead of a record
+** Input: pData - record data
+**        nLength - record size
+** Output: bbox - box in 26.6, whole pixels
+** Return value: box size/0 if the record is damaged
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Outline_UnpackBBox(GB_BBox* bbox, GB_BYTE* pData,
+										  GB_INT32 nLength)
+{
+	GB_BYTE*	pStart;
+	GB_BYTE*	pEnd;
+	GB_UINT32	nValue;
+	GB_INT32	nLeft;
+	GB_INT32	nTop;
+
+	pStart = pData;
+	pEnd = pData + nLength;
+	GVF_READ_VARINT(pData, pEnd, nValue);
+	nLeft = GVF_UNZIGZAG(nValue);
+	GVF_READ_VARINT(pData, pEnd, nValue);
+	nTop = GVF_UNZIGZAG(nValue);
+	bbox->xMin = (GB_Pos)(nLeft << 6);
+	bbox->yMin = (GB_Pos)(nTop << 6);
+	GVF_READ_VARINT(pData, pEnd, nValue);
+	bbox->xMax = (GB_Pos)((nLeft + (GB_INT32)nValue) << 6);
+	GVF_READ_VARINT(pData, pEnd, nValue);
+	bbox->yMax = (GB_Pos)((nTop + (GB_INT32)nValue) << 6);
+	return (GB_INT32)(pData - pStart);
+}
+#ifdef ENABLE_ENCODER
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Sqrt
+** Description: Integer square root
+** Input: nValue - value
+** Output: None
+** Return value: root, rounded down
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Sqrt(GB_UINT32 nValue)
+{
+	GB_UINT32	nRoot;
+	GB_UINT32	nBit;
+
+	nRoot = 0;
+	nBit = (GB_UINT32)1 << 30;
+	while (nBit > nValue)
+		nBit >>= 2;
+	while (nBit)
+	{
+		if (nValue >= nRoot + nBit)
+		{
+			nValue -= nRoot + nBit;
+			nRoot = (nRoot >> 1) + nBit;
+		}
+		else
+			nRoot >>= 1;
+		nBit >>= 2;
+	}
+	return (GB_INT32)nRoot;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_SegDist
+** Description: Distance of a point from a segment
+** Input: px, py - point
+**        ax, ay - segment start
+**        bx, by - segment end
+** Output: None
+** Return value: distance in 26.6/GVF_SIMPLIFY_FAR if the points are too
+**               far apart to tell
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_SegDist(GB_INT32 px, GB_INT32 py, GB_INT32 ax,
+							   GB_INT32 ay, GB_INT32 bx, GB_INT32 by)
+{
+	GB_INT32	dx;
+	GB_INT32	dy;
+	GB_INT32	nDot;
+	GB_INT32	nLen2;
+	GB_INT32	nCross;
+
+	dx = bx - ax;
+	dy = by - ay;
+	px -= ax;
+	py -= ay;
+	if (GVF_SIMPLIFY_OUT(dx) || GVF_SIMPLIFY_OUT(dy)
+	 || GVF_SIMPLIFY_OUT(px) || GVF_SIMPLIFY_OUT(py))
+		return GVF_SIMPLIFY_FAR;
+	nDot = px * dx + py * dy;
+	nLen2 = dx * dx + dy * dy;
+	if (nDot <= 0 || !nLen2)
+		return GreyVector_Sqrt((GB_UINT32)(px * px + py * py));
+	if (nDot >= nLen2)
+	{
+		px -= dx;
+		py -= dy;
+		return GreyVector_Sqrt((GB_UINT32)(px * px) + (GB_UINT32)(py * py));
+	}
+	nCross = px * dy - py * dx;
+	if (nCross < 0)
+		nCross = -nCross;
+	return nCross / GreyVector_Sqrt((GB_UINT32)nLen2);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Conic_Sample
+** Description: Sample a conic arc at nSteps + 1 points
+** Input: pArc - start, control and end as x, y pairs
+**        nSteps - steps
+** Output: pPoly - points as x, y pairs
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyVector_Conic_Sample(GB_INT32* pArc, GB_INT32 nSteps,
+									GB_INT32* pPoly)
+{
+	GB_INT32	k;
+	GB_INT32	j;
+	GB_INT32	n;
+
+	n = nSteps;
+	for (k = 0; k <= n; ++k)
+	{
+		for (j = 0; j < 2; ++j)
+			pPoly[k * 2 + j] = (pArc[j] * (n - k) * (n - k)
+							 + 2 * pArc[2 + j] * k * (n - k)
+							 + pArc[4 + j] * k * k + n * n / 2) / (n * n);
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_PolyDist
+** Description: Farthest distance of the points of a polyline from another
+** Input: pFrom - points as x, y pairs
+**        nFrom - point count
+**        pTo - polyline as x, y pairs
+**        nTo - point count
+** Output: None
+** Return value: distance in 26.6
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_PolyDist(GB_INT32* pFrom, GB_INT32 nFrom,
+								GB_INT32* pTo, GB_INT32 nTo)
+{
+	GB_INT32	i;
+	GB_INT32	j;
+	GB_INT32	nDist;
+	GB_INT32	nMin;
+	GB_INT32	nMax;
+
+	nMax = 0;
+	for (i = 0; i < nFrom; ++i, pFrom += 2)
+	{
+		nMin = GVF_SIMPLIFY_FAR;
+		for (j = 0; j + 1 < nTo && nMin > nMax; ++j)
+		{
+			nDist = GreyVector_SegDist(pFrom[0], pFrom[1], pTo[j * 2],
+									   pTo[j * 2 + 1], pTo[j * 2 + 2],
+									   pTo[j * 2 + 3]);
+			if (nDist < nMin)
+				nMin = nDist;
+		}
+		if (nMin > nMax)
+			nMax = nMin;
+	}
+	return nMax;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_Merge
+** Description: Try to drop the point at idx: a conic control close to the
+**              chord of its on points, an on point close to the segment of
+**              its on neighbours, or an on point joining two conic arcs
+**              that one arc through it follows within the tolerance
+** Input: outline - outline
+**        first - first point of the contour
+**        last - last point of the contour
+**        idx - point index
+**        nTolerance - tolerance in 26.6
+** Output: Simplified outline
+** Return value: points removed
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Outline_Merge(GB_Outline outline, GB_INT16 first,
+									 GB_INT16 last, GB_INT16 idx,
+									 GB_INT32 nTolerance)
+{
+	GB_INT16	p;
+	GB_INT16	q;
+	GB_INT16	pp;
+	GB_INT16	qq;
+	GB_INT32	x;
+	GB_INT32	y;
+	GB_INT32	arc[6];
+	GB_INT32	old[(GVF_SIMPLIFY_STEPS * 2 + 1) * 2];
+	GB_INT32	neu[(GVF_SIMPLIFY_STEPS * 2 + 1) * 2];
+	GB_Point	pt;
+
+	pt = outline->points;
+	p = idx == first ? last : idx - 1;
+	q = idx == last ? first : idx + 1;
+	if (GB_CURVE_TAG(outline->tags[p]) != GB_CURVE_TAG(outline->tags[q]))
+		return 0;
+	if (GB_CURVE_TAG(outline->tags[p]) == GB_CURVE_TAG_ON)
+	{
+		/* a conic arc deviates half as far from its chord as the control */
+		if (GB_CURVE_TAG(outline->tags[idx]) == GB_CURVE_TAG_CUBIC
+		 || GreyVector_SegDist(pt[idx].x, pt[idx].y, pt[p].x, pt[p].y,
+							   pt[q].x, pt[q].y)
+		  > (GB_CURVE_TAG(outline->tags[idx]) == GB_CURVE_TAG_ON
+			 ? nTolerance : nTolerance * 2))
+			return 0;
+		GreyBitType_Outline_Remove(outline, idx);
+		return 1;
+	}
+	if (GB_CURVE_TAG(outline->tags[p]) != GB_CURVE_TAG_CONIC
+	 || GB_CURVE_TAG(outline->tags[idx]) != GB_CURVE_TAG_ON
+	 || last - first < 4)
+		return 0;
+	pp = p == first ? last : p - 1;
+	qq = q == last ? first : q + 1;
+	if (GB_CURVE_TAG(outline->tags[pp]) != GB_CURVE_TAG_ON
+	 || GB_CURVE_TAG(outline->tags[qq]) != GB_CURVE_TAG_ON)
+		return 0;
+
+	/* one arc from pp to qq passing through idx halfway */
+	x = 2 * pt[idx].x - (pt[pp].x + pt[qq].x) / 2;
+	y = 2 * pt[idx].y - (pt[pp].y + pt[qq].y) / 2;
+	if (x < -32768 || x > 32767 || y < -32768 || y > 32767)
+		return 0;
+	arc[0] = pt[pp].x;
+	arc[1] = pt[pp].y;
+	arc[2] = pt[p].x;
+	arc[3] = pt[p].y;
+	arc[4] = pt[idx].x;
+	arc[5] = pt[idx].y;
+	GreyVector_Conic_Sample(arc, GVF_SIMPLIFY_STEPS, old);
+	arc[0] = pt[idx].x;
+	arc[1] = pt[idx].y;
+	arc[2] = pt[q].x;
+	arc[3] = pt[q].y;
+	arc[4] = pt[qq].x;
+	arc[5] = pt[qq].y;
+	GreyVector_Conic_Sample(arc, GVF_SIMPLIFY_STEPS,
+							old + GVF_SIMPLIFY_STEPS * 2);
+	arc[0] = pt[pp].x;
+	arc[1] = pt[pp].y;
+	arc[2] = x;
+	arc[3] = y;
+	GreyVector_Conic_Sample(arc, GVF_SIMPLIFY_STEPS * 2, neu);
+	if (GreyVector_PolyDist(old, GVF_SIMPLIFY_STEPS * 2 + 1, neu,
+							GVF_SIMPLIFY_STEPS * 2 + 1) > nTolerance
+	 || GreyVector_PolyDist(neu, GVF_SIMPLIFY_STEPS * 2 + 1, old,
+							GVF_SIMPLIFY_STEPS * 2 + 1) > nTolerance)
+		return 0;
+	pt[p].x = (GB_Pos)x;
+	pt[p].y = (GB_Pos)y;
+	GreyBitType_Outline_Remove(outline, idx > q ? idx : q);
+	GreyBitType_Outline_Remove(outline, idx > q ? q : idx);
+	return 2;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_Simplify
+** Description: Drop points that move the outline by no more than the
+**              tolerance, so fewer lines and arcs reach the raster. Cubic
+**              controls are kept and every contour keeps 3 points.
+** Input: outline - outline at font height
+**        nTolerance - tolerance in 26.6
+** Output: Simplified outline
+** Return value: points removed
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Outline_Simplify(GB_Outline outline,
+										GB_INT32 nTolerance)
+{
+	GB_INT16	c;
+	GB_INT16	i;
+	GB_INT16	first;
+	GB_INT32	nRemoved;
+	GB_INT32	nCount;
+	GB_BOOL		bChanged;
+
+	nRemoved = 0;
+	first = 0;
+	for (c = 0; c < outline->n_contours && nTolerance > 0; ++c)
+	{
+		do
+		{
+			bChanged = 0;
+			for (i = first; i <= outline->contours[c]
+						 && outline->contours[c] - first >= 3;)
+			{
+				nCount = GreyVector_Outline_Merge(outline, first,
+												  outline->contours[c], i,
+												  nTolerance);
+				if (!nCount)
+				{
+					++i;
+					continue;
+				}
+				nRemoved += nCount;
+				bChanged = 1;
+			}
+		} while (bChanged);
+		first = outline->contours[c] + 1;
+	}
+	return nRemoved;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Flatten_Arc
+** Description: Add the points of a conic or cubic arc as a polyline, cut
+**              into the fewest equal steps that keep it within the
+**              tolerance
+** Input: outline - outline to fill, 0 to only count
+**        nCount - points so far
+**        pArc - start, controls and end as x, y pairs
+**        nOrder - 2 for a conic, 3 for a cubic
+**        nTolerance - tolerance in 26.6
+**        bClose - arc ends at the contour start, which is not added again
+** Output: Flattened arc
+** Return value: points so far
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Flatten_Arc(GB_Outline outline, GB_INT32 nCount,
+								   GB_INT32* pArc, GB_INT32 nOrder,
+								   GB_INT32 nTolerance, GB_BOOL bClose)
+{
+	GB_INT32	nDev;
+	GB_INT32	nDev2;
+	GB_INT32	nSteps;
+	GB_INT32	nMax;
+	GB_INT32	k;
+	GB_INT32	j;
+	GB_INT32	a;
+	GB_INT32	b;
+	GB_INT32	v[2];
+
+	/* an arc strays from its chord by a quarter of its second difference */
+	nDev = GVF_ABS(pArc[0] - 2 * pArc[2] + pArc[4])
+		 + GVF_ABS(pArc[1] - 2 * pArc[3] + pArc[5]);
+	if (nOrder == 2)
+	{
+		nDev /= 4;
+		nMax = GVF_FLATTEN_MAXCONIC;
+	}
+	else
+	{
+		nDev2 = GVF_ABS(pArc[2] - 2 * pArc[4] + pArc[6])
+			  + GVF_ABS(pArc[3] - 2 * pArc[5] + pArc[7]);
+		nDev = (nDev > nDev2 ? nDev : nDev2) * 3 / 4;
+		nMax = GVF_FLATTEN_MAXCUBIC;
+	}
+	for (nSteps = 1; nSteps < nMax && nDev > nTolerance * nSteps * nSteps;
+		 ++nSteps)
+		;
+	for (k = 1; k <= nSteps - (bClose ? 1 : 0); ++k)
+	{
+		a = nSteps - k;
+		b = k;
+		for (j = 0; j < 2; ++j)
+		{
+			if (nOrder == 2)
+				v[j] = (pArc[j] * a * a + 2 * pArc[2 + j] * a * b
+					 + pArc[4 + j] * b * b) / (nSteps * nSteps);
+			else
+				v[j] = (pArc[j] * a * a * a + 3 * pArc[2 + j] * a * a * b
+					 + 3 * pArc[4 + j] * a * b * b + pArc[6 + j] * b * b * b)
+					 / (nSteps * nSteps * nSteps);
+		}
+		if (outline)
+		{
+			outline->points[nCount].x = (GB_Pos)v[0];
+			outline->points[nCount].y = (GB_Pos)v[1];
+			outline->tags[nCount] = GB_CURVE_TAG_ON;
+		}
+		++nCount;
+	}
+	return nCount;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_FlattenTo
+** Description: Walk the contours the way the raster does and turn every
+**              arc into on points
+** Input: source - outline at font height
+**        nTolerance - tolerance in 26.6
+**        outline - outline to fill, 0 to only count
+** Output: Flattened outline
+** Return value: points/-1 if the outline is invalid
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVector_Outline_FlattenTo(GB_Outline source,
+										 GB_INT32 nTolerance,
+										 GB_Outline outline)
+{
+	GB_INT32	n;
+	GB_INT32	first;
+	GB_INT32	last;
+	GB_INT32	limit;
+	GB_INT32	point;
+	GB_INT32	nCount;
+	GB_INT32	sx;
+	GB_INT32	sy;
+	GB_INT32	arc[8];
+	GB_BYTE		tag;
+	GB_Point	pt;
+
+	pt = source->points;
+	nCount = 0;
+	first = 0;
+	for (n = 0; n < source->n_contours; ++n)
+	{
+		last = source->contours[n];
+		if (last < first || last >= source->n_points)
+			return -1;
+		limit = last;
+		point = first;
+		sx = pt[first].x;
+		sy = pt[first].y;
+		tag = GB_CURVE_TAG(source->tags[first]);
+		if (tag == GB_CURVE_TAG_CUBIC)
+			return -1;
+		if (tag == GB_CURVE_TAG_CONIC)
+		{
+			if (GB_CURVE_TAG(source->tags[last]) == GB_CURVE_TAG_ON)
+			{
+				sx = pt[last].x;
+				sy = pt[last].y;
+				limit--;
+			}
+			else
+			{
+				sx = (sx + pt[last].x) / 2;
+				sy = (sy + pt[last].y) / 2;
+			}
+			point--;
+		}
+		if (outline)
+		{
+			outline->points[nCount].x = (GB_Pos)sx;
+			outline->points[nCount].y = (GB_Pos)sy;
+			outline->tags[nCount] = GB_CURVE_TAG_ON;
+		}
+		++nCount;
+		arc[0] = sx;
+		arc[1] = sy;
+		while (point < limit)
+		{
+			tag = GB_CURVE_TAG(source->tags[++point]);
+			if (tag == GB_CURVE_TAG_ON)
+			{
+				arc[0] = pt[point].x;
+				arc[1] = pt[point].y;
+				if (outline)
+				{
+					outline->points[nCount].x = pt[point].x;
+					outline->points[nCount].y = pt[point].y;
+					outline->tags[nCount] = GB_CURVE_TAG_ON;
+				}
+				++nCount;
+				continue;
+			}
+			if (tag == GB_CURVE_TAG_CONIC)
+			{
+				arc[2] = pt[point].x;
+				arc[3] = pt[point].y;
+				while (point < limit)
+				{
+					tag = GB_CURVE_TAG(source->tags[++point]);
+					if (tag == GB_CURVE_TAG_ON)
+					{
+						arc[4] = pt[point].x;
+						arc[5] = pt[point].y;
+						break;
+					}
+					if (tag != GB_CURVE_TAG_CONIC)
+						return -1;
+					/* two controls in a row imply an on point halfway */
+					arc[4] = (arc[2] + pt[point].x) / 2;
+					arc[5] = (arc[3] + pt[point].y) / 2;
+					nCount = GreyVector_Flatten_Arc(outline, nCount, arc, 2,
+													nTolerance, 0);
+					arc[0] = arc[4];
+					arc[1] = arc[5];
+					arc[2] = pt[point].x;
+					arc[3] = pt[point].y;
+				}
+				if (tag != GB_CURVE_TAG_ON)
+				{
+					arc[4] = sx;
+					arc[5] = sy;
+					nCount = GreyVector_Flatten_Arc(outline, nCount, arc, 2,
+													nTolerance, 1);
+					break;
+				}
+				nCount = GreyVector_Flatten_Arc(outline, nCount, arc, 2,
+												nTolerance, 0);
+				arc[0] = arc[4];
+				arc[1] = arc[5];
+				continue;
+			}
+			if (point + 1 > limit
+			 || GB_CURVE_TAG(source->tags[point + 1]) != GB_CURVE_TAG_CUBIC)
+				return -1;
+			arc[2] = pt[point].x;
+			arc[3] = pt[point].y;
+			arc[4] = pt[point + 1].x;
+			arc[5] = pt[point + 1].y;
+			point += 2;
+			if (point > limit)
+			{
+				arc[6] = sx;
+				arc[7] = sy;
+				nCount = GreyVector_Flatten_Arc(outline, nCount, arc, 3,
+												nTolerance, 1);
+				break;
+			}
+			arc[6] = pt[point].x;
+			arc[7] = pt[point].y;
+			nCount = GreyVector_Flatten_Arc(outline, nCount, arc, 3,
+											nTolerance, 0);
+			arc[0] = arc[6];
+			arc[1] = arc[7];
+		}
+		if (outline)
+			outline->contours[n] = (GB_INT16)(nCount - 1);
+		first = last + 1;
+	}
+	return nCount;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVector_Outline_Flatten
+** Description: Make a copy of an outline with every conic and cubic arc
+**              cut into lines, so only on points are left
+** Input: library - library
+**        source - outline at font height
+**        nTolerance - tolerance in 26.6
+** Output: None
+** Return value: flattened outline/0 if it is invalid or too large
+** ---------------------------------------------------------------------------
+*/
+
+GB_Outline	GreyVector_Outline_Flatten(GB_Library library, GB_Outline source,
+									   GB_INT32 nTolerance)
+{
+	GB_INT32	nCount;
+	GB_Outline	outline;
+
+	nCount = GreyVector_Outline_FlattenTo(source, nTolerance, 0);
+	if (nCount < 0 || nCount > 0x7FFF)
+		return 0;
+	outline = GreyBitType_Outline_New(library, source->n_contours,
+									  (GB_INT16)nCount);
+	if (outline)
+		GreyVector_Outline_FlattenTo(source, nTolerance, outline);
+	return outline;
+}
+#endif //ENABLE_ENCODER
 #endif //ENABLE_GREYVECTORFILE
\ No newline at end of file
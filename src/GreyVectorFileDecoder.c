@@ -8,6 +8,20 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Tables ahead of the records without GVF_FLAG_TAIL
+** 10/18/2026	me				Outline header kept aligned behind the box
+** 10/18/2026	me				Offsets looked up under the stream lock
+** 10/18/2026	me				Tables may follow the records
+** 10/18/2026	me				Pre-flattened polyline records
+** 10/18/2026	me				Glyph bounding boxes, ink box of decoded data
+** 10/18/2026	me				Delta coded records
+** 10/18/2026	me				Decode packed records
+** 10/18/2026	me				Scaled outline cache
+** 10/18/2026	me				Decode contexts
+** 10/18/2026	me				Ink rows of decoded data
+** 10/18/2026	me				Batch decode
+** 10/18/2026	me				Preload
+** 10/18/2026	me				Lazy section tables
 ** 09/16/2023	me				Upgrade
 ** 08/07/2023	me              Init
 ** ===========================================================================
@@ -54,6 +68,64 @@
 **----------------------------------------------------------------------------
 */
 
+#ifdef ENABLE_LAZYTABLE
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_LoadSection
+** Description: Load the table slices of a section on first access. The
+**              caller holds the stream lock or the font is not shared; a
+**              shared font had every section loaded before its first
+**              context. gbOffset is set last, once the slices are read.
+** Input: decoder - decoder
+**        UniIndex - unicode section index
+** Output: Loaded section tables
+** Return value: section tables/0 if section is not in font
+** ---------------------------------------------------------------------------
+*/
+
+SECTIONTABLE*	GreyVectorFile_Decoder_LoadSection(GVF_Decoder decoder,
+												   GB_INT32 UniIndex)
+{
+	GB_UINT16		WidthIdx;
+	GB_UINT16		SectionIndex;
+	GB_INT32		nSectionLen;
+	GB_BYTE*		pData;
+	GB_BYTE*		pWidth;
+	SECTIONTABLE*	section;
+
+	section = &decoder->gbSectionTable[UniIndex];
+	if (section->gbOffset)
+		return section;
+	WidthIdx = decoder->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
+	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
+	if (!WidthIdx || !SectionIndex)
+		return 0;
+	nSectionLen = UnicodeSection_GetSectionNum(UniIndex);
+	pData = (GB_BYTE *)GreyBit_Malloc(decoder->gbMem,
+									  nSectionLen * (sizeof(GB_UINT32) + 2));
+	if (!pData)
+		return 0;
+	pWidth = pData + sizeof(GB_UINT32) * nSectionLen;
+	GreyBit_Stream_Seek(decoder->gbStream,
+						decoder->gbInfoHeader.gbiOffsetTabOff
+					  + decoder->gbOffDataBits + sizeof(GB_UINT32)
+					  * (SectionIndex - 1));
+	GreyBit_Stream_Read(decoder->gbStream, pData,
+						sizeof(GB_UINT32) * nSectionLen);
+	GreyBit_Stream_Seek(decoder->gbStream, decoder->gbInfoHeader.gbiWidthTabOff
+					  + decoder->gbOffDataBits + WidthIdx - 1);
+	GreyBit_Stream_Read(decoder->gbStream, pWidth, nSectionLen);
+	GreyBit_Stream_Seek(decoder->gbStream,
+						decoder->gbInfoHeader.gbiHoriOffTabOff
+					  + decoder->gbOffDataBits + WidthIdx - 1);
+	GreyBit_Stream_Read(decoder->gbStream, pWidth + nSectionLen, nSectionLen);
+	section->gbWidth = pWidth;
+	section->gbHoriOff = (GB_INT8 *)(pWidth + nSectionLen);
+	section->gbOffset = (GB_UINT32 *)pData;
+	return section;
+}
+#endif //ENABLE_LAZYTABLE
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Decoder_CaheItem
@@ -71,12 +143,14 @@ GB_INT32	GreyVectorFile_Decoder_CaheItem(GVF_Decoder decoder,
 											GB_UINT32 nCode,
 											GB_Outline outline)
 {
-	GB_UINT16	nMinCode;
-	GB_UINT16	SectionIndex;
-	GB_INT32	UniIndex;
+	GB_UINT16		nMinCode;
+	GB_UINT16		SectionIndex;
+	GB_INT32		UniIndex;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
-	if (decoder->nGreyBitsCount >= decoder->nCacheItem
-	|| !decoder->gbOffsetTable)
+	if (decoder->nGreyBitsCount >= decoder->nCacheItem)
 		return GB_FAILED;
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
 	if (UniIndex >= UNICODE_SECTION_NUM)
@@ -84,15 +158,174 @@ GB_INT32	GreyVectorFile_Decoder_CaheItem(GVF_Decoder decoder,
 	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
 	if (!SectionIndex)
 		return GB_FAILED;
+#ifdef ENABLE_LAZYTABLE
+	section = GreyVectorFile_Decoder_LoadSection(decoder, UniIndex);
+	if (!section)
+		return GB_FAILED;
+#else
+	if (!decoder->gbOffsetTable)
+		return GB_FAILED;
+#endif //ENABLE_LAZYTABLE
 	decoder->gpGreyBits[decoder->nGreyBitsCount] = GreyBitType_Outline_Clone
 										 (decoder->gbLibrary, outline);
 	UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+#ifdef ENABLE_LAZYTABLE
+	section->gbOffset[nCode - nMinCode]=SET_RAM(decoder->nGreyBitsCount++);
+#else
 	SectionIndex--;
 	SectionIndex += (GB_UINT16)nCode - nMinCode;
 	decoder->gbOffsetTable[SectionIndex] = SET_RAM(decoder->nGreyBitsCount++);
+#endif //ENABLE_LAZYTABLE
 	return GB_SUCCESS;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_DropScaled
+** Description: Unlink a scaled outline from the hash and the LRU list and
+**              free it
+** Input: decoder - decoder
+**        scaled - scaled outline
+** Output: Dropped scaled outline
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyVectorFile_Decoder_DropScaled(GVF_Decoder decoder,
+											  GVF_Scaled scaled)
+{
+	GVF_Scaled*	ppLink;
+
+	ppLink = &decoder->gbScaleHash[GVF_SCALE_INDEX(scaled->nCode,
+												   scaled->nSize)];
+	while (*ppLink != scaled)
+		ppLink = &(*ppLink)->pNext;
+	*ppLink = scaled->pNext;
+	if (scaled->pNewer)
+		scaled->pNewer->pOlder = scaled->pOlder;
+	else
+		decoder->gbScaleNewest = scaled->pOlder;
+	if (scaled->pOlder)
+		scaled->pOlder->pNewer = scaled->pNewer;
+	else
+		decoder->gbScaleOldest = scaled->pNewer;
+	decoder->nScaleBytes -= scaled->nBytes;
+	GreyBitType_Outline_Done(decoder->gbLibrary, scaled->outline);
+	GreyBit_Free(decoder->gbMem, scaled);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_TrimScaled
+** Description: Drop least recently used scaled outlines until the cache
+**              holds no more than nBytes
+** Input: decoder - decoder
+**        nBytes - bytes to keep at most
+** Output: Trimmed scaled outline cache
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyVectorFile_Decoder_TrimScaled(GVF_Decoder decoder,
+											  GB_INT32 nBytes)
+{
+	while (decoder->gbScaleOldest && decoder->nScaleBytes > nBytes)
+		GreyVectorFile_Decoder_DropScaled(decoder, decoder->gbScaleOldest);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_FindScaled
+** Description: Find a scaled outline and mark it most recently used
+** Input: decoder - decoder
+**        nCode - code
+**        nSize - character size
+** Output: Found scaled outline, its box in decoder->gbBBox
+** Return value: outline/0 if not cached
+** ---------------------------------------------------------------------------
+*/
+
+GB_Outline	GreyVectorFile_Decoder_FindScaled(GVF_Decoder decoder,
+											  GB_UINT32 nCode,
+											  GB_INT16 nSize)
+{
+	GVF_Scaled	scaled;
+
+	scaled = decoder->gbScaleHash[GVF_SCALE_INDEX(nCode, nSize)];
+	while (scaled && (scaled->nCode != nCode || scaled->nSize != nSize))
+		scaled = scaled->pNext;
+	if (!scaled)
+		return 0;
+	if (scaled->pNewer)
+	{
+		scaled->pNewer->pOlder = scaled->pOlder;
+		if (scaled->pOlder)
+			scaled->pOlder->pNewer = scaled->pNewer;
+		else
+			decoder->gbScaleOldest = scaled->pNewer;
+		scaled->pOlder = decoder->gbScaleNewest;
+		scaled->pNewer = 0;
+		decoder->gbScaleNewest->pNewer = scaled;
+		decoder->gbScaleNewest = scaled;
+	}
+	decoder->gbBBox = scaled->bbox;
+	return scaled->outline;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_CacheScaled
+** Description: Keep a copy of an outline scaled to nSize, dropping least
+**              recently used ones to stay within the byte budget
+** Input: decoder - decoder
+**        nCode - code
+**        nSize - character size
+**        outline - outline at nSize, its box in decoder->gbBBox
+** Output: Cached scaled outline
+** Return value: cached outline/0 if it does not fit
+** ---------------------------------------------------------------------------
+*/
+
+GB_Outline	GreyVectorFile_Decoder_CacheScaled(GVF_Decoder decoder,
+											   GB_UINT32 nCode,
+											   GB_INT16 nSize,
+											   GB_Outline outline)
+{
+	GB_INT32	nBytes;
+	GB_INT32	nIndex;
+	GVF_Scaled	scaled;
+
+	nBytes = sizeof(GVF_ScaledRec) + GreyBitType_Outline_GetSize(outline);
+	if (nBytes > decoder->nScaleBudget)
+		return 0;
+	GreyVectorFile_Decoder_TrimScaled(decoder, decoder->nScaleBudget-nBytes);
+	scaled = (GVF_Scaled)GreyBit_Malloc(decoder->gbMem, sizeof(GVF_ScaledRec));
+	if (!scaled)
+		return 0;
+	scaled->outline = GreyBitType_Outline_Clone(decoder->gbLibrary, outline);
+	if (!scaled->outline)
+	{
+		GreyBit_Free(decoder->gbMem, scaled);
+		return 0;
+	}
+	nIndex = GVF_SCALE_INDEX(nCode, nSize);
+	scaled->nCode = nCode;
+	scaled->nSize = nSize;
+	scaled->nBytes = nBytes;
+	scaled->bbox = decoder->gbBBox;
+	scaled->pNext = decoder->gbScaleHash[nIndex];
+	decoder->gbScaleHash[nIndex] = scaled;
+	scaled->pNewer = 0;
+	scaled->pOlder = decoder->gbScaleNewest;
+	if (decoder->gbScaleNewest)
+		decoder->gbScaleNewest->pNewer = scaled;
+	else
+		decoder->gbScaleOldest = scaled;
+	decoder->gbScaleNewest = scaled;
+	decoder->nScaleBytes += nBytes;
+	return scaled->outline;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Decoder_ClearCache
@@ -107,6 +340,7 @@ void		GreyVectorFile_Decoder_ClearCache(GVF_Decoder decoder)
 {
 	int i;
 
+	GreyVectorFile_Decoder_TrimScaled(decoder, 0);
 	if (decoder->gbOutline)
 		GreyBitType_Outline_Done(decoder->gbLibrary, decoder->gbOutline);
 	if (decoder->pBuff)
@@ -117,6 +351,13 @@ void		GreyVectorFile_Decoder_ClearCache(GVF_Decoder decoder)
 		GreyBit_Free(decoder->gbMem, decoder->gbHoriOffTable);
 	if (decoder->gbOffsetTable)
 		GreyBit_Free(decoder->gbMem, decoder->gbOffsetTable);
+#ifdef ENABLE_LAZYTABLE
+	for (i = 0; i < UNICODE_SECTION_NUM; ++i)
+	{
+		if (decoder->gbSectionTable[i].gbOffset)
+			GreyBit_Free(decoder->gbMem, decoder->gbSectionTable[i].gbOffset);
+	}
+#endif //ENABLE_LAZYTABLE
 	if (decoder->gpGreyBits)
 	{
 		for (i = 0; i < decoder->nCacheItem; ++i)
@@ -151,9 +392,20 @@ GB_INT32	GreyVectorFile_Decoder_InfoInit(GVF_Decoder decoder,
 	decoder->gbOutline = GreyBitType_Outline_New(decoder->gbLibrary,
 											nMaxContours,
 											nMaxPoints);
-	decoder->nBuffSize = GreyVector_Outline_GetSizeEx((GB_BYTE)nMaxContours,
-												(GB_BYTE)nMaxPoints)
-											  + sizeof(GVF_OutlineRec);
+	if (GVF_IS_DELTA(decoder))
+	{
+		decoder->nBuffSize = GVF_DELTA_MAXSIZE(nMaxContours, nMaxPoints);
+		if (decoder->nBuffSize > 0xFFFF)
+			decoder->nBuffSize = 0xFFFF;
+		decoder->nBuffSize += sizeof(GVF_OutlineRec);
+	}
+	else
+		decoder->nBuffSize = GreyVector_Outline_GetSizeEx(
+											(GB_BYTE)nMaxContours,
+											(GB_BYTE)nMaxPoints)
+										  + sizeof(GVF_OutlineRec);
+	if (decoder->gbInfoHeaderEx.gbiFlags & GVF_FLAG_BBOX)
+		decoder->nBuffSize += GVF_BBOX_MAXSIZE;
 	decoder->pBuff = (GB_BYTE *)GreyBit_Malloc(decoder->gbMem,
 											   decoder->nBuffSize);
 	return GB_SUCCESS;
@@ -171,6 +423,8 @@ GB_INT32	GreyVectorFile_Decoder_InfoInit(GVF_Decoder decoder,
 
 GB_INT32	GreyVectorFile_Decoder_ReadHeader(GVF_Decoder decoder)
 {
+	GB_UINT32	nExSize;
+
 	GreyBit_Stream_Seek(decoder->gbStream, 0);
 	if (GreyBit_Stream_Read(decoder->gbStream,
 							(GB_BYTE*)&decoder->gbFileHeader,
@@ -179,6 +433,17 @@ GB_INT32	GreyVectorFile_Decoder_ReadHeader(GVF_Decoder decoder)
 		return GB_FAILED;
 	GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE*)&decoder->gbInfoHeader,
 						sizeof(GREYVECTORINFOHEADER));
+	GB_MEMSET(&decoder->gbInfoHeaderEx, 0, sizeof(GREYVECTORINFOHEADEREX));
+	if (decoder->gbInfoHeader.gbiSize > sizeof(GREYVECTORINFOHEADER))
+	{
+		nExSize = decoder->gbInfoHeader.gbiSize-sizeof(GREYVECTORINFOHEADER);
+		if (nExSize > sizeof(GREYVECTORINFOHEADEREX))
+			nExSize = sizeof(GREYVECTORINFOHEADEREX);
+		GreyBit_Stream_Read(decoder->gbStream,
+							(GB_BYTE*)&decoder->gbInfoHeaderEx, nExSize);
+		decoder->gbOffDataBits = sizeof(GREYVECTORFILEHEADER)
+							   + decoder->gbInfoHeader.gbiSize;
+	}
 	decoder->nItemCount = decoder->gbInfoHeader.gbiCount;
 	GreyVectorFile_Decoder_InfoInit(decoder, decoder->gbInfoHeader.gbiWidth,
 									decoder->gbInfoHeader.gbiHeight,
@@ -201,15 +466,18 @@ GB_INT32	GreyVectorFile_Decoder_ReadHeader(GVF_Decoder decoder)
 GB_UINT32	GreyVectorFile_Decoder_GetDataOffset(GVF_Decoder decoder,
 												 GB_UINT32 nCode)
 {
-	GB_UINT32	nOffset;
-	GB_UINT16	nMinCode;
-	GB_UINT16	SectionIndex;
-	GB_INT32	UniIndex;
+	GB_UINT32		nOffset;
+	GB_UINT16		nMinCode;
+	GB_UINT16		SectionIndex;
+	GB_INT32		UniIndex;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
-	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
 	if (UniIndex >= UNICODE_SECTION_NUM)
 		return 0;
+	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
 	if (!SectionIndex)
 		return 0;
 	SectionIndex--;
@@ -218,6 +486,14 @@ GB_UINT32	GreyVectorFile_Decoder_GetDataOffset(GVF_Decoder decoder,
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
 		return decoder->gbOffsetTable[nCode - nMinCode + SectionIndex];
 	}
+#ifdef ENABLE_LAZYTABLE
+	else if ((section = GreyVectorFile_Decoder_LoadSection(decoder, UniIndex))
+			 != 0)
+	{
+		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+		return section->gbOffset[nCode - nMinCode];
+	}
+#endif //ENABLE_LAZYTABLE
 	else
 	{
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
@@ -243,15 +519,24 @@ GB_UINT32	GreyVectorFile_Decoder_GetDataOffset(GVF_Decoder decoder,
 
 GB_INT32	GreyVectorFile_Decoder_Init(GVF_Decoder decoder)
 {
+#ifndef ENABLE_LAZYTABLE
 	int nDataSize;
 	int nDataSizea;
 	int nDataSizeb;
+#endif //ENABLE_LAZYTABLE
 	int nRet;
 
+	decoder->gbWidthTable = 0;
+	decoder->gbHoriOffTable = 0;
+	decoder->gbOffsetTable = 0;
+#ifdef ENABLE_LAZYTABLE
+	GB_MEMSET(decoder->gbSectionTable, 0, sizeof(decoder->gbSectionTable));
+#endif //ENABLE_LAZYTABLE
 	GreyBit_Stream_Seek(decoder->gbStream, 0);
 	nRet = GreyVectorFile_Decoder_ReadHeader(decoder);
 	if (nRet < 0)
 		return nRet;
+#ifndef ENABLE_LAZYTABLE
 	nDataSize = decoder->gbInfoHeader.gbiHoriOffTabOff
 			  - decoder->gbInfoHeader.gbiWidthTabOff;
 	decoder->gbWidthTable =(GB_BYTE*)GreyBit_Malloc(decoder->gbMem,nDataSize);
@@ -266,8 +551,11 @@ GB_INT32	GreyVectorFile_Decoder_Init(GVF_Decoder decoder)
 						decoder->gbInfoHeader.gbiHoriOffTabOff
 					  + decoder->gbOffDataBits);
 	GreyBit_Stream_Read(decoder->gbStream,decoder->gbHoriOffTable,nDataSizea);
-	nDataSizeb = decoder->gbInfoHeader.gbiOffGreyBits
-			   - decoder->gbInfoHeader.gbiOffsetTabOff;
+	if (decoder->gbInfoHeaderEx.gbiFlags & GVF_FLAG_TAIL)
+		nDataSizeb = sizeof(GB_UINT32) * nDataSize;
+	else
+		nDataSizeb = decoder->gbInfoHeader.gbiOffGreyBits
+				   - decoder->gbInfoHeader.gbiOffsetTabOff;
 	decoder->gbOffsetTable = (GB_UINT32 *)GreyBit_Malloc(decoder->gbMem,
 														 nDataSizeb);
 	GreyBit_Stream_Seek(decoder->gbStream,
@@ -275,6 +563,38 @@ GB_INT32	GreyVectorFile_Decoder_Init(GVF_Decoder decoder)
 					  + decoder->gbOffDataBits);
 	GreyBit_Stream_Read(decoder->gbStream,
 						(GB_BYTE*)decoder->gbOffsetTable,nDataSizeb);
+#endif //ENABLE_LAZYTABLE
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_LoadTables
+** Description: Load every table the font will need, so that the tables are
+**              not written any more once contexts read them
+** Input: decoder - decoder
+** Output: Loaded tables
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Decoder_LoadTables(GVF_Decoder decoder)
+{
+#ifdef ENABLE_LAZYTABLE
+	GB_INT32	UniIndex;
+
+	for (UniIndex = 0; UniIndex < UNICODE_SECTION_NUM; ++UniIndex)
+	{
+		if (decoder->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex]
+		 && decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex]
+		 && !GreyVectorFile_Decoder_LoadSection(decoder, UniIndex))
+			return GB_FAILED;
+	}
+#else
+	if (!decoder->gbWidthTable || !decoder->gbHoriOffTable
+	 || !decoder->gbOffsetTable)
+		return GB_FAILED;
+#endif //ENABLE_LAZYTABLE
 	return GB_SUCCESS;
 }
 
@@ -309,12 +629,26 @@ GB_Decoder	GreyVectorFile_Decoder_New(GB_Loader loader, GB_Stream stream)
 		decoder->gbDecoder.getheight = GreyVectorFile_Decoder_GetHeight;
 		decoder->gbDecoder.getadvance = GreyVectorFile_Decoder_GetAdvance;
 		decoder->gbDecoder.decode = GreyVectorFile_Decoder_Decode;
+		decoder->gbDecoder.decodeto = 0;
+		decoder->gbDecoder.decodespans = 0;
+		decoder->gbDecoder.decodepacked = GreyVectorFile_Decoder_DecodePacked;
+		decoder->gbDecoder.decodebatch = GreyVectorFile_Decoder_DecodeBatch;
+		decoder->gbDecoder.preload = GreyVectorFile_Decoder_Preload;
+		decoder->gbDecoder.newcontext = GreyVectorFile_Decoder_NewContext;
 		decoder->gbDecoder.done = GreyVectorFile_Decoder_Done;
+		decoder->gbFont = 0;
+		decoder->bShared = GB_FALSE;
 		decoder->gbLibrary = loader->gbLibrary;
 		decoder->gbMem = loader->gbMem;
 		decoder->gbStream = stream;
 		decoder->nCacheItem = 0;
 		decoder->nItemCount = 0;
+		decoder->gpGreyBits = 0;
+		GB_MEMSET(decoder->gbScaleHash, 0, sizeof(decoder->gbScaleHash));
+		decoder->gbScaleNewest = 0;
+		decoder->gbScaleOldest = 0;
+		decoder->nScaleBudget = 0;
+		decoder->nScaleBytes = 0;
 		decoder->gbOffDataBits = sizeof(GREYVECTORFILEHEADER)
 							   + sizeof(GREYVECTORINFOHEADER);
 		GreyVectorFile_Decoder_Init(decoder);
@@ -337,21 +671,42 @@ GB_Decoder	GreyVectorFile_Decoder_New(GB_Loader loader, GB_Stream stream)
 GB_INT32	GreyVectorFile_Decoder_SetParam(GB_Decoder decoder,GB_Param nParam,
 											GB_UINT32 dwParam)
 {
-	GVF_Decoder	me = (GVF_Decoder)decoder;
+	GB_INT32	nRet;
+	GVF_Decoder	me = GVF_FONT((GVF_Decoder)decoder);
 
+	if (nParam == GB_PARAM_SCALECACHE)
+	{
+		me = (GVF_Decoder)decoder;
+		me->nScaleBudget = (GB_INT32)dwParam;
+		GreyVectorFile_Decoder_TrimScaled(me, me->nScaleBudget);
+		return GB_SUCCESS;
+	}
+	nRet = GB_SUCCESS;
+	GreyBit_Stream_Lock(me->gbStream);
 	if (dwParam)
 	{
 		if (nParam == GB_PARAM_CACHEITEM)
 		{
 			if (me->gpGreyBits)
-				return GB_FAILED;
-			me->nCacheItem = dwParam;
-			me->gpGreyBits = (GB_Outline*)GreyBit_Malloc(me->gbMem,
-														 4 * me->nCacheItem);
-			me->nGreyBitsCount = 0;
+			{
+				nRet = GB_FAILED;
+			}
+			else
+			{
+				me->nCacheItem = dwParam;
+				me->gpGreyBits = (GB_Outline*)GreyBit_Malloc(me->gbMem,
+									sizeof(GB_Outline) * me->nCacheItem);
+				if (me->gpGreyBits)
+					GB_MEMSET(me->gpGreyBits, 0,
+							  sizeof(GB_Outline) * me->nCacheItem);
+				else
+					nRet = GB_FAILED;
+				me->nGreyBitsCount = 0;
+			}
 		}
 	}
-	return GB_SUCCESS;
+	GreyBit_Stream_Unlock(me->gbStream);
+	return nRet;
 }
 
 /*
@@ -402,16 +757,19 @@ GB_INT32	GreyVectorFile_Decoder_GetHeight(GB_Decoder decoder)
 GB_INT32	GreyVectorFile_Decoder_GetWidth(GB_Decoder decoder,
 											GB_UINT32 nCode, GB_INT16 nSize)
 {
-	GB_BYTE		nWidth;
-	GB_UINT16	nMinCode;
-	GB_INT32	UniIndex;
-	GB_INT32	WidthIdx;
-	GVF_Decoder	me = (GVF_Decoder)decoder;
+	GB_BYTE			nWidth;
+	GB_UINT16		nMinCode;
+	GB_INT32		UniIndex;
+	GB_INT32		WidthIdx;
+	GVF_Decoder		me = (GVF_Decoder)decoder;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
-	WidthIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (UniIndex >= UNICODE_SECTION_NUM)
 		return 0;
+	WidthIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (!WidthIdx)
 		return 0;
 	WidthIdx--;
@@ -420,6 +778,13 @@ GB_INT32	GreyVectorFile_Decoder_GetWidth(GB_Decoder decoder,
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
 		nWidth = me->gbWidthTable[nCode - nMinCode + WidthIdx];
 	}
+#ifdef ENABLE_LAZYTABLE
+	else if ((section = GreyVectorFile_Decoder_LoadSection(me, UniIndex)) != 0)
+	{
+		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+		nWidth = section->gbWidth[nCode - nMinCode];
+	}
+#endif //ENABLE_LAZYTABLE
 	else
 	{
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
@@ -447,17 +812,20 @@ GB_INT16	GreyVectorFile_Decoder_GetHoriOff(GB_Decoder decoder,
 											  GB_UINT32 nCode,
 											  GB_INT16 nSize)
 {
-	GB_INT8		nHoriOff;
-	GB_UINT16	nMinCode;
-	GB_INT32	UniIndex;
-	GB_INT32	HoriOffIdx;
-	GVF_Decoder	me;
+	GB_INT8			nHoriOff;
+	GB_UINT16		nMinCode;
+	GB_INT32		UniIndex;
+	GB_INT32		HoriOffIdx;
+	GVF_Decoder		me;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
 
 	me = (GVF_Decoder)decoder;
 	UniIndex = UnicodeSection_GetIndex((GB_UINT16)nCode);
-	HoriOffIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (UniIndex >= UNICODE_SECTION_NUM)
 		return 0;
+	HoriOffIdx = me->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
 	if (!HoriOffIdx)
 		return 0;
 	HoriOffIdx--;
@@ -466,6 +834,13 @@ GB_INT16	GreyVectorFile_Decoder_GetHoriOff(GB_Decoder decoder,
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
 		nHoriOff = me->gbHoriOffTable[nCode - nMinCode + HoriOffIdx];
 	}
+#ifdef ENABLE_LAZYTABLE
+	else if ((section = GreyVectorFile_Decoder_LoadSection(me, UniIndex)) != 0)
+	{
+		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
+		nHoriOff = section->gbHoriOff[nCode - nMinCode];
+	}
+#endif //ENABLE_LAZYTABLE
 	else
 	{
 		UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, 0);
@@ -504,10 +879,288 @@ GB_INT16	GreyVectorFile_Decoder_GetAdvance(GB_Decoder decoder,
 		return nAdvance;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_GetEntry
+** Description: Get table entries of a code whose section is already known
+** Input: decoder - decoder
+**        UniIndex - unicode section index
+**        nMinCode - first code of the section
+**        nCode - code
+** Output: pnWidth - width at font height
+**         pnHoriOff - horioff at font height
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Decoder_GetEntry(GVF_Decoder decoder,
+											GB_INT32 UniIndex,
+											GB_UINT16 nMinCode,
+											GB_UINT32 nCode,
+											GB_BYTE* pnWidth,
+											GB_INT8* pnHoriOff)
+{
+	GB_INT32		WidthIdx;
+	GB_INT32		SectionIndex;
+#ifdef ENABLE_LAZYTABLE
+	SECTIONTABLE*	section;
+#endif //ENABLE_LAZYTABLE
+
+	WidthIdx = decoder->gbInfoHeader.gbiWidthSection.gbSectionOff[UniIndex];
+	SectionIndex=decoder->gbInfoHeader.gbiIndexSection.gbSectionOff[UniIndex];
+	if (!WidthIdx || !SectionIndex)
+		return GB_FAILED;
+	if (decoder->gbWidthTable && decoder->gbHoriOffTable)
+	{
+		*pnWidth = decoder->gbWidthTable[nCode - nMinCode + WidthIdx - 1];
+		*pnHoriOff = decoder->gbHoriOffTable[nCode - nMinCode + WidthIdx - 1];
+		return GB_SUCCESS;
+	}
+#ifdef ENABLE_LAZYTABLE
+	section = GreyVectorFile_Decoder_LoadSection(decoder, UniIndex);
+	if (section)
+	{
+		*pnWidth = section->gbWidth[nCode - nMinCode];
+		*pnHoriOff = section->gbHoriOff[nCode - nMinCode];
+		return GB_SUCCESS;
+	}
+#endif //ENABLE_LAZYTABLE
+	*pnWidth = (GB_BYTE)GreyVectorFile_Decoder_GetWidth((GB_Decoder)decoder,
+						nCode, decoder->gbInfoHeader.gbiHeight);
+	*pnHoriOff = (GB_INT8)GreyVectorFile_Decoder_GetHoriOff(
+						(GB_Decoder)decoder, nCode,
+						decoder->gbInfoHeader.gbiHeight);
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_ReadRaw
+** Description: Read a record from the stream into the read buffer. The seek
+**              is skipped when the stream already stands at the record.
+** Input: decoder - decoder
+**        Offset - data offset, not in RAM
+**        pnStreamPos - data offset the stream stands at (RAM_MASK if not
+**                      known), moved past the record that was read
+** Output: Record in the read buffer, after a GVF_OutlineRec
+** Return value: record size/-1 if unreadable
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Decoder_ReadRaw(GVF_Decoder decoder,
+										   GB_UINT32 Offset,
+										   GB_UINT32* pnStreamPos)
+{
+	GB_UINT16	Lenght;
+
+	if (Offset != *pnStreamPos)
+		GreyBit_Stream_Seek(decoder->gbStream,
+							decoder->gbInfoHeader.gbiOffGreyBits
+						  + decoder->gbOffDataBits + Offset);
+	GreyBit_Stream_Read(decoder->gbStream, (GB_BYTE*)&Lenght, sizeof(Lenght));
+	if (Lenght > decoder->nBuffSize - sizeof(GVF_OutlineRec))
+	{
+		*pnStreamPos = RAM_MASK;
+		return -1;
+	}
+	GreyBit_Stream_Read(decoder->gbStream,
+						decoder->pBuff + sizeof(GVF_OutlineRec), Lenght);
+	*pnStreamPos = Offset + sizeof(Lenght) + Lenght;
+	return Lenght;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_UnpackBBox
+** Description: Read the box ahead of the record in the read buffer. The
+**              glyph behind it is moved down onto the GVF_OutlineRec, so
+**              the outline header stays aligned whatever the box size.
+** Input: decoder - decoder
+**        nLength - record size
+** Output: Box in decoder->gbBBox, glyph data after a GVF_OutlineRec
+** Return value: glyph data size/-1 if the record is damaged
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Decoder_UnpackBBox(GVF_Decoder decoder,
+											  GB_INT32 nLength)
+{
+	GB_INT32	nBoxSize;
+	GB_INT32	i;
+	GB_BYTE*	pRecord;
+
+	pRecord = decoder->pBuff + sizeof(GVF_OutlineRec);
+	nBoxSize = GreyVector_Outline_UnpackBBox(&decoder->gbBBox, pRecord,
+											 nLength);
+	if (!nBoxSize)
+		return -1;
+	nLength -= nBoxSize;
+	for (i = 0; i < nLength; ++i)
+		pRecord[i] = pRecord[i + nBoxSize];
+	return nLength;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_Unpack
+** Description: Expand the record in the read buffer into the outline of
+**              the decoder. The box comes from the record when the font
+**              stores boxes, else from the points.
+** Input: decoder - decoder
+**        nLength - record size
+** Output: Expanded outline, its box in decoder->gbBBox
+** Return value: outline at font height/0 if the record is damaged
+** ---------------------------------------------------------------------------
+*/
+
+GB_Outline	GreyVectorFile_Decoder_Unpack(GVF_Decoder decoder,
+										  GB_INT32 nLength)
+{
+	GB_BOOL		bBBox;
+	GB_Outline	outline;
+
+	bBBox = (GB_BOOL)((decoder->gbInfoHeaderEx.gbiFlags & GVF_FLAG_BBOX) != 0);
+	if (bBBox)
+	{
+		nLength = GreyVectorFile_Decoder_UnpackBBox(decoder, nLength);
+		if (nLength < 0)
+			return 0;
+	}
+	if (GVF_IS_DELTA(decoder))
+		outline = GreyBitType_Outline_UpdateByDelta(decoder->gbOutline,
+							decoder->pBuff + sizeof(GVF_OutlineRec),
+							nLength,
+							decoder->gbInfoHeader.gbiMaxContours,
+							decoder->gbInfoHeader.gbiMaxPoints,
+							decoder->gbInfoHeaderEx.gbiFlags);
+	else
+		outline = GreyBitType_Outline_UpdateByGVF(decoder->gbOutline,
+							GreyVector_Outline_FromData(decoder->pBuff));
+	if (outline && !bBBox)
+		GreyBitType_Outline_GetBBox(outline, &decoder->gbBBox);
+	return outline;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_SetInk
+** Description: Set the ink box of decoded data from decoder->gbBBox, scaled
+**              to nSize the way the outline points are
+** Input: decoder - decoder
+**        pData - data buffer
+**        nSize - character size
+** Output: Ink columns and rows of pData
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyVectorFile_Decoder_SetInk(GVF_Decoder decoder, GB_Data pData,
+										  GB_INT16 nSize)
+{
+	GB_INT32	nScale;
+	GB_INT32	nLeft;
+	GB_INT32	nTop;
+
+	if (decoder->gbInfoHeader.gbiHeight <= 0)
+	{
+		pData->inkleft = 0;
+		pData->inkwidth = pData->width;
+		pData->inktop = 0;
+		pData->inkheight = nSize;
+		return;
+	}
+	nScale = ((GB_INT32)nSize << 16) / decoder->gbInfoHeader.gbiHeight;
+	nLeft = GB_MULFIX(decoder->gbBBox.xMin, nScale) >> 6;
+	nTop = GB_MULFIX(decoder->gbBBox.yMin, nScale) >> 6;
+	pData->inkleft = (GB_INT16)nLeft;
+	pData->inkwidth = (GB_INT16)(((GB_MULFIX(decoder->gbBBox.xMax, nScale)
+								 + 63) >> 6) - nLeft);
+	pData->inktop = (GB_INT16)nTop;
+	pData->inkheight = (GB_INT16)(((GB_MULFIX(decoder->gbBBox.yMax, nScale)
+								  + 63) >> 6) - nTop);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_ReadRecord
+** Description: Get the outline of a character from cache or stream. The
+**              seek is skipped when the stream already stands at the record.
+**              The cache is the one of the font, the outline the decoder's
+**              own.
+** Input: decoder - decoder
+**        nCode - code
+**        Offset - data offset
+**        pnStreamPos - data offset the stream stands at (RAM_MASK if not
+**                      known), moved past the record that was read
+** Output: Box of the outline in decoder->gbBBox
+** Return value: outline at font height/0 if unreadable
+** ---------------------------------------------------------------------------
+*/
+
+GB_Outline	GreyVectorFile_Decoder_ReadRecord(GVF_Decoder decoder,
+											  GB_UINT32 nCode,
+											  GB_UINT32 Offset,
+											  GB_UINT32* pnStreamPos)
+{
+	GB_INT32	nLength;
+	GB_Outline	outline;
+	GVF_Decoder	font = GVF_FONT(decoder);
+
+	if (IS_INRAM(Offset))
+	{
+		outline = font->gpGreyBits[GET_INDEX(Offset)];
+		if (outline)
+			GreyBitType_Outline_GetBBox(outline, &decoder->gbBBox);
+		return outline;
+	}
+	nLength = GreyVectorFile_Decoder_ReadRaw(decoder, Offset, pnStreamPos);
+	if (nLength < 0)
+		return 0;
+	outline = GreyVectorFile_Decoder_Unpack(decoder, nLength);
+	if (!outline)
+		return 0;
+	GreyVectorFile_Decoder_CaheItem(font, nCode, outline);
+	return outline;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_ReadData
+** Description: Read a record under the stream lock. The offset is looked
+**              up under the lock too, since another thread may cache the
+**              character meanwhile, and a shared font always seeks as
+**              another thread may have moved the stream.
+** Input: decoder - decoder
+**        nCode - code
+**        pnStreamPos - data offset the stream stands at (RAM_MASK if not
+**                      known), moved past the record that was read
+** Output: none
+** Return value: outline at font height/0 if unreadable
+** ---------------------------------------------------------------------------
+*/
+
+GB_Outline	GreyVectorFile_Decoder_ReadData(GVF_Decoder decoder,
+											GB_UINT32 nCode,
+											GB_UINT32* pnStreamPos)
+{
+	GB_Outline	outline;
+
+	GreyBit_Stream_Lock(decoder->gbStream);
+	if (GVF_FONT(decoder)->bShared)
+		*pnStreamPos = RAM_MASK;
+	outline = GreyVectorFile_Decoder_ReadRecord(decoder, nCode,
+						GreyVectorFile_Decoder_GetDataOffset(decoder, nCode),
+						pnStreamPos);
+	GreyBit_Stream_Unlock(decoder->gbStream);
+	return outline;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Decoder_Decode
-** Description: Decode a character
+** Description: Decode a character. With GB_PARAM_SCALECACHE set the outline
+**              comes from the scaled outline cache when it holds nCode at
+**              nSize, and stays valid until the next decode either way.
 ** Input: decoder - decoder
 **		  nCode - unicode code
 **	      pData - data buffer
@@ -520,48 +1173,371 @@ GB_INT16	GreyVectorFile_Decoder_GetAdvance(GB_Decoder decoder,
 GB_INT32	GreyVectorFile_Decoder_Decode(GB_Decoder decoder, GB_UINT32 nCode,
 										  GB_Data pData, GB_INT16 nSize)
 {
-	GB_UINT16	Lenght; 
 	GB_INT32	nWidth;
 	GB_INT32	nHoriOff;
 	GB_Outline	outline; 
-	GB_UINT32	Offset;
+	GB_UINT32	nStreamPos;
 	GVF_Decoder	me = (GVF_Decoder)decoder;
 
-	Offset = GreyVectorFile_Decoder_GetDataOffset(me, nCode);
 	nWidth = GreyVectorFile_Decoder_GetWidth(decoder, nCode, nSize);
 	nHoriOff = GreyVectorFile_Decoder_GetHoriOff(decoder, nCode, nSize);
 	if (!nWidth)
 		return GB_FAILED;
-	if (!IS_INRAM(Offset))
-	{
-		GreyBit_Stream_Seek(me->gbStream, me->gbInfoHeader.gbiOffGreyBits
-						  + me->gbOffDataBits + Offset);
-		GreyBit_Stream_Read(me->gbStream, (GB_BYTE*)&Lenght, sizeof(Lenght));
-		GreyBit_Stream_Read(me->gbStream, me->pBuff + sizeof(GVF_OutlineRec),
-							Lenght);
-		outline = GreyBitType_Outline_UpdateByGVF(me->gbOutline,
-							GreyVector_Outline_FromData(me->pBuff));
-		GreyVectorFile_Decoder_CaheItem(me, nCode, outline);
-	}
-	else
+	outline = 0;
+	if (me->nScaleBudget)
+		outline = GreyVectorFile_Decoder_FindScaled(me, nCode, nSize);
+	if (!outline)
 	{
-		GET_INDEX(Offset);
-		outline = me->gpGreyBits[Offset];
+		nStreamPos = RAM_MASK;
+		outline = GreyVectorFile_Decoder_ReadData(me, nCode, &nStreamPos);
+		if (!outline)
+			return GB_FAILED;
+		GreyBitType_Outline_Transform(me->gbOutline, outline, nSize,
+									  me->gbInfoHeader.gbiHeight);
+		outline = 0;
+		if (me->nScaleBudget)
+			outline = GreyVectorFile_Decoder_CacheScaled(me, nCode, nSize,
+														 me->gbOutline);
+		if (!outline)
+			outline = me->gbOutline;
 	}
-	if (!outline)
-		return GB_FAILED;
-	GreyBitType_Outline_Transform(me->gbOutline, outline, nSize,
-								  me->gbInfoHeader.gbiHeight);
 	if (pData)
 	{
 		pData->format = GB_FORMAT_OUTLINE;
-		pData->data = me->gbOutline;
+		pData->data = outline;
 		pData->width = (GB_INT16)nWidth;
 		pData->horioff = (GB_INT16)nHoriOff;
+		GreyVectorFile_Decoder_SetInk(me, pData, nSize);
 	}
 	return GB_SUCCESS;
 }
 
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_DecodePacked
+** Description: Decode a character as its packed record, to be scaled while
+**              it is rendered; nothing is expanded or transformed here.
+**              Characters the caches hold, or that the outline cache still
+**              has room for, and fonts of delta coded records, are decoded
+**              as outlines instead. The packed outline stays valid until
+**              the next decode.
+** Input: decoder - decoder
+**		  nCode - unicode code
+**	      pData - data buffer
+**		  nSize - character size
+** Output: Decoded character, GB_FORMAT_PACKED or GB_FORMAT_OUTLINE
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Decoder_DecodePacked(GB_Decoder decoder,
+												GB_UINT32 nCode,
+												GB_Data pData,
+												GB_INT16 nSize)
+{
+	GB_INT32	nWidth;
+	GB_INT32	nHoriOff;
+	GB_UINT32	Offset;
+	GB_UINT32	nStreamPos;
+	GB_INT32	nLength;
+	GB_BOOL		bBBox;
+	GB_BOOL		bOutline;
+	GVF_Outline	packed;
+	GVF_Decoder	me = (GVF_Decoder)decoder;
+	GVF_Decoder	font = GVF_FONT(me);
+
+	if (!pData || me->nScaleBudget || GVF_IS_DELTA(me))
+		return GreyVectorFile_Decoder_Decode(decoder, nCode, pData, nSize);
+	nWidth = GreyVectorFile_Decoder_GetWidth(decoder, nCode, nSize);
+	nHoriOff = GreyVectorFile_Decoder_GetHoriOff(decoder, nCode, nSize);
+	if (!nWidth || me->gbInfoHeader.gbiHeight <= 0)
+		return GB_FAILED;
+	GreyBit_Stream_Lock(me->gbStream);
+	Offset = GreyVectorFile_Decoder_GetDataOffset(me, nCode);
+	bOutline = (GB_BOOL)(IS_INRAM(Offset)
+						 || font->nGreyBitsCount < font->nCacheItem);
+	nLength = -1;
+	if (!bOutline)
+	{
+		nStreamPos = RAM_MASK;
+		nLength = GreyVectorFile_Decoder_ReadRaw(me, Offset, &nStreamPos);
+	}
+	GreyBit_Stream_Unlock(me->gbStream);
+	if (bOutline)
+		return GreyVectorFile_Decoder_Decode(decoder, nCode, pData, nSize);
+	if (nLength < 0)
+		return GB_FAILED;
+	bBBox = (GB_BOOL)((me->gbInfoHeaderEx.gbiFlags & GVF_FLAG_BBOX) != 0);
+	if (bBBox && GreyVectorFile_Decoder_UnpackBBox(me, nLength) < 0)
+		return GB_FAILED;
+	packed = GreyVector_Outline_FromData(me->pBuff);
+	if (!bBBox)
+		GreyVector_Outline_GetBBox(packed, &me->gbBBox);
+	me->gbPacked.n_contours = packed->n_contours;
+	me->gbPacked.n_points = packed->n_points;
+	me->gbPacked.contours = packed->contours;
+	me->gbPacked.points = (GB_BYTE*)packed->points;
+	me->gbPacked.scale = ((GB_INT32)nSize << 16) / me->gbInfoHeader.gbiHeight;
+	pData->format = GB_FORMAT_PACKED;
+	pData->data = &me->gbPacked;
+	pData->width = (GB_INT16)nWidth;
+	pData->horioff = (GB_INT16)nHoriOff;
+	GreyVectorFile_Decoder_SetInk(me, pData, nSize);
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_DecodeBatch
+** Description: Decode a run of characters into caller outlines. Table
+**              entries are looked up first, reusing the section of the
+**              previous code, then the data is read in one pass so that
+**              glyphs stored back to back need no seek.
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+**	      pData - data array, pData[i].data is a caller GB_Outline whose
+**		          n_contours/n_points on entry are the room available
+**		  nSize - character size
+** Output: Decoded characters, width 0 for characters not decoded
+** Return value: number of characters decoded
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Decoder_DecodeBatch(GB_Decoder decoder,
+											   const GB_UINT32* pCodes,
+											   GB_INT32 nCount, GB_Data pData,
+											   GB_INT16 nSize)
+{
+	GB_BYTE		nWidth;
+	GB_INT8		nHoriOff;
+	GB_UINT16	nMinCode;
+	GB_UINT16	nMaxCode;
+	GB_INT32	UniIndex;
+	GB_INT32	nDecoded;
+	GB_INT32	i;
+	GB_UINT32	nStreamPos;
+	GB_Outline	source;
+	GB_Outline	outline;
+	GVF_Decoder	me = (GVF_Decoder)decoder;
+
+	UniIndex = UNICODE_SECTION_NUM;
+	nMinCode = 0;
+	nMaxCode = 0;
+	for (i = 0; i < nCount; ++i)
+	{
+		pData[i].format = GB_FORMAT_OUTLINE;
+		pData[i].width = 0;
+		pData[i].horioff = 0;
+		pData[i].inktop = 0;
+		pData[i].inkheight = nSize;
+		pData[i].inkleft = 0;
+		pData[i].inkwidth = 0;
+		if (UniIndex >= UNICODE_SECTION_NUM
+		 || pCodes[i] < nMinCode || pCodes[i] > nMaxCode)
+		{
+			UniIndex = UnicodeSection_GetIndex((GB_UINT16)pCodes[i]);
+			if (UniIndex >= UNICODE_SECTION_NUM)
+				continue;
+			UnicodeSection_GetSectionInfo(UniIndex, &nMinCode, &nMaxCode);
+		}
+		if (GreyVectorFile_Decoder_GetEntry(me, UniIndex, nMinCode, pCodes[i],
+											&nWidth, &nHoriOff) != GB_SUCCESS
+		 || !nWidth)
+			continue;
+		pData[i].width = (GB_INT16)(nSize * nWidth
+					   / me->gbInfoHeader.gbiHeight);
+		pData[i].horioff = (GB_INT16)(nSize * nHoriOff
+						 / me->gbInfoHeader.gbiHeight);
+	}
+	nStreamPos = RAM_MASK;
+	nDecoded = 0;
+	for (i = 0; i < nCount; ++i)
+	{
+		outline = (GB_Outline)pData[i].data;
+		if (!pData[i].width || !outline)
+			continue;
+		source = GreyVectorFile_Decoder_ReadData(me, pCodes[i], &nStreamPos);
+		if (!source || source->n_contours > outline->n_contours
+		 || source->n_points > outline->n_points)
+		{
+			pData[i].width = 0;
+			continue;
+		}
+		GreyBitType_Outline_Transform(outline, source, nSize,
+									  me->gbInfoHeader.gbiHeight);
+		GreyVectorFile_Decoder_SetInk(me, &pData[i], nSize);
+		nDecoded++;
+	}
+	return nDecoded;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_Preload
+** Description: Read a set of characters into the cache. Offsets are resolved
+**              and sorted first, so neighbouring glyphs share one read.
+** Input: decoder - decoder
+**		  pCodes - unicode codes
+**		  nCount - code count
+** Output: Cached characters
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Decoder_Preload(GB_Decoder decoder,
+										   const GB_UINT32* pCodes,
+										   GB_INT32 nCount)
+{
+	GB_UINT16		Lenght;
+	GB_INT32		nItem;
+	GB_INT32		nFirst;
+	GB_INT32		nLast;
+	GB_INT32		nRecSize;
+	GB_INT32		nWindow;
+	GB_INT32		nRead;
+	GB_INT32		nPos;
+	GB_INT32		nRet;
+	GB_INT32		i;
+	GB_BYTE*		pWindow;
+	GB_Outline		outline;
+	PRELOADITEM*	pItems;
+	GVF_Decoder		me = (GVF_Decoder)decoder;
+	GVF_Decoder		font = GVF_FONT(me);
+
+	if (!font->gpGreyBits || nCount <= 0)
+		return GB_FAILED;
+	pItems = (PRELOADITEM*)GreyBit_Malloc(me->gbMem,
+										  sizeof(PRELOADITEM) * nCount);
+	if (!pItems)
+		return GB_FAILED;
+	GreyBit_Stream_Lock(me->gbStream);
+	nItem = 0;
+	for (i = 0; i < nCount; ++i)
+	{
+		if (!GreyVectorFile_Decoder_GetWidth(decoder, pCodes[i],
+											 me->gbInfoHeader.gbiHeight))
+			continue;
+		pItems[nItem].nOffset = GreyVectorFile_Decoder_GetDataOffset(me,
+																	 pCodes[i]);
+		if (IS_INRAM(pItems[nItem].nOffset))
+			continue;
+		pItems[nItem++].nCode = pCodes[i];
+	}
+	GreyBit_Preload_Sort(pItems, nItem);
+	nRecSize = me->nBuffSize - sizeof(GVF_OutlineRec) + sizeof(GB_UINT16);
+	nWindow = nRecSize > GB_PRELOAD_WINDOW ? nRecSize : GB_PRELOAD_WINDOW;
+	pWindow = (GB_BYTE *)GreyBit_Malloc(me->gbMem, nWindow);
+	nRet = pWindow ? GB_SUCCESS : GB_FAILED;
+	i = 0;
+	while (nRet == GB_SUCCESS && i < nItem)
+	{
+		nFirst = i;
+		for (nLast = nFirst; nLast + 1 < nItem; ++nLast)
+		{
+			if (pItems[nLast + 1].nOffset - pItems[nFirst].nOffset + nRecSize
+			  > (GB_UINT32)nWindow)
+				break;
+		}
+		GreyBit_Stream_Seek(me->gbStream, me->gbInfoHeader.gbiOffGreyBits
+						  + me->gbOffDataBits + pItems[nFirst].nOffset);
+		nRead = GreyBit_Stream_Read(me->gbStream, pWindow,
+									pItems[nLast].nOffset
+								  - pItems[nFirst].nOffset + nRecSize);
+		for (; i <= nLast; ++i)
+		{
+			if (i > nFirst && pItems[i].nCode == pItems[i - 1].nCode)
+				continue;
+			nPos = pItems[i].nOffset - pItems[nFirst].nOffset;
+			if (nPos + (GB_INT32)sizeof(GB_UINT16) > nRead)
+				continue;
+			GB_MEMCPY(&Lenght, pWindow + nPos, sizeof(GB_UINT16));
+			nPos += sizeof(GB_UINT16);
+			if (nPos + Lenght > nRead
+			 || Lenght > me->nBuffSize - sizeof(GVF_OutlineRec))
+				continue;
+			GB_MEMCPY(me->pBuff + sizeof(GVF_OutlineRec), pWindow + nPos,
+					  Lenght);
+			outline = GreyVectorFile_Decoder_Unpack(me, Lenght);
+			if (!outline)
+				continue;
+			nRet = GreyVectorFile_Decoder_CaheItem(font, pItems[i].nCode,
+												   outline);
+			if (nRet != GB_SUCCESS)
+				break;
+		}
+	}
+	GreyBit_Stream_Unlock(me->gbStream);
+	if (pWindow)
+		GreyBit_Free(me->gbMem, pWindow);
+	GreyBit_Free(me->gbMem, pItems);
+	return nRet;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Decoder_NewContext
+** Description: Make a decode context of a font. All tables are loaded first
+**              and stay as they are; the context shares them and the outline
+**              cache of the font, and has its own outline and read buffer.
+** Input: decoder - decoder
+**        loader - loader of the context
+**        stream - stream of the context, a child of the font stream
+** Output: New decoder context
+** Return value: decoder context/0 if tables could not be loaded
+** ---------------------------------------------------------------------------
+*/
+
+GB_Decoder	GreyVectorFile_Decoder_NewContext(GB_Decoder decoder,
+											  GB_Loader loader,
+											  GB_Stream stream)
+{
+	GB_INT32	nRet;
+	GVF_Decoder	font;
+	GVF_Decoder	me;
+
+	font = GVF_FONT((GVF_Decoder)decoder);
+	if (GreyBit_Stream_Share(font->gbStream) != GB_SUCCESS)
+		return 0;
+	me = (GVF_Decoder)GreyBit_Malloc(loader->gbMem, sizeof(GVF_DecoderRec));
+	if (!me)
+		return 0;
+	GreyBit_Stream_Lock(font->gbStream);
+	nRet = GreyVectorFile_Decoder_LoadTables(font);
+	if (nRet == GB_SUCCESS)
+	{
+		font->bShared = GB_TRUE;
+		GB_MEMCPY(me, font, sizeof(GVF_DecoderRec));
+	}
+	GreyBit_Stream_Unlock(font->gbStream);
+	if (nRet != GB_SUCCESS)
+	{
+		GreyBit_Free(loader->gbMem, me);
+		return 0;
+	}
+	me->gbFont = font;
+	me->gbLibrary = loader->gbLibrary;
+	me->gbMem = loader->gbMem;
+	me->gbStream = stream;
+	me->nCacheItem = 0;
+	me->gpGreyBits = 0;
+	me->nGreyBitsCount = 0;
+	GB_MEMSET(me->gbScaleHash, 0, sizeof(me->gbScaleHash));
+	me->gbScaleNewest = 0;
+	me->gbScaleOldest = 0;
+	me->nScaleBytes = 0;
+	GreyVectorFile_Decoder_InfoInit(me, font->gbInfoHeader.gbiWidth,
+									font->gbInfoHeader.gbiHeight,
+									font->gbInfoHeader.gbiMaxPoints,
+									font->gbInfoHeader.gbiMaxContours);
+	if (!me->gbOutline || !me->pBuff)
+	{
+		GreyVectorFile_Decoder_Done((GB_Decoder)me);
+		return 0;
+	}
+	return (GB_Decoder)me;
+}
+
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Decoder_Done
@@ -576,7 +1552,18 @@ void		GreyVectorFile_Decoder_Done(GB_Decoder decoder)
 {
 	GVF_Decoder	me = (GVF_Decoder)decoder;
 
-	GreyVectorFile_Decoder_ClearCache(me);
+	if (me->gbFont)
+	{
+		GreyVectorFile_Decoder_TrimScaled(me, 0);
+		if (me->gbOutline)
+			GreyBitType_Outline_Done(me->gbLibrary, me->gbOutline);
+		if (me->pBuff)
+			GreyBit_Free(me->gbMem, me->pBuff);
+	}
+	else
+	{
+		GreyVectorFile_Decoder_ClearCache(me);
+	}
 	GreyBit_Free(me->gbMem, decoder);
 }
 
@@ -8,6 +8,13 @@
 ** History:
 ** when			who				what, where, why
 ** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Flatten keeps delta points
+** 10/18/2026	me				Mark tables behind the records
+** 10/18/2026	me				Records stream out as glyphs are encoded
+** 10/18/2026	me				Pre-flattened polyline records
+** 10/18/2026	me				Encode-time outline simplification
+** 10/18/2026	me				Glyph bounding boxes
+** 10/18/2026	me				Delta coded records
 ** 09/16/2023	me				Upgrade
 ** 08/10/2023	me              Init
 ** ===========================================================================
@@ -74,15 +81,14 @@ GB_INT32	GreyVectorFile_Encoder_Init(GVF_Encoder encoder)
 	encoder->gbOffsetTable = (GB_UINT32 *)GreyBit_Malloc(encoder->gbMem,
 														 sizeof(GB_UINT32)
 														*MAX_COUNT);
-	encoder->gpGreyBits = (GB_Outline *)GreyBit_Malloc(encoder->gbMem,
-													   sizeof(GB_Outline)
-													   *MAX_COUNT);
 	encoder->pnGreySize = (GB_UINT16 *)GreyBit_Malloc(encoder->gbMem,
 													  sizeof(GB_UINT16)
 													 *MAX_COUNT);
-	encoder->nCacheItem = MAX_COUNT;
+	encoder->pRecord = (GB_BYTE *)GreyBit_Malloc(encoder->gbMem,
+												 GVF_RECORD_MAXSIZE);
 	GB_MEMSET(encoder->gbWidthTable, 0, MAX_COUNT);
 	GB_MEMSET(encoder->gbHoriOffTable, 0, MAX_COUNT);
+	GB_MEMSET(encoder->pnGreySize, 0, sizeof(GB_UINT16) * MAX_COUNT);
 	return GB_SUCCESS;
 }
 
@@ -102,8 +108,6 @@ GB_INT32	GreyVectorFile_Encoder_Init(GVF_Encoder encoder)
 GB_INT32	GreyVectorFile_Encoder_InfoInit(GVF_Encoder encoder,
 											GB_INT16 nHeight)
 {
-	int i;
-
 	if (encoder->gbInited)
 	{
 		if (encoder->gbInfoHeader.gbiHeight == nHeight)
@@ -111,16 +115,8 @@ GB_INT32	GreyVectorFile_Encoder_InfoInit(GVF_Encoder encoder,
 		GB_MEMSET(encoder->gbWidthTable, 0, MAX_COUNT);
 		GB_MEMSET(encoder->gbHoriOffTable, 0, MAX_COUNT);
 		GB_MEMSET(encoder->gbOffsetTable, 0, sizeof(GB_UINT32) * MAX_COUNT);
-		for (i = 0; i < encoder->nCacheItem; ++i)
-		{
-			if (encoder->gpGreyBits[i])
-			{
-				GreyBitType_Outline_Done(encoder->gbLibrary,
-										 encoder->gpGreyBits[i]);
-				encoder->gpGreyBits[i] = 0;
-				encoder->pnGreySize[i] = 0;
-			}
-		}
+		GB_MEMSET(encoder->pnGreySize, 0, sizeof(GB_UINT16) * MAX_COUNT);
+		encoder->nGreyBitSize = 0;
 	}
 	encoder->gbInited = 1;
 	encoder->gbInfoHeader.gbiHeight = nHeight;
@@ -139,8 +135,6 @@ GB_INT32	GreyVectorFile_Encoder_InfoInit(GVF_Encoder encoder,
 
 void		GreyVectorFile_Encoder_ClearCache(GVF_Encoder encoder)
 {
-	int i;
-
 	if (encoder->gbWidthTable)
 		GreyBit_Free(encoder->gbMem, encoder->gbWidthTable);
 	if (encoder->gbHoriOffTable)
@@ -149,21 +143,102 @@ void		GreyVectorFile_Encoder_ClearCache(GVF_Encoder encoder)
 		GreyBit_Free(encoder->gbMem, encoder->gbOffsetTable);
 	if (encoder->pnGreySize)
 		GreyBit_Free(encoder->gbMem, encoder->pnGreySize);
-	if (encoder->gpGreyBits)
+	if (encoder->pRecord)
+		GreyBit_Free(encoder->gbMem, encoder->pRecord);
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Encoder_InfoEx
+** Description: Set the header flags and the header size, which fixes where
+**              the records start
+** Input: encoder - encoder
+** Output: Initialised header
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+void		GreyVectorFile_Encoder_InfoEx(GVF_Encoder encoder)
+{
+	encoder->gbInfoHeaderEx.gbiFlags = GVF_FLAG_TAIL;
+	if (encoder->bDelta)
+		encoder->gbInfoHeaderEx.gbiFlags |= GVF_FLAG_DELTA;
+	if (encoder->bBBox)
+		encoder->gbInfoHeaderEx.gbiFlags |= GVF_FLAG_BBOX;
+	if (encoder->nFlatten)
+		encoder->gbInfoHeaderEx.gbiFlags |= GVF_FLAG_FLAT;
+	encoder->gbInfoHeader.gbiSize = sizeof(GREYVECTORINFOHEADER);
+	if (encoder->gbInfoHeaderEx.gbiFlags)
+		encoder->gbInfoHeader.gbiSize += sizeof(GREYVECTORINFOHEADEREX);
+	encoder->gbOffDataBits = sizeof(GREYVECTORFILEHEADER)
+						   + encoder->gbInfoHeader.gbiSize;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: GreyVectorFile_Encoder_WriteRecord
+** Description: Pack a glyph into the record buffer and write it to the
+**              stream behind the records so far, keeping only its offset
+**              and size
+** Input: encoder - encoder
+**        nCode - unicode code
+**        outline - outline at font height
+** Output: Written record
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+GB_INT32	GreyVectorFile_Encoder_WriteRecord(GVF_Encoder encoder,
+											   GB_UINT32 nCode,
+											   GB_Outline outline)
+{
+	GB_INT32	nPos;
+	GB_INT32	nRecSize;
+	GB_UINT16	nLength;
+	GB_BYTE*	pRecord;
+
+	pRecord = encoder->pRecord;
+	if (!pRecord)
+		return GB_FAILED;
+	if (!encoder->bDelta && (outline->n_points > 255
+						  || outline->n_contours > 255))
+		return GB_FAILED;
+	GreyVectorFile_Encoder_InfoEx(encoder);
+	nPos = sizeof(GB_UINT16);
+	if (encoder->bBBox)
+		nPos += GreyVector_Outline_PackBBox(outline, pRecord + nPos);
+	if (encoder->bDelta)
 	{
-		for (i = 0; i < encoder->nCacheItem; ++i)
-		{
-			if (encoder->gpGreyBits[i])
-				GreyBit_Free(encoder->gbMem, encoder->gpGreyBits[i]);
-		}
-		GreyBit_Free(encoder->gbMem, encoder->gpGreyBits);
+		if (nPos + GreyVector_Outline_PackDelta(outline, 0,
+									encoder->gbInfoHeaderEx.gbiFlags)
+		  > GVF_RECORD_MAXSIZE)
+			return GB_FAILED;
+		nPos += GreyVector_Outline_PackDelta(outline, pRecord + nPos,
+									encoder->gbInfoHeaderEx.gbiFlags);
 	}
+	else
+		nPos += GreyVector_Outline_PackGB(outline, pRecord + nPos);
+	nRecSize = nPos - sizeof(GB_UINT16);
+	nLength = (GB_UINT16)nRecSize;
+	GB_MEMCPY(pRecord, &nLength, sizeof(GB_UINT16));
+	GreyBit_Stream_Seek(encoder->gbStream,
+						encoder->gbOffDataBits + encoder->nGreyBitSize);
+	GreyBit_Stream_Write(encoder->gbStream, pRecord, nPos);
+	encoder->gbOffsetTable[nCode] = encoder->nGreyBitSize;
+	encoder->pnGreySize[nCode] = nLength;
+	encoder->nGreyBitSize += nPos;
+	if (encoder->gbInfoHeader.gbiMaxPoints < outline->n_points)
+		encoder->gbInfoHeader.gbiMaxPoints = outline->n_points;
+	if (encoder->gbInfoHeader.gbiMaxContours < outline->n_contours)
+		encoder->gbInfoHeader.gbiMaxContours = outline->n_contours;
+	return GB_SUCCESS;
 }
 
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Encoder_BuildAll
-** Description: Build everything pre-write
+** Description: Build everything pre-write, the tables are laid out behind
+**              the records written while encoding
 ** Input: encoder - encoder
 ** Output: Initialised header
 ** Return value: success
@@ -172,14 +247,12 @@ void		GreyVectorFile_Encoder_ClearCache(GVF_Encoder encoder)
 
 GB_INT32	GreyVectorFile_Encoder_BuildAll(GVF_Encoder encoder)
 {
-	GB_INT32	nSize;
 	GB_UINT32	nCount;
-	GB_UINT32	nGreyBitSize;
 	GB_UINT32	nOffSetTableSize;
 	GB_UINT32	nHoriOffTableSize;
 	GB_UINT32	nWidthTableSize;
 	GB_UINT16	nCode;
-	GB_UINT16	nCodea;
+	GB_UINT32	nCodea;
 	GB_UINT16	nMinCode;
 	GB_UINT16	nMaxCode;
 	GB_UINT16	nSectionLen;
@@ -188,7 +261,6 @@ GB_INT32	GreyVectorFile_Encoder_BuildAll(GVF_Encoder encoder)
 	nWidthTableSize = 0;
 	nOffSetTableSize = 0;
 	nHoriOffTableSize = 0;
-	nGreyBitSize = 0;
 	nCount = 0;
 	nCodea = 0;
 	for (nSection = 0; nSection < UNICODE_SECTION_NUM; ++nSection)
@@ -212,22 +284,20 @@ GB_INT32	GreyVectorFile_Encoder_BuildAll(GVF_Encoder encoder)
 	}
 	while (nCodea < MAX_COUNT)
 	{
-		nSize = encoder->pnGreySize[nCodea];
-		if (nSize)
-		{
-			encoder->gbOffsetTable[nCodea] = nGreyBitSize;
-			nGreyBitSize += nSize + 2;
+		if (encoder->pnGreySize[nCodea])
 			++nCount;
-		}
 		nCodea++;
 	}
+	/* the records are already in the stream, the tables follow them */
 	encoder->gbInfoHeader.gbiCount = nCount;
-	encoder->gbInfoHeader.gbiOffGreyBits = nOffSetTableSize+nHoriOffTableSize
-									+ nWidthTableSize;
-	encoder->gbInfoHeader.gbiOffsetTabOff = nHoriOffTableSize+nWidthTableSize;
-	encoder->gbInfoHeader.gbiHoriOffTabOff = nWidthTableSize;
-	encoder->gbInfoHeader.gbiWidthTabOff = 0;
-	encoder->gbInfoHeader.gbiSize = sizeof(GREYVECTORINFOHEADER);
+	encoder->gbInfoHeader.gbiOffGreyBits = 0;
+	encoder->gbInfoHeader.gbiWidthTabOff = encoder->nGreyBitSize;
+	encoder->gbInfoHeader.gbiHoriOffTabOff = encoder->nGreyBitSize
+										   + nWidthTableSize;
+	encoder->gbInfoHeader.gbiOffsetTabOff = encoder->nGreyBitSize
+										  + nWidthTableSize
+										  + nHoriOffTableSize;
+	GreyVectorFile_Encoder_InfoEx(encoder);
 	encoder->gbFileHeader.gbfTag[0] = 'g';
 	encoder->gbFileHeader.gbfTag[1] = 'v';
 	encoder->gbFileHeader.gbfTag[2] = 't';
@@ -238,29 +308,24 @@ GB_INT32	GreyVectorFile_Encoder_BuildAll(GVF_Encoder encoder)
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Encoder_WriteAll
-** Description: Flush everything to stream
+** Description: Flush the tables and then the headers to stream
 ** Input: encoder - encoder
 ** Output: Finished product
-** Return value: success
+** Return value: success/fail
 ** ---------------------------------------------------------------------------
 */
 
 GB_INT32	GreyVectorFile_Encoder_WriteAll(GVF_Encoder encoder)
 {
-	GVF_Outline	outline;
 	GB_INT32	nDataSize;
 	GB_BYTE *	pData;
-	GB_INT32	nCode;
 	GB_UINT16	nMinCode;
 	GB_UINT16	nMaxCode;
 	GB_INT32	nSectionLen;
 	GB_INT32	nSection;
 
-	GreyBit_Stream_Seek(encoder->gbStream, 0);
-	GreyBit_Stream_Write(encoder->gbStream, (GB_BYTE*)&encoder->gbFileHeader,
-						 sizeof(GREYVECTORFILEHEADER));
-	GreyBit_Stream_Write(encoder->gbStream, (GB_BYTE*)&encoder->gbInfoHeader,
-						 sizeof(GREYVECTORINFOHEADER));
+	GreyBit_Stream_Seek(encoder->gbStream,
+						encoder->gbOffDataBits + encoder->nGreyBitSize);
 	for (nSection = 0; nSection < UNICODE_SECTION_NUM; ++nSection)
 	{
 		UnicodeSection_GetSectionInfo(nSection, &nMinCode, &nMaxCode);
@@ -268,7 +333,6 @@ GB_INT32	GreyVectorFile_Encoder_WriteAll(GVF_Encoder encoder)
 		if (encoder->gbInfoHeader.gbiWidthSection.gbSectionOff[nSection])
 		{
 			pData = (GB_BYTE *)&encoder->gbWidthTable[nMinCode];
-			nDataSize = (GB_UINT16)nSectionLen;
 			GreyBit_Stream_Write(encoder->gbStream, pData, nSectionLen);
 		}
 	}
@@ -294,19 +358,15 @@ GB_INT32	GreyVectorFile_Encoder_WriteAll(GVF_Encoder encoder)
 			GreyBit_Stream_Write(encoder->gbStream, pData, nDataSize);
 		}
 	}
-	for (nCode = 0; nCode < encoder->nCacheItem; ++nCode)
-	{
-		nDataSize = encoder->pnGreySize[nCode];
-		if (nDataSize)
-		{
-		   outline=(GVF_Outline)GreyVector_Outline_NewByGB(encoder->gbLibrary,
-												  encoder->gpGreyBits[nCode]);
-		   GreyBit_Stream_Write(encoder->gbStream, (GB_BYTE*)&nDataSize, 2);
-		   pData = (GB_CHAR*)GreyVector_Outline_GetData(outline);
-		   GreyBit_Stream_Write(encoder->gbStream, pData, nDataSize);
-		   GreyVector_Outline_Done(encoder->gbLibrary, outline);
-		}
-	}
+	GreyBit_Stream_Seek(encoder->gbStream, 0);
+	GreyBit_Stream_Write(encoder->gbStream, (GB_BYTE*)&encoder->gbFileHeader,
+						 sizeof(GREYVECTORFILEHEADER));
+	GreyBit_Stream_Write(encoder->gbStream, (GB_BYTE*)&encoder->gbInfoHeader,
+						 sizeof(GREYVECTORINFOHEADER));
+	if (encoder->gbInfoHeaderEx.gbiFlags)
+		GreyBit_Stream_Write(encoder->gbStream,
+							 (GB_BYTE*)&encoder->gbInfoHeaderEx,
+							 sizeof(GREYVECTORINFOHEADEREX));
 	return GB_SUCCESS;
 }
 
@@ -336,7 +396,9 @@ GB_INT32	GreyVectorFile_Encoder_GetCount(GB_Encoder encoder)
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Encoder_SetParam
-** Description: Set encoder param
+** Description: Set encoder param. GB_PARAM_FLATTEN turns GB_PARAM_DELTA
+**              on, as whole pixel points would lose the tolerance and the
+**              255 points of a plain record do not hold many flat glyphs.
 ** Input: encoder - encoder
 **        nParam - param type
 **        dwParam - param value
@@ -356,6 +418,28 @@ GB_INT32	GreyVectorFile_Encoder_SetParam(GB_Encoder encoder,
 		if (nParam == GB_PARAM_HEIGHT)
 			me->nHeight = (GB_UINT16)dwParam;
 	}
+	if (nParam == GB_PARAM_DELTA)
+	{
+		if (me->nGreyBitSize || (!dwParam && me->nFlatten))
+			return GB_FAILED;
+		me->bDelta = (GB_BOOL)(dwParam != 0);
+	}
+	if (nParam == GB_PARAM_BBOX)
+	{
+		if (me->nGreyBitSize)
+			return GB_FAILED;
+		me->bBBox = (GB_BOOL)(dwParam != 0);
+	}
+	if (nParam == GB_PARAM_SIMPLIFY)
+		me->nTolerance = (GB_INT32)dwParam;
+	if (nParam == GB_PARAM_FLATTEN)
+	{
+		if (me->nGreyBitSize)
+			return GB_FAILED;
+		me->nFlatten = (GB_INT32)dwParam;
+		if (me->nFlatten)
+			me->bDelta = GB_TRUE;
+	}
 	GreyVectorFile_Encoder_InfoInit(me, me->nHeight);
 	return GB_SUCCESS;
 }
@@ -378,19 +462,22 @@ GB_INT32	GreyVectorFile_Encoder_Delete(GB_Encoder encoder, GB_UINT32 nCode)
 	me->gbOffsetTable[nCode] = 0;
 	me->gbHoriOffTable[nCode] = GB_HORIOFF_DEFAULT;
 	me->gbWidthTable[nCode] = GB_WIDTH_DEFAULT;
-	if (me->gpGreyBits[nCode])
-	{
-		GreyBitType_Outline_Done(me->gbLibrary, me->gpGreyBits[nCode]);
-		me->gpGreyBits[nCode] = 0;
-		me->pnGreySize[nCode] = 0;
-	}
+	me->pnGreySize[nCode] = 0;
 	return GB_SUCCESS;
 }
 
 /*
 ** ---------------------------------------------------------------------------
 ** Function: GreyVectorFile_Encoder_Encode
-** Description: Encode code to new font
+** Description: Encode code to new font. With GB_PARAM_DELTA points are kept
+**              to 1/16 pixel and outlines may have up to 32767 points.
+**              With GB_PARAM_BBOX the record starts with the glyph box.
+**              With GB_PARAM_SIMPLIFY the outline first loses the points
+**              that move it by no more than the tolerance. With
+**              GB_PARAM_FLATTEN its arcs are then cut into lines, kept
+**              as delta points.
+**              The record goes to the stream right away, a glyph encoded
+**              again or removed leaves its old record unused.
 ** Input: encoder - encoder
 **        nCode - unicode code
 **        pData - data buffer
@@ -403,8 +490,10 @@ GB_INT32	GreyVectorFile_Encoder_Encode(GB_Encoder encoder, GB_UINT32 nCode,
 										  GB_Data pData)
 {
 	GB_INT16	nWidth;
+	GB_INT32	nRet;
 	GB_Outline	outline; 
 	GB_Outline	source;
+	GB_Outline	flat;
 	GVF_Encoder	me = (GVF_Encoder)encoder;
 
 	if (!pData || pData->format != GB_FORMAT_OUTLINE)
@@ -413,22 +502,33 @@ GB_INT32	GreyVectorFile_Encoder_Encode(GB_Encoder encoder, GB_UINT32 nCode,
 		return GB_FAILED;
 	nWidth = pData->width;
 	source = (GB_Outline)pData->data;
-	if (source->n_points > 255)
+	if (source->n_points < 0 || source->n_contours < 0)
 		return GB_FAILED;
+	outline = source;
+	if (me->nTolerance)
+	{
+		outline = GreyBitType_Outline_Clone(me->gbLibrary, source);
+		if (!outline)
+			return GB_FAILED;
+		GreyVector_Outline_Simplify(outline, me->nTolerance);
+	}
+	if (me->nFlatten)
+	{
+		flat = GreyVector_Outline_Flatten(me->gbLibrary, outline,
+										  me->nFlatten);
+		if (outline != source)
+			GreyBitType_Outline_Done(me->gbLibrary, outline);
+		outline = flat;
+		if (!outline)
+			return GB_FAILED;
+	}
+	nRet = GreyVectorFile_Encoder_WriteRecord(me, nCode, outline);
+	if (outline != source)
+		GreyBitType_Outline_Done(me->gbLibrary, outline);
+	if (nRet != GB_SUCCESS)
+		return nRet;
 	if (me->gbInfoHeader.gbiWidth < nWidth)
 		me->gbInfoHeader.gbiWidth = nWidth;
-	if (me->gbInfoHeader.gbiMaxPoints < source->n_points)
-		me->gbInfoHeader.gbiMaxPoints = source->n_points;
-	if (me->gbInfoHeader.gbiMaxContours < source->n_contours)
-		me->gbInfoHeader.gbiMaxContours = source->n_contours;
-	outline = GreyBitType_Outline_Clone(me->gbLibrary, source);
-	if (me->gpGreyBits[nCode])
-		GreyBitType_Outline_Done(me->gbLibrary, me->gpGreyBits[nCode]);
-	me->gpGreyBits[nCode] = outline;
-	me->pnGreySize[nCode] = (GB_UINT16)GreyVector_Outline_GetSizeEx(
-							(GB_BYTE)outline->n_contours,
-							(GB_BYTE)outline->n_points);
-	me->gbOffsetTable[nCode] = SET_RAM(nCode);
 	me->gbWidthTable[nCode] = (GB_BYTE)nWidth;
 	me->gbHoriOffTable[nCode] = (GB_INT8)pData->horioff;
 	return GB_SUCCESS;
@@ -491,7 +591,7 @@ GB_Encoder	GreyVectorFile_Encoder_New(GB_Creator creator, GB_Stream stream)
 {
 	GVF_Encoder	codec;
 
-	codec = (GVF_Encoder)GreyBit_Malloc(creator->gbMem, sizeof(GVF_Encoder));
+	codec = (GVF_Encoder)GreyBit_Malloc(creator->gbMem, sizeof(GVF_EncoderRec));
 	if (codec)
 	{
 		codec->gbEncoder.getcount = GreyVectorFile_Encoder_GetCount;
@@ -499,12 +599,13 @@ GB_Encoder	GreyVectorFile_Encoder_New(GB_Creator creator, GB_Stream stream)
 		codec->gbEncoder.remove = GreyVectorFile_Encoder_Delete;
 		codec->gbEncoder.encode = GreyVectorFile_Encoder_Encode;
 		codec->gbEncoder.flush = GreyVectorFile_Encoder_Flush;
+		codec->gbEncoder.bake = 0;
 		codec->gbEncoder.done = GreyVectorFile_Encoder_Done;
 		codec->gbLibrary = creator->gbLibrary;
 		codec->gbMem = creator->gbMem;
 		codec->gbStream = stream;
-		codec->nCacheItem = 0;
 		codec->nItemCount = 0;
+		codec->nGreyBitSize = 0;
 		codec->gbOffDataBits = sizeof(GREYVECTORFILEHEADER)
 						     + sizeof(GREYVECTORINFOHEADER);
 		GreyVectorFile_Encoder_Init(codec);
@@ -0,0 +1,59 @@
+/*
+** ===========================================================================
+** File: GreyBitTest.h
+** Description: GreyBit font library - Fonts, checksums and the memory
+**              count shared by the tests
+** Copyright (c) 2023
+** Portions of this software (C) 2010 The FreeType Project (www.freetype.org).
+** All rights reserved.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Test_MemoryInUse
+** 10/18/2026	me				Init
+** ===========================================================================
+*/
+
+#ifndef GREYBITTEST_H_
+#define GREYBITTEST_H_
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include "../GreyBitType.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define TEST_BASE					0x4E00
+#define TEST_HEIGHT_MAX				64		/* of the bitmap test fonts   */
+#define TEST_VHEIGHT				64		/* of the vector test fonts   */
+#define TEST_POS(v)					((GB_Pos)((v) << 6))	/* pixels to 26.6 */
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+extern int			Test_MakeBitmapFont(GBHANDLE library, const char* pPath,
+										GB_INT16 nHeight, GB_INT16 nBitCount,
+										GB_INT32 nCompress, GB_INT32 nCount);
+extern int			Test_MakeVectorFont(GBHANDLE library, const char* pPath,
+										GB_INT32 bBBox, GB_INT32 nCount);
+extern GB_UINT32	Test_Sum(GB_Bitmap bitmap);
+extern long			Test_MemoryInUse(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //GREYBITTEST_H_
@@ -0,0 +1,364 @@
+/*
+** ===========================================================================
+** File: GreyBitTest_Bench.c
+** Description: GreyBit font library - Open and rendering benchmark. A
+**              bitmap and a vector font of the whole CJK block are opened
+**              and the open time, the heap they hold after open and the
+**              heap the first glyph adds printed, for ENABLE_LAZYTABLE. A
+**              vector font is then rendered on one thread at the sizes of
+**              g_Sizes by both raster engines, for GB_ACCUM_MAX, and on 1,
+**              2, 4 ... threads, each with its own context and layout of
+**              one shared font, and the glyphs per second and the speedup
+**              printed:
+**              GreyBitTest_Bench [max threads] [size] [rounds]
+**              Build from the top directory:
+**              gcc -std=gnu89 -O2 -DWIN32 -DENCODER_SUPPORT -DENABLE_MULTITHREAD
+**                  test/GreyBitTest_Bench.c test/GreyBitTest_Font.c
+**                  test/GreyBitTest_Sys.c src/Grey*.c src/UnicodeSection.c
+**                  -lm -lpthread
+** Copyright (c) 2023
+** Portions of this software (C) 2010 The FreeType Project (www.freetype.org).
+** All rights reserved.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Open time and heap
+** 10/18/2026	me				Raster engines by size
+** 10/18/2026	me				Init
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "GreyBitTest.h"
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define BENCH_COUNT					300
+#define BENCH_THREADS_MAX			64
+#define BENCH_PATH					"GreyBitTest_Bench.gvf"
+#define BENCH_OPEN_COUNT			20902	/* U+4E00 to U+9FA5          */
+#define BENCH_OPENS					200
+#define BENCH_OPEN_GBF				"GreyBitTest_Open.gbf"
+#define BENCH_OPEN_GVF				"GreyBitTest_Open.gvf"
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct _BenchThreadRec
+{
+	GBHANDLE	loader;
+	GB_INT16	nSize;
+	GB_INT32	nRounds;
+	GB_INT32	nIndex;
+	GB_INT32	nDone;		/* glyphs rendered                           */
+} BenchThreadRec, *BenchThread;
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+static const GB_INT16	g_Sizes[] = {12, 16, 24, 32, 40, 48, 64};
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Bench_Now
+** Description: Wall clock
+** Input: none
+** Output: none
+** Return value: seconds
+** ---------------------------------------------------------------------------
+*/
+
+static double	Bench_Now(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Bench_Thread
+** Description: Render every glyph nRounds times through a layout of its own
+** Input: p - bench thread
+** Output: nDone
+** Return value: 0
+** ---------------------------------------------------------------------------
+*/
+
+static void*	Bench_Thread(void* p)
+{
+	BenchThread	me = (BenchThread)p;
+	GBHANDLE	layout;
+	GB_Bitmap	bitmap;
+	GB_INT32	nRound;
+	GB_INT32	i;
+
+	layout = GreyBitType_Layout_New(me->loader, me->nSize, 8, 0, 0);
+	if (!layout)
+		return 0;
+	for (nRound = 0; nRound < me->nRounds; ++nRound)
+	{
+		for (i = 0; i < BENCH_COUNT; ++i)
+		{
+			if (GreyBitType_Layout_LoadChar(layout, TEST_BASE
+							+ (i + me->nIndex * 37) % BENCH_COUNT, &bitmap)
+			  == GB_SUCCESS)
+				me->nDone++;
+		}
+	}
+	GreyBitType_Layout_Done(layout);
+	return 0;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Bench_Run
+** Description: Render on nThreads threads at once
+** Input: loader - shared font
+**        nThreads - thread count
+**        nSize - size
+**        nRounds - rounds per thread
+** Output: none
+** Return value: glyphs per second/0 if a glyph failed
+** ---------------------------------------------------------------------------
+*/
+
+static double	Bench_Run(GBHANDLE loader, GB_INT32 nThreads, GB_INT16 nSize,
+						  GB_INT32 nRounds)
+{
+	pthread_t		pThreads[BENCH_THREADS_MAX];
+	BenchThreadRec	pBench[BENCH_THREADS_MAX];
+	GB_INT32		nDone;
+	GB_INT32		i;
+	double			fStart;
+	double			fTime;
+
+	for (i = 0; i < nThreads; ++i)
+	{
+		pBench[i].loader = GreyBitType_Loader_NewContext(loader);
+		pBench[i].nSize = nSize;
+		pBench[i].nRounds = nRounds;
+		pBench[i].nIndex = i;
+		pBench[i].nDone = 0;
+	}
+	fStart = Bench_Now();
+	for (i = 0; i < nThreads; ++i)
+	{
+		if (pBench[i].loader)
+			pthread_create(&pThreads[i], 0, Bench_Thread, &pBench[i]);
+	}
+	for (i = 0; i < nThreads; ++i)
+	{
+		if (pBench[i].loader)
+			pthread_join(pThreads[i], 0);
+	}
+	fTime = Bench_Now() - fStart;
+	nDone = 0;
+	for (i = 0; i < nThreads; ++i)
+	{
+		nDone += pBench[i].nDone;
+		if (pBench[i].loader)
+			GreyBitType_Loader_Done(pBench[i].loader);
+	}
+	if (nDone != nThreads * nRounds * BENCH_COUNT || fTime <= 0)
+		return 0;
+	return nDone / fTime;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Bench_Open
+** Description: Open a font BENCH_OPENS times, then once more to count the
+**              heap it holds and the heap its first glyph adds
+** Input: library - library
+**        pPath - font file
+** Output: none
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+static int		Bench_Open(GBHANDLE library, const char* pPath)
+{
+	GBHANDLE	loader;
+	GBHANDLE	layout;
+	GB_Bitmap	bitmap;
+	GB_INT32	i;
+	long		nBase;
+	long		nOpen;
+	long		nGlyph;
+	double		fStart;
+	double		fOpen;
+
+	fStart = Bench_Now();
+	for (i = 0; i < BENCH_OPENS; ++i)
+	{
+		loader = GreyBitType_Loader_New(library, pPath);
+		if (!loader)
+			return GB_FAILED;
+		GreyBitType_Loader_Done(loader);
+	}
+	fOpen = (Bench_Now() - fStart) / BENCH_OPENS;
+	nBase = Test_MemoryInUse();
+	loader = GreyBitType_Loader_New(library, pPath);
+	if (!loader)
+		return GB_FAILED;
+	nOpen = Test_MemoryInUse() - nBase;
+	layout = GreyBitType_Layout_New(loader, 16, 8, 0, 0);
+	nGlyph = -1;
+	if (layout)
+	{
+		nBase = Test_MemoryInUse();
+		if (GreyBitType_Layout_LoadChar(layout, TEST_BASE, &bitmap)
+		 == GB_SUCCESS)
+			nGlyph = Test_MemoryInUse() - nBase;
+		GreyBitType_Layout_Done(layout);
+	}
+	GreyBitType_Loader_Done(loader);
+	if (nGlyph < 0)
+		return GB_FAILED;
+	printf("%-22s  %7.1f  %9ld  %11ld\n", pPath, fOpen * 1e6, nOpen, nGlyph);
+	return GB_SUCCESS;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Bench_Engines
+** Description: Render at each size of g_Sizes on one thread, through the
+**              cell engine and through the dense engine
+** Input: loader - shared font
+**        nRounds - rounds
+** Output: none
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+static int		Bench_Engines(GBHANDLE loader, GB_INT32 nRounds)
+{
+	double		fCells;
+	double		fAccum;
+	GB_INT32	i;
+
+	printf("size  cells/s  dense/s  dense time\n");
+	for (i = 0; i < (GB_INT32)(sizeof(g_Sizes) / sizeof(g_Sizes[0])); ++i)
+	{
+		GreyBitType_Loader_SetParam(loader, GB_PARAM_ACCUMMAX, 0);
+		fCells = Bench_Run(loader, 1, g_Sizes[i], nRounds);
+		GreyBitType_Loader_SetParam(loader, GB_PARAM_ACCUMMAX, g_Sizes[i]);
+		fAccum = Bench_Run(loader, 1, g_Sizes[i], nRounds);
+		if (!fCells || !fAccum)
+			return GB_FAILED;
+		printf("%4d  %7.0f  %7.0f  %9.0f%%\n", g_Sizes[i], fCells, fAccum,
+			   100 * fCells / fAccum);
+	}
+	GreyBitType_Loader_SetParam(loader, GB_PARAM_ACCUMMAX, GB_ACCUM_MAX);
+	return GB_SUCCESS;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+int				main(int argc, char** argv)
+{
+	GBHANDLE	library;
+	GBHANDLE	loader;
+	GB_INT32	nThreadsMax;
+	GB_INT32	nThreads;
+	GB_INT32	nRounds;
+	GB_INT16	nSize;
+	double		fRate;
+	double		fRateOne;
+	int			nRet;
+
+	nThreadsMax = argc > 1 ? atol(argv[1]) : 8;
+	nSize = (GB_INT16)(argc > 2 ? atol(argv[2]) : 32);
+	nRounds = argc > 3 ? atol(argv[3]) : 20;
+	if (nThreadsMax < 1 || nThreadsMax > BENCH_THREADS_MAX || nSize <= 0
+	 || nRounds <= 0)
+	{
+		fprintf(stderr, "usage: %s [max threads] [size] [rounds]\n",
+				argv[0]);
+		return 1;
+	}
+	library = GreyBitType_Init();
+	if (!library)
+		return 1;
+	nRet = 1;
+	loader = 0;
+	if (Test_MakeVectorFont(library, BENCH_PATH, 0, BENCH_COUNT)
+	 == GB_SUCCESS)
+		loader = GreyBitType_Loader_New(library, BENCH_PATH);
+	if (loader)
+	{
+		fRateOne = 0;
+		nRet = 0;
+		if (Test_MakeBitmapFont(library, BENCH_OPEN_GBF, 16, 8, 1,
+								BENCH_OPEN_COUNT) != GB_SUCCESS
+		 || Test_MakeVectorFont(library, BENCH_OPEN_GVF, 0,
+								BENCH_OPEN_COUNT) != GB_SUCCESS)
+			nRet = 1;
+#ifdef ENABLE_LAZYTABLE
+		printf("%d glyphs, lazy tables\n", BENCH_OPEN_COUNT);
+#else
+		printf("%d glyphs, tables read at open\n", BENCH_OPEN_COUNT);
+#endif //ENABLE_LAZYTABLE
+		printf("font                    open us  heap open  first glyph\n");
+		if (!nRet && (Bench_Open(library, BENCH_OPEN_GBF) != GB_SUCCESS
+				   || Bench_Open(library, BENCH_OPEN_GVF) != GB_SUCCESS))
+			nRet = 1;
+		remove(BENCH_OPEN_GBF);
+		remove(BENCH_OPEN_GVF);
+		if (!nRet)
+			nRet = Bench_Engines(loader, nRounds) != GB_SUCCESS;
+		printf("%d glyphs at %dpx, %ld rounds per thread\n", BENCH_COUNT,
+			   nSize, (long)nRounds);
+		printf("threads  glyphs/s  speedup\n");
+		for (nThreads = 1; !nRet && nThreads <= nThreadsMax; nThreads *= 2)
+		{
+			fRate = Bench_Run(loader, nThreads, nSize, nRounds);
+			if (!fRate)
+			{
+				printf("%7ld  failed\n", (long)nThreads);
+				nRet = 1;
+				break;
+			}
+			if (nThreads == 1)
+				fRateOne = fRate;
+			printf("%7ld  %8.0f  %7.2f\n", (long)nThreads, fRate,
+				   fRate / fRateOne);
+		}
+		GreyBitType_Loader_Done(loader);
+	}
+	remove(BENCH_PATH);
+	GreyBitType_Done(library);
+	return nRet;
+}
@@ -0,0 +1,198 @@
+/*
+** ===========================================================================
+** File: GreyBitTest_Font.c
+** Description: GreyBit font library - Fonts and checksums shared by the
+**              tests
+** Copyright (c) 2023
+** Portions of this software (C) 2010 The FreeType Project (www.freetype.org).
+** All rights reserved.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Init, font makers of GreyBitTest_Thread.c
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <string.h>
+#include "GreyBitTest.h"
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+static GB_BYTE	g_Glyph[TEST_HEIGHT_MAX * 16];
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_MakeBitmapFont
+** Description: Write a GBF font of nCount glyphs from TEST_BASE, 4 to 15
+**              pixels wide, no two alike
+** Input: library - library
+**        pPath - font file
+**        nHeight - font height, at most TEST_HEIGHT_MAX
+**        nBitCount - 1 or 8
+**        nCompress - GB_PARAM_COMPRESS value
+**        nCount - glyph count
+** Output: Font file
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			Test_MakeBitmapFont(GBHANDLE library, const char* pPath,
+								GB_INT16 nHeight, GB_INT16 nBitCount,
+								GB_INT32 nCompress, GB_INT32 nCount)
+{
+	GBHANDLE		creator;
+	GB_DataRec		data;
+	GB_BitmapRec	bitmap;
+	GB_INT32		nCode;
+	GB_INT32		x;
+	GB_INT32		y;
+	GB_INT32		v;
+
+	if (nHeight > TEST_HEIGHT_MAX)
+		return GB_FAILED;
+	creator = GreyBitType_Creator_New(library, pPath);
+	if (!creator)
+		return GB_FAILED;
+	GreyBitType_Creator_SetParam(creator, GB_PARAM_HEIGHT, nHeight);
+	GreyBitType_Creator_SetParam(creator, GB_PARAM_BITCOUNT, nBitCount);
+	GreyBitType_Creator_SetParam(creator, GB_PARAM_COMPRESS, nCompress);
+	for (nCode = 0; nCode < nCount; ++nCode)
+	{
+		bitmap.width = (GB_INT16)(4 + nCode % 12);
+		bitmap.height = nHeight;
+		bitmap.horioff = (GB_INT16)(nCode % 3);
+		bitmap.pitch = nBitCount == 8 ? bitmap.width
+					 : (GB_INT16)((bitmap.width + 7) >> 3);
+		bitmap.bitcount = nBitCount;
+		bitmap.buffer = g_Glyph;
+		memset(g_Glyph, 0, sizeof(g_Glyph));
+		for (y = nCode % 4; y < nHeight - nCode % 3; ++y)
+		{
+			for (x = 0; x < bitmap.width; ++x)
+			{
+				v = (x * 37 + y * 11 + nCode * 7) % 251;
+				if (nBitCount == 8)
+					g_Glyph[y * bitmap.pitch + x] = (GB_BYTE)(v | 1);
+				else if (v & 4)
+					g_Glyph[y * bitmap.pitch + (x >> 3)] |= 0x80 >> (x & 7);
+			}
+		}
+		data.format = GB_FORMAT_BITMAP;
+		data.width = bitmap.width;
+		data.horioff = bitmap.horioff;
+		data.data = &bitmap;
+		if (GreyBitType_Creator_SaveChar(creator, TEST_BASE + nCode, &data))
+			break;
+	}
+	GreyBitType_Creator_Flush(creator);
+	GreyBitType_Creator_Done(creator);
+	return nCode == nCount ? GB_SUCCESS : GB_FAILED;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_MakeVectorFont
+** Description: Write a GVF font of nCount glyphs from TEST_BASE, each a box
+**              with a curved notch, no two alike
+** Input: library - library
+**        pPath - font file
+**        bBBox - GB_PARAM_BBOX value
+**        nCount - glyph count
+** Output: Font file
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+int			Test_MakeVectorFont(GBHANDLE library, const char* pPath,
+								GB_INT32 bBBox, GB_INT32 nCount)
+{
+	GBHANDLE		creator;
+	GB_DataRec		data;
+	GB_Outline		outline;
+	GB_INT32		nCode;
+	GB_INT32		nRight;
+	GB_INT32		nTop;
+
+	creator = GreyBitType_Creator_New(library, pPath);
+	if (!creator)
+		return GB_FAILED;
+	GreyBitType_Creator_SetParam(creator, GB_PARAM_HEIGHT, TEST_VHEIGHT);
+	GreyBitType_Creator_SetParam(creator, GB_PARAM_BBOX, bBBox);
+	outline = GreyBitType_Outline_New(library, 2, 10);
+	for (nCode = 0; outline && nCode < nCount; ++nCode)
+	{
+		nRight = 20 + nCode % 40;
+		nTop = 30 + nCode % 30;
+		outline->n_contours = 2;
+		outline->n_points = 10;
+		outline->contours[0] = 4;
+		outline->contours[1] = 9;
+		outline->points[0].x = TEST_POS(2);			outline->points[0].y = TEST_POS(2);
+		outline->points[1].x = TEST_POS(nRight);	outline->points[1].y = TEST_POS(2);
+		outline->points[2].x = TEST_POS(nRight);	outline->points[2].y = TEST_POS(nTop);
+		outline->points[3].x = TEST_POS(nRight/2);	outline->points[3].y = TEST_POS(nTop + 8);
+		outline->points[4].x = TEST_POS(2);			outline->points[4].y = TEST_POS(nTop);
+		outline->points[5].x = TEST_POS(6);			outline->points[5].y = TEST_POS(6);
+		outline->points[6].x = TEST_POS(6);			outline->points[6].y = TEST_POS(nTop - 4);
+		outline->points[7].x = TEST_POS(nRight-4);	outline->points[7].y = TEST_POS(nTop - 4);
+		outline->points[8].x = TEST_POS(nRight-4);	outline->points[8].y = TEST_POS(6);
+		outline->points[9].x = TEST_POS(nRight/2);	outline->points[9].y = TEST_POS(nCode % 9);
+		memset(outline->tags, GB_CURVE_TAG_ON, 10);
+		outline->tags[3] = GB_CURVE_TAG_CONIC;
+		outline->tags[9] = GB_CURVE_TAG_CONIC;
+		data.format = GB_FORMAT_OUTLINE;
+		data.width = (GB_INT16)(nRight + 2);
+		data.horioff = 1;
+		data.data = outline;
+		if (GreyBitType_Creator_SaveChar(creator, TEST_BASE + nCode, &data))
+			break;
+	}
+	if (outline)
+		GreyBitType_Outline_Done(library, outline);
+	GreyBitType_Creator_Flush(creator);
+	GreyBitType_Creator_Done(creator);
+	return nCode == nCount ? GB_SUCCESS : GB_FAILED;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Sum
+** Description: Checksum of a rendered glyph, padding bytes left out
+** Input: bitmap - glyph
+** Output: none
+** Return value: checksum
+** ---------------------------------------------------------------------------
+*/
+
+GB_UINT32	Test_Sum(GB_Bitmap bitmap)
+{
+	GB_UINT32	nSum;
+	GB_INT32	nRowBytes;
+	GB_INT32	x;
+	GB_INT32	y;
+
+	nSum = (GB_UINT32)bitmap->width * 31 + bitmap->height;
+	nRowBytes = (bitmap->width * bitmap->bitcount + 7) >> 3;
+	for (y = 0; y < bitmap->height; ++y)
+	{
+		for (x = 0; x < nRowBytes; ++x)
+			nSum = nSum * 16777619 ^ bitmap->buffer[y * bitmap->pitch + x];
+	}
+	return nSum;
+}
@@ -0,0 +1,165 @@
+/*
+** ===========================================================================
+** File: GreyBitTest_Italic.c
+** Description: GreyBit font library - Test of 1 bit italic. An 8 bit font
+**              drawn italic by a 1 bit layout must match the same font
+**              drawn italic by an 8 bit layout, then cut at
+**              BITMAP8TO1_SWITCH_VALUE. Build from the top directory:
+**              gcc -std=gnu89 -g -DWIN32 -DENCODER_SUPPORT
+**                  test/GreyBitTest_Italic.c test/GreyBitTest_Font.c
+**                  test/GreyBitTest_Sys.c src/Grey*.c src/UnicodeSection.c
+**                  -lm
+** Copyright (c) 2023
+** Portions of this software (C) 2010 The FreeType Project (www.freetype.org).
+** All rights reserved.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Font from GreyBitTest_Font.c
+** 10/18/2026	me				Init
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include "GreyBitTest.h"
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define TEST_COUNT					64
+#define TEST_PATH					"GreyBitTest_Italic.gbf"
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Compare
+** Description: Count the pixels of a 1 bit glyph that differ from an 8 bit
+**              glyph cut at BITMAP8TO1_SWITCH_VALUE, on the columns both
+**              bitmaps hold
+** Input: pGrey - 8 bit glyph
+**        pMono - 1 bit glyph
+** Output: none
+** Return value: differing pixels
+** ---------------------------------------------------------------------------
+*/
+
+static GB_INT32	Test_Compare(GB_Bitmap pGrey, GB_Bitmap pMono)
+{
+	GB_INT32	nBad;
+	GB_INT32	nWidth;
+	GB_INT32	x;
+	GB_INT32	y;
+	GB_BOOL		bGrey;
+	GB_BOOL		bMono;
+
+	if (pGrey->height != pMono->height)
+		return pGrey->height * pGrey->pitch;
+	nWidth = pGrey->pitch < pMono->pitch * 8 ? pGrey->pitch
+											 : pMono->pitch * 8;
+	nBad = 0;
+	for (y = 0; y < pGrey->height; ++y)
+	{
+		for (x = 0; x < nWidth; ++x)
+		{
+			bGrey = (GB_BOOL)(pGrey->buffer[y * pGrey->pitch + x]
+							> BITMAP8TO1_SWITCH_VALUE);
+			bMono = (GB_BOOL)((pMono->buffer[y * pMono->pitch + (x >> 3)]
+							 >> (7 - (x & 7))) & 1);
+			if (bGrey != bMono)
+				nBad++;
+		}
+	}
+	return nBad;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Height
+** Description: Draw every glyph of a font of nHeight italic at 8 and 1 bit
+** Input: library - library
+**        nHeight - font height
+** Output: none
+** Return value: differing pixels
+** ---------------------------------------------------------------------------
+*/
+
+static GB_INT32	Test_Height(GBHANDLE library, GB_INT16 nHeight)
+{
+	GBHANDLE	loader;
+	GBHANDLE	pGreyLayout;
+	GBHANDLE	pMonoLayout;
+	GB_Bitmap	pGrey;
+	GB_Bitmap	pMono;
+	GB_INT32	nBad;
+	GB_INT32	nCode;
+
+	if (Test_MakeBitmapFont(library, TEST_PATH, nHeight, 8, 0, TEST_COUNT)
+		!= GB_SUCCESS)
+		return 1;
+	loader = GreyBitType_Loader_New(library, TEST_PATH);
+	if (!loader)
+		return 1;
+	nBad = 0;
+	pGreyLayout = GreyBitType_Layout_New(loader, nHeight, 8, 0, 1);
+	pMonoLayout = GreyBitType_Layout_New(loader, nHeight, 1, 0, 1);
+	for (nCode = 0; nCode < TEST_COUNT; ++nCode)
+	{
+		if (GreyBitType_Layout_LoadChar(pGreyLayout, TEST_BASE + nCode,
+										&pGrey) != GB_SUCCESS
+		 || GreyBitType_Layout_LoadChar(pMonoLayout, TEST_BASE + nCode,
+										&pMono) != GB_SUCCESS)
+		{
+			nBad++;
+			continue;
+		}
+		nBad += Test_Compare(pGrey, pMono);
+	}
+	GreyBitType_Layout_Done(pMonoLayout);
+	GreyBitType_Layout_Done(pGreyLayout);
+	GreyBitType_Loader_Done(loader);
+	return nBad;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+int				main(void)
+{
+	static const GB_INT16	pHeights[] = {16, 24, TEST_HEIGHT_MAX};
+	GBHANDLE	library;
+	GB_INT32	nBad;
+	GB_INT32	nTotal;
+	GB_INT32	i;
+
+	library = GreyBitType_Init();
+	if (!library)
+		return 1;
+	nTotal = 0;
+	for (i = 0; i < (GB_INT32)(sizeof(pHeights) / sizeof(pHeights[0])); ++i)
+	{
+		nBad = Test_Height(library, pHeights[i]);
+		printf("italic %d: %ld bad\n", pHeights[i], (long)nBad);
+		nTotal += nBad;
+	}
+	remove(TEST_PATH);
+	GreyBitType_Done(library);
+	printf(nTotal ? "FAIL\n" : "OK\n");
+	return nTotal ? 1 : 0;
+}
@@ -0,0 +1,315 @@
+/*
+** ===========================================================================
+** File: GreyBitTest_Sys.c
+** Description: GreyBit font library - System port for the tests, on stdio
+**              and POSIX threads
+** Copyright (c) 2023
+** Portions of this software (C) 2010 The FreeType Project (www.freetype.org).
+** All rights reserved.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Count the bytes in use
+** 10/19/2026	me				Threads
+** 10/18/2026	me				Init
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../GreyBitSystem.h"
+#include "GreyBitTest.h"
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef union _TestBlockRec
+{
+	double		d;			/* keeps the block after it aligned          */
+	long		nSize;		/* bytes asked for                           */
+} TestBlockRec, *TestBlock;
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+static long				g_nInUse;
+#ifdef ENABLE_MULTITHREAD
+static pthread_mutex_t	g_MemLock = PTHREAD_MUTEX_INITIALIZER;
+#endif //ENABLE_MULTITHREAD
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+static void		Test_MemoryAdd(long nSize)
+{
+#ifdef ENABLE_MULTITHREAD
+	pthread_mutex_lock(&g_MemLock);
+#endif //ENABLE_MULTITHREAD
+	g_nInUse += nSize;
+#ifdef ENABLE_MULTITHREAD
+	pthread_mutex_unlock(&g_MemLock);
+#endif //ENABLE_MULTITHREAD
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+GB_IOHandler GreyBit_Open_Sys(const GB_CHAR * p, GB_BOOL bcreate)
+{
+	return (GB_IOHandler)fopen(p, bcreate ? "w+b" : "rb");
+}
+
+GB_INT32	GreyBit_Read_Sys(GB_IOHandler f, GB_BYTE *p, GB_INT32 size)
+{
+	return (GB_INT32)fread(p, 1, size, (FILE *)f);
+}
+
+GB_INT32	GreyBit_Write_Sys(GB_IOHandler f, GB_BYTE *p, GB_INT32 size)
+{
+	return (GB_INT32)fwrite(p, 1, size, (FILE *)f);
+}
+
+GB_INT32	GreyBit_Seek_Sys(GB_IOHandler f, GB_INT32 pos)
+{
+	return fseek((FILE *)f, pos, SEEK_SET);
+}
+
+GB_INT32	GreyBit_GetSize_Sys(GB_IOHandler f)
+{
+	long	pos;
+	long	size;
+
+	pos = ftell((FILE *)f);
+	fseek((FILE *)f, 0, SEEK_END);
+	size = ftell((FILE *)f);
+	fseek((FILE *)f, pos, SEEK_SET);
+	return (GB_INT32)size;
+}
+
+void		GreyBit_Close_Sys(GB_IOHandler f)
+{
+	fclose((FILE *)f);
+}
+
+void *		GreyBit_Malloc_Sys(GB_INT32 size)
+{
+	TestBlock	block;
+
+	block = (TestBlock)calloc(1, sizeof(TestBlockRec) + size);
+	if (!block)
+		return 0;
+	block->nSize = size;
+	Test_MemoryAdd(size);
+	return block + 1;
+}
+
+void *		GreyBit_Realloc_Sys(void * p, GB_INT32 newsize)
+{
+	TestBlock	block;
+	long		nOldSize;
+
+	if (!p)
+		return GreyBit_Malloc_Sys(newsize);
+	block = (TestBlock)p - 1;
+	nOldSize = block->nSize;
+	block = (TestBlock)realloc(block, sizeof(TestBlockRec) + newsize);
+	if (!block)
+		return 0;
+	block->nSize = newsize;
+	Test_MemoryAdd(newsize - nOldSize);
+	return block + 1;
+}
+
+void		GreyBit_Free_Sys(void * p)
+{
+	TestBlock	block;
+
+	if (!p)
+		return;
+	block = (TestBlock)p - 1;
+	Test_MemoryAdd(-block->nSize);
+	free(block);
+}
+
+#ifdef ENABLE_MULTITHREAD
+GB_Mutex	GreyBit_Mutex_New_Sys(void)
+{
+	pthread_mutex_t*	m;
+
+	m = (pthread_mutex_t *)malloc(sizeof(pthread_mutex_t));
+	if (m && pthread_mutex_init(m, 0))
+	{
+		free(m);
+		m = 0;
+	}
+	return (GB_Mutex)m;
+}
+
+void		GreyBit_Mutex_Lock_Sys(GB_Mutex m)
+{
+	pthread_mutex_lock((pthread_mutex_t *)m);
+}
+
+void		GreyBit_Mutex_Unlock_Sys(GB_Mutex m)
+{
+	pthread_mutex_unlock((pthread_mutex_t *)m);
+}
+
+void		GreyBit_Mutex_Done_Sys(GB_Mutex m)
+{
+	pthread_mutex_destroy((pthread_mutex_t *)m);
+	free(m);
+}
+
+typedef struct _TestThreadRec
+{
+	pthread_t		thread;
+	GB_THREAD_PROC	proc;
+	void *			p;
+} TestThreadRec, *TestThread;
+
+static void *	GreyBit_Thread_Start(void * p)
+{
+	TestThread	t = (TestThread)p;
+
+	t->proc(t->p);
+	return 0;
+}
+
+GB_Thread	GreyBit_Thread_New_Sys(GB_THREAD_PROC proc, void * p)
+{
+	TestThread	t;
+
+	t = (TestThread)malloc(sizeof(TestThreadRec));
+	if (!t)
+		return 0;
+	t->proc = proc;
+	t->p = p;
+	if (pthread_create(&t->thread, 0, GreyBit_Thread_Start, t))
+	{
+		free(t);
+		t = 0;
+	}
+	return (GB_Thread)t;
+}
+
+void		GreyBit_Thread_Join_Sys(GB_Thread t)
+{
+	pthread_join(((TestThread)t)->thread, 0);
+	free(t);
+}
+#endif //ENABLE_MULTITHREAD
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_MemoryInUse
+** Description: Bytes the library holds through GreyBit_Malloc_Sys
+** Input: none
+** Output: none
+** Return value: bytes in use
+** ---------------------------------------------------------------------------
+*/
+
+long		Test_MemoryInUse(void)
+{
+	long	nInUse;
+
+#ifdef ENABLE_MULTITHREAD
+	pthread_mutex_lock(&g_MemLock);
+#endif //ENABLE_MULTITHREAD
+	nInUse = g_nInUse;
+#ifdef ENABLE_MULTITHREAD
+	pthread_mutex_unlock(&g_MemLock);
+#endif //ENABLE_MULTITHREAD
+	return nInUse;
+}
+
+int			GreyBit_Memcmp_Sys(const void * b1, const void * b2, GB_UINT32 n)
+{
+	return memcmp(b1, b2, n);
+}
+
+void *		GreyBit_Memcpy_Sys(void * d, const void * s, GB_UINT32 n)
+{
+	return memcpy(d, s, n);
+}
+
+void *		GreyBit_Memset_Sys(void * s, int i, GB_UINT32 n)
+{
+	return memset(s, i, n);
+}
+
+char *		GreyBit_Strcat_Sys(char * d, const char * s)
+{
+	return strcat(d, s);
+}
+
+int			GreyBit_Strcmp_Sys(const char * s1, const char * s2)
+{
+	return strcmp(s1, s2);
+}
+
+char *		GreyBit_Strcpy_Sys(char * d,const char * s)
+{
+	return strcpy(d, s);
+}
+
+int			GreyBit_Strlen_Sys(const char * s)
+{
+	return (int)strlen(s);
+}
+
+int			GreyBit_Strncmp_Sys(const char * s1, const char * s2, GB_UINT32 n)
+{
+	return strncmp(s1, s2, n);
+}
+
+char *		GreyBit_Strncpy_Sys(char * d, const char * s, GB_INT32 n)
+{
+	return strncpy(d, s, n);
+}
+
+char *		GreyBit_Strchr_Sys(const char * s, char c)
+{
+	return strchr(s, c);
+}
+
+char *		GreyBit_Strrchr_Sys(const char * s, char c)
+{
+	return strrchr(s, c);
+}
+
+char *		GreyBit_Strstr_Sys(const char * s1, const char * s2)
+{
+	return strstr(s1, s2);
+}
+
+GB_INT32	GreyBit_Atol_Sys(const char * s)
+{
+	return atol(s);
+}
+
+GB_INT32	GreyBit_Labs_Sys(GB_INT32 i)
+{
+	return labs(i);
+}
@@ -0,0 +1,415 @@
+/*
+** ===========================================================================
+** File: GreyBitTest_Thread.c
+** Description: GreyBit font library - Test of one font shared by threads.
+**              Each thread renders through its own context of the font,
+**              at the sizes, styles and through the render paths of
+**              g_Styles, while the cache fills, with and without a
+**              preload, and every glyph must match the one of an unshared
+**              loader. Build with ThreadSanitizer, from the top directory:
+**              gcc -std=gnu89 -g -O1 -fsanitize=thread -DWIN32 -DENCODER_SUPPORT
+**                  -DENABLE_MULTITHREAD test/GreyBitTest_Thread.c
+**                  test/GreyBitTest_Font.c test/GreyBitTest_Sys.c
+**                  src/Grey*.c src/UnicodeSection.c -lm -lpthread
+** Copyright (c) 2023
+** Portions of this software (C) 2010 The FreeType Project (www.freetype.org).
+** All rights reserved.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/18/2026	me				Sizes, styles and render paths, preload
+** 10/18/2026	me				Vector font with glyph boxes
+** 10/18/2026	me				Init
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include "GreyBitTest.h"
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define TEST_THREADS				4
+#define TEST_ROUNDS					20
+#define TEST_COUNT					192
+#define TEST_HEIGHT					16
+#define TEST_STYLES					5
+#define TEST_ATLAS					64		/* atlas of TEST_PATH_ATLAS   */
+
+#define TEST_PATH_BITMAP			0		/* Layout_LoadChar            */
+#define TEST_PATH_ATLAS				1		/* Layout_LoadCharTo          */
+#define TEST_PATH_SPANS				2		/* Layout_RenderSpans         */
+
+/*
+**----------------------------------------------------------------------------
+**  Type Definitions
+**----------------------------------------------------------------------------
+*/
+
+typedef struct _TestStyleRec
+{
+	GB_INT16	nHalves;	/* size in halves of the font test size      */
+	GB_INT16	nBitCount;	/* 0 for the one of the font                 */
+	GB_BOOL		bBold;
+	GB_BOOL		bItalic;
+	GB_INT32	nPath;
+} TestStyleRec;
+
+typedef struct _TestFontRec
+{
+	const char*	pPath;
+	GB_INT16	nSize;
+	GB_INT16	nBitCount;
+	GB_UINT32	pSums[TEST_STYLES][TEST_COUNT];
+} TestFontRec, *TestFont;
+
+typedef struct _TestThreadRec
+{
+	TestFont	font;
+	GBHANDLE	loader;
+	GB_INT32	nIndex;
+	GB_INT32	nBad;
+} TestThreadRec, *TestThread;
+
+/*
+**----------------------------------------------------------------------------
+**  Internal variables
+**----------------------------------------------------------------------------
+*/
+
+static const TestStyleRec	g_Styles[TEST_STYLES] = {
+	{2, 0, 0, 0, TEST_PATH_BITMAP},
+	{3, 8, 1, 0, TEST_PATH_BITMAP},
+	{2, 1, 0, 1, TEST_PATH_BITMAP},
+	{2, 8, 0, 0, TEST_PATH_ATLAS},
+	{4, 8, 1, 1, TEST_PATH_SPANS},
+};
+
+/*
+**----------------------------------------------------------------------------
+**  Function(internal use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_SpanSum
+** Description: Fold spans into a checksum
+** Input: y - row
+**        count - span count
+**        spans - spans
+**        user - checksum
+** Output: Checksum
+** Return value: none
+** ---------------------------------------------------------------------------
+*/
+
+static void		Test_SpanSum(int y, int count, const GB_Span* spans,
+							 void* user)
+{
+	GB_UINT32*	pnSum = (GB_UINT32 *)user;
+	int			i;
+
+	for (i = 0; i < count; ++i)
+	{
+		*pnSum = *pnSum * 16777619 ^ (GB_UINT32)y;
+		*pnSum = *pnSum * 16777619 ^ (GB_UINT32)spans[i].x;
+		*pnSum = *pnSum * 16777619 ^ (GB_UINT32)spans[i].len;
+		*pnSum = *pnSum * 16777619 ^ (GB_UINT32)spans[i].coverage;
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Layouts
+** Description: Make a layout per style of g_Styles
+** Input: loader - loader
+**        font - test font
+** Output: pLayouts - layouts, 0 where none could be made
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+static int		Test_Layouts(GBHANDLE loader, TestFont font,
+							 GBHANDLE* pLayouts)
+{
+	int		nRet;
+	int		i;
+
+	nRet = GB_SUCCESS;
+	for (i = 0; i < TEST_STYLES; ++i)
+	{
+		pLayouts[i] = GreyBitType_Layout_New(loader,
+								(GB_INT16)(font->nSize * g_Styles[i].nHalves / 2),
+								g_Styles[i].nBitCount ? g_Styles[i].nBitCount
+													  : font->nBitCount,
+								g_Styles[i].bBold, g_Styles[i].bItalic);
+		if (!pLayouts[i])
+			nRet = GB_FAILED;
+	}
+	return nRet;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Render
+** Description: Render a glyph of a font through a layout, on the render
+**              path of its style
+** Input: layout - layout
+**        nStyle - style of layout
+**        nCode - code
+** Output: none
+** Return value: checksum/0 if not rendered
+** ---------------------------------------------------------------------------
+*/
+
+static GB_UINT32	Test_Render(GBHANDLE layout, GB_INT32 nStyle,
+								GB_UINT32 nCode)
+{
+	GB_BYTE			pAtlas[TEST_ATLAS * TEST_ATLAS];
+	GB_BitmapRec	atlas;
+	GB_Bitmap		bitmap;
+	GB_UINT32		nSum;
+
+	switch (g_Styles[nStyle].nPath)
+	{
+	case TEST_PATH_ATLAS:
+		memset(pAtlas, 0, sizeof(pAtlas));
+		atlas.width = TEST_ATLAS;
+		atlas.height = TEST_ATLAS;
+		atlas.pitch = TEST_ATLAS;
+		atlas.bitcount = 8;
+		atlas.horioff = 0;
+		atlas.buffer = pAtlas;
+		if (GreyBitType_Layout_LoadCharTo(layout, nCode, &atlas, 3, 2)
+		  != GB_SUCCESS)
+			return 0;
+		return Test_Sum(&atlas);
+	case TEST_PATH_SPANS:
+		nSum = 1;
+		if (GreyBitType_Layout_RenderSpans(layout, nCode, 0, 0, 0,
+										   Test_SpanSum, &nSum)
+		  != GB_SUCCESS)
+			return 0;
+		return nSum;
+	default:
+		if (GreyBitType_Layout_LoadChar(layout, nCode, &bitmap)
+		  != GB_SUCCESS)
+			return 0;
+		return Test_Sum(bitmap);
+	}
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Thread
+** Description: Render every glyph TEST_ROUNDS times, each thread in its
+**              own order and in another style than its neighbours each
+**              round, and count the ones that differ
+** Input: p - test thread
+** Output: nBad
+** Return value: 0
+** ---------------------------------------------------------------------------
+*/
+
+static void*	Test_Thread(void* p)
+{
+	TestThread	me = (TestThread)p;
+	GBHANDLE	pLayouts[TEST_STYLES];
+	GB_INT32	nRound;
+	GB_INT32	nStyle;
+	GB_INT32	i;
+	GB_INT32	nCode;
+
+	if (Test_Layouts(me->loader, me->font, pLayouts) != GB_SUCCESS)
+		me->nBad = TEST_COUNT;
+	for (nRound = 0; !me->nBad && nRound < TEST_ROUNDS; ++nRound)
+	{
+		nStyle = (nRound + me->nIndex) % TEST_STYLES;
+		for (i = 0; i < TEST_COUNT; ++i)
+		{
+			nCode = (i * (2 * me->nIndex + 1) + nRound * 5) % TEST_COUNT;
+			if (Test_Render(pLayouts[nStyle], nStyle, TEST_BASE + nCode)
+			 != me->font->pSums[nStyle][nCode])
+				me->nBad++;
+		}
+	}
+	for (i = 0; i < TEST_STYLES; ++i)
+	{
+		if (pLayouts[i])
+			GreyBitType_Layout_Done(pLayouts[i]);
+	}
+	return 0;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Reference
+** Description: Render every glyph of a font in every style on an unshared
+**              loader, for the threads to compare with
+** Input: library - library
+**        font - test font
+** Output: font->pSums
+** Return value: number of glyphs not rendered
+** ---------------------------------------------------------------------------
+*/
+
+static GB_INT32	Test_Reference(GBHANDLE library, TestFont font)
+{
+	GBHANDLE	loader;
+	GBHANDLE	pLayouts[TEST_STYLES];
+	GB_INT32	nBad;
+	GB_INT32	nStyle;
+	GB_INT32	i;
+
+	loader = GreyBitType_Loader_New(library, font->pPath);
+	if (!loader)
+		return TEST_COUNT;
+	nBad = 0;
+	if (Test_Layouts(loader, font, pLayouts) != GB_SUCCESS)
+		nBad = TEST_COUNT;
+	for (nStyle = 0; !nBad && nStyle < TEST_STYLES; ++nStyle)
+	{
+		for (i = 0; i < TEST_COUNT; ++i)
+		{
+			font->pSums[nStyle][i] = Test_Render(pLayouts[nStyle], nStyle,
+												 TEST_BASE + i);
+			if (!font->pSums[nStyle][i])
+				nBad++;
+		}
+	}
+	for (i = 0; i < TEST_STYLES; ++i)
+	{
+		if (pLayouts[i])
+			GreyBitType_Layout_Done(pLayouts[i]);
+	}
+	GreyBitType_Loader_Done(loader);
+	return nBad;
+}
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Test_Font
+** Description: Render a font from TEST_THREADS contexts and the font itself
+**              at once. The cache holds half the glyphs; with bPreload that
+**              half is preloaded, else the cache fills as the threads go.
+** Input: library - library
+**        font - test font, with its reference sums
+**        bPreload - preload half the glyphs?
+** Output: none
+** Return value: number of glyphs that differ
+** ---------------------------------------------------------------------------
+*/
+
+static GB_INT32	Test_Font(GBHANDLE library, TestFont font, GB_BOOL bPreload)
+{
+	GBHANDLE		loader;
+	pthread_t		pThreads[TEST_THREADS];
+	TestThreadRec	pTests[TEST_THREADS + 1];
+	GB_UINT32		pCodes[TEST_COUNT / 2];
+	GB_INT32		nBad;
+	GB_INT32		i;
+
+	loader = GreyBitType_Loader_New(library, font->pPath);
+	if (!loader)
+		return TEST_COUNT;
+	nBad = 0;
+	GreyBitType_Loader_SetParam(loader, GB_PARAM_CACHEITEM, TEST_COUNT / 2);
+	if (bPreload)
+	{
+		for (i = 0; i < TEST_COUNT / 2; ++i)
+			pCodes[i] = TEST_BASE + i * 2;
+		if (GreyBitType_Loader_Preload(loader, pCodes, TEST_COUNT / 2)
+		  != GB_SUCCESS)
+			nBad = TEST_COUNT;
+	}
+	for (i = 0; i <= TEST_THREADS; ++i)
+	{
+		pTests[i].font = font;
+		pTests[i].nIndex = i;
+		pTests[i].nBad = 0;
+		pTests[i].loader = i < TEST_THREADS
+						 ? GreyBitType_Loader_NewContext(loader) : loader;
+		if (!pTests[i].loader)
+			nBad++;
+	}
+	for (i = 0; !nBad && i < TEST_THREADS; ++i)
+		pthread_create(&pThreads[i], 0, Test_Thread, &pTests[i]);
+	if (!nBad)
+		Test_Thread(&pTests[TEST_THREADS]);
+	for (i = 0; !nBad && i < TEST_THREADS; ++i)
+		pthread_join(pThreads[i], 0);
+	for (i = 0; i <= TEST_THREADS; ++i)
+	{
+		nBad += pTests[i].nBad;
+		if (i < TEST_THREADS && pTests[i].loader)
+			GreyBitType_Loader_Done(pTests[i].loader);
+	}
+	GreyBitType_Loader_Done(loader);
+	return nBad;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+int				main(void)
+{
+	static TestFontRec	fonts[] = {
+		{"GreyBitTest_Thread8.gbf", TEST_HEIGHT, 8, {{0}}},
+		{"GreyBitTest_Thread1.gbf", TEST_HEIGHT, 1, {{0}}},
+		{"GreyBitTest_Thread.gvf", 24, 8, {{0}}},
+		{"GreyBitTest_ThreadB.gvf", 24, 8, {{0}}},
+	};
+	GBHANDLE	library;
+	GB_INT32	nBad;
+	GB_INT32	nTotal;
+	GB_INT32	i;
+	GB_INT32	j;
+
+	library = GreyBitType_Init();
+	if (!library)
+		return 1;
+	nTotal = 0;
+	if (Test_MakeBitmapFont(library, fonts[0].pPath, TEST_HEIGHT, 8, 1,
+							TEST_COUNT) != GB_SUCCESS
+	 || Test_MakeBitmapFont(library, fonts[1].pPath, TEST_HEIGHT, 1, 2,
+							TEST_COUNT) != GB_SUCCESS
+	 || Test_MakeVectorFont(library, fonts[2].pPath, 0, TEST_COUNT)
+	  != GB_SUCCESS
+	 || Test_MakeVectorFont(library, fonts[3].pPath, 1, TEST_COUNT)
+	  != GB_SUCCESS)
+		nTotal = 1;
+	for (i = 0; !nTotal && i < (GB_INT32)(sizeof(fonts) / sizeof(fonts[0]));
+		 ++i)
+	{
+		nBad = Test_Reference(library, &fonts[i]);
+		for (j = 0; !nBad && j < 2; ++j)
+		{
+			nBad = Test_Font(library, &fonts[i], (GB_BOOL)j);
+			printf("%s%s: %ld bad\n", fonts[i].pPath, j ? " preloaded" : "",
+				   (long)nBad);
+		}
+		if (nBad && j == 0)
+			printf("%s: no reference\n", fonts[i].pPath);
+		nTotal += nBad;
+	}
+	for (i = 0; i < (GB_INT32)(sizeof(fonts) / sizeof(fonts[0])); ++i)
+		remove(fonts[i].pPath);
+	GreyBitType_Done(library);
+	printf(nTotal ? "FAIL\n" : "OK\n");
+	return nTotal ? 1 : 0;
+}
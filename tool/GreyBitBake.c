@@ -0,0 +1,145 @@
+/*
+** ===========================================================================
+** File: GreyBitBake.c
+** Description: GreyBit font library - Command line front end of
+**              GreyBitType_Creator_Bake. Renders a font at the given sizes
+**              and bit counts into a combined font of bitmap strikes:
+**              GreyBitBake [-f] in.gvf out.gcf 16/8 24/8 12/1
+**              -f keeps the source font in out.gcf for the other sizes.
+**              Strikes are rendered in parallel when built with
+**              ENABLE_MULTITHREAD. Build from the top directory, on the
+**              stdio port of the tests:
+**              gcc -std=gnu89 -O2 -DWIN32 -DENCODER_SUPPORT -DENABLE_MULTITHREAD
+**                  tool/GreyBitBake.c test/GreyBitTest_Sys.c src/Grey*.c
+**                  src/UnicodeSection.c -lm -lpthread -o GreyBitBake
+** Copyright (c) 2023
+** Portions of this software (C) 2010 The FreeType Project (www.freetype.org).
+** All rights reserved.
+** History:
+** when			who				what, where, why
+** MM-DD-YYYY-- --------------- --------------------------------
+** 10/19/2026	me				Parallel strikes
+** 10/18/2026	me				Init
+** ===========================================================================
+*/
+
+/*
+**----------------------------------------------------------------------------
+**  Includes
+**----------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../GreyBitType.h"
+
+/*
+**----------------------------------------------------------------------------
+**  Definitions
+**----------------------------------------------------------------------------
+*/
+
+#define BAKE_STRIKE_MAX				16
+
+/*
+**----------------------------------------------------------------------------
+**  Internal Functions
+**----------------------------------------------------------------------------
+*/
+
+/*
+** ---------------------------------------------------------------------------
+** Function: Bake_ParseStrike
+** Description: Parse a strike given as size/bitcount
+** Input: pArg - argument
+** Output: pnSize - size
+**         pnBitCount - bit count
+** Return value: success/fail
+** ---------------------------------------------------------------------------
+*/
+
+static int		Bake_ParseStrike(const char* pArg, GB_INT16* pnSize,
+								 GB_INT16* pnBitCount)
+{
+	const char*	pSlash;
+
+	pSlash = strchr(pArg, '/');
+	if (!pSlash)
+		return GB_FAILED;
+	*pnSize = (GB_INT16)atol(pArg);
+	*pnBitCount = (GB_INT16)atol(pSlash + 1);
+	if (*pnSize <= 0 || (*pnBitCount != 1 && *pnBitCount != 8))
+		return GB_FAILED;
+	return GB_SUCCESS;
+}
+
+/*
+**----------------------------------------------------------------------------
+**  Function(external use only) Declarations
+**----------------------------------------------------------------------------
+*/
+
+int				main(int argc, char** argv)
+{
+	GB_INT16	pSizes[BAKE_STRIKE_MAX];
+	GB_INT16	pBitCounts[BAKE_STRIKE_MAX];
+	GB_INT32	nCount;
+	GB_BOOL		bFallback;
+	GBHANDLE	library;
+	GBHANDLE	loader;
+	GBHANDLE	creator;
+	int			nRet;
+	int			i;
+
+	i = 1;
+	bFallback = 0;
+	if (i < argc && !strcmp(argv[i], "-f"))
+	{
+		bFallback = 1;
+		++i;
+	}
+	if (argc - i < 3 || argc - i - 2 > BAKE_STRIKE_MAX)
+	{
+		fprintf(stderr, "usage: %s [-f] in out.gcf size/bitcount...\n",
+				argv[0]);
+		return 1;
+	}
+	for (nCount = 0; i + 2 + nCount < argc; ++nCount)
+	{
+		if (Bake_ParseStrike(argv[i + 2 + nCount], &pSizes[nCount],
+							 &pBitCounts[nCount]) != GB_SUCCESS)
+		{
+			fprintf(stderr, "%s: bad strike %s, want size/1 or size/8\n",
+					argv[0], argv[i + 2 + nCount]);
+			return 1;
+		}
+	}
+	library = GreyBitType_Init();
+	if (!library)
+		return 1;
+	nRet = GB_FAILED;
+	creator = 0;
+	loader = GreyBitType_Loader_New(library, argv[i]);
+	if (loader)
+		creator = GreyBitType_Creator_New(library, argv[i + 1]);
+	if (!loader)
+		fprintf(stderr, "%s: cannot load %s\n", argv[0], argv[i]);
+	else if (!creator)
+		fprintf(stderr, "%s: cannot create %s\n", argv[0], argv[i + 1]);
+	else
+	{
+		nRet = GreyBitType_Creator_Bake(creator, loader, pSizes, pBitCounts,
+										nCount, bFallback);
+		if (nRet == GB_SUCCESS)
+			nRet = GreyBitType_Creator_Flush(creator);
+		if (nRet != GB_SUCCESS)
+			fprintf(stderr, "%s: baking %s failed\n", argv[0], argv[i]);
+	}
+	if (creator)
+		GreyBitType_Creator_Done(creator);
+	if (loader)
+		GreyBitType_Loader_Done(loader);
+	GreyBitType_Done(library);
+	return nRet == GB_SUCCESS ? 0 : 1;
+}